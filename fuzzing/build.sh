@@ -12,4 +12,4 @@ cd "$BUILDDIR"
 
 cmake -DCMAKE_C_COMPILER=clang ..
 make clean
-make fuzz_message
+make fuzz_message fuzz_text
@@ -8,7 +8,8 @@ int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size) {
     MessageHeader *header = &print_config.header;
 
     print_config.expert_mode = true;
-    print_config.signer_pubkey = NULL;
+    print_config.signer_pubkeys = NULL;
+    print_config.num_signer_pubkeys = 0;
 
     if (parse_message_header(&parser, header)) {
         // This is not a valid Solana message
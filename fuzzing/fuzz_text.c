@@ -0,0 +1,16 @@
+#include <stdlib.h>
+
+#include "sol/text.h"
+#include "../libsol/text_reference.h"
+
+// Differential target: the word-at-a-time validators must agree with the
+// byte-at-a-time ones they replaced on every input
+int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size) {
+    if (is_data_ascii(Data, Size) != reference_is_data_ascii(Data, Size)) {
+        abort();
+    }
+    if (is_data_utf8(Data, Size) != reference_is_data_utf8(Data, Size)) {
+        abort();
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+// Minimal helpers shared by the host-only *_bench.c programs
+
+#include "sol/message.h"
+#include "sol/parser.h"
+#include "sol/print_config.h"
+#include "sol/transaction_summary.h"
+#include "util.h"
+#include <stdint.h>
+#include <time.h>
+
+static inline uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+// Keep the optimizer from discarding a benchmarked result
+static inline void bench_do_not_optimize(const void* value) {
+    __asm__ volatile("" : : "r"(value) : "memory");
+}
+
+// What the device does to review a message: parse, summarize, finalize,
+// render every item
+typedef enum BenchPhase {
+    BenchPhaseParse = 0,
+    BenchPhaseProcess,
+    BenchPhaseFinalize,
+    BenchPhaseDisplay,
+    BenchPhaseCount,
+} BenchPhase;
+
+static const char* const BENCH_PHASE_NAMES[BenchPhaseCount] = {"parse",
+                                                               "process",
+                                                               "finalize",
+                                                               "display"};
+
+// Review a message up to last_phase
+static inline int bench_run_pipeline(const uint8_t* data, size_t length, BenchPhase last_phase) {
+    Parser parser = {data, length};
+    PrintConfig print_config;
+    MessageHeader* header = &print_config.header;
+    print_config.expert_mode = true;
+    print_config.signer_pubkeys = NULL;
+    print_config.num_signer_pubkeys = 0;
+
+    BAIL_IF(parse_message_header(&parser, header));
+    if (last_phase == BenchPhaseParse) {
+        return 0;
+    }
+
+    transaction_summary_reset();
+    BAIL_IF(process_message_body(parser.buffer, parser.buffer_length, &print_config));
+    transaction_summary_set_fee_payer_pubkey(&header->pubkeys[0]);
+    if (last_phase == BenchPhaseProcess) {
+        return 0;
+    }
+
+    enum SummaryItemKind kinds[MAX_TRANSACTION_SUMMARY_ITEMS];
+    size_t num_items = 0;
+    BAIL_IF(transaction_summary_finalize(kinds, &num_items));
+    if (last_phase == BenchPhaseFinalize) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < num_items; i++) {
+        BAIL_IF(transaction_summary_display_item(i, DisplayFlagLongPubkeys));
+        bench_do_not_optimize(G_transaction_summary_text);
+    }
+    return 0;
+}
@@ -82,9 +82,51 @@
         0xe7, 0xbc, 0x8c, 0xe5, 0xbb, 0xc5, 0xf7, 0x12, 0x6b, 0x2c, 0x43, 0x9b, 0x3a, 0x40, 0x00, \
         0x00, 0x00
 
+#define PROGRAM_ID_SPL_TOKEN_2022 /* "TokenzQdBNbLqP5VEhdkAS6EPFLC1PHnBqCXEpPxuEb" */             \
+    0x06, 0xdd, 0xf6, 0xe1, 0xee, 0x75, 0x8f, 0xde, 0x18, 0x42, 0x5d, 0xbc, 0xe4, 0x6c, 0xcd,     \
+        0xda, 0xb6, 0x1a, 0xfc, 0x4d, 0x83, 0xb9, 0x0d, 0x27, 0xfe, 0xbd, 0xf9, 0x28, 0xd8, 0xa1, \
+        0x8b, 0xfc
+#define PROGRAM_ID_SPL_MEMO_V1 /* "Memo1UhkJRfHyvLMcVucJwxXeuD728EqVDDwQDxFMNo" */                \
+    0x05, 0x4a, 0x53, 0x50, 0xf8, 0x5d, 0xc8, 0x82, 0xd6, 0x14, 0xa5, 0x56, 0x72, 0x78, 0x8a,     \
+        0x29, 0x6d, 0xdf, 0x1e, 0xab, 0xab, 0xd0, 0xa6, 0x06, 0x78, 0x88, 0x49, 0x32, 0xf4, 0xee, \
+        0xf6, 0xa0
+#define PROGRAM_ID_ADDRESS_LOOKUP_TABLE /* "AddressLookupTab1e1111111111111111111111111" */       \
+    0x02, 0x77, 0xa6, 0xaf, 0x97, 0x33, 0x9b, 0x7a, 0xc8, 0x8d, 0x18, 0x92, 0xc9, 0x04, 0x46,     \
+        0xf5, 0x00, 0x02, 0x30, 0x92, 0x66, 0xf6, 0x2e, 0x53, 0xc1, 0x18, 0x24, 0x49, 0x82, 0x00, \
+        0x00, 0x00
+
+#define STAKE_CONFIG /* "StakeConfig11111111111111111111111111111111" */                          \
+    0x06, 0xa1, 0xd8, 0x17, 0xa5, 0x02, 0x05, 0x0b, 0x68, 0x07, 0x91, 0xe6, 0xce, 0x6d, 0xb8,     \
+        0x8e, 0x1e, 0x5b, 0x71, 0x50, 0xf6, 0x1f, 0xc6, 0x79, 0x0a, 0x4e, 0xb4, 0xd1, 0x00, 0x00, \
+        0x00, 0x00
+
 // Sysvars
 
 #define SYSVAR_RENT /* "SysvarRent111111111111111111111111111111111" */                           \
     0x06, 0xa7, 0xd5, 0x17, 0x19, 0x2c, 0x5c, 0x51, 0x21, 0x8c, 0xc9, 0x4c, 0x3d, 0x4a, 0xf1,     \
         0x7f, 0x58, 0xda, 0xee, 0x08, 0x9b, 0xa1, 0xfd, 0x44, 0xe3, 0xdb, 0xd9, 0x8a, 0x00, 0x00, \
         0x00, 0x00
+#define SYSVAR_CLOCK /* "SysvarC1ock11111111111111111111111111111111" */                          \
+    0x06, 0xa7, 0xd5, 0x17, 0x18, 0xc7, 0x74, 0xc9, 0x28, 0x56, 0x63, 0x98, 0x69, 0x1d, 0x5e,     \
+        0xb6, 0x8b, 0x5e, 0xb8, 0xa3, 0x9b, 0x4b, 0x6d, 0x5c, 0x73, 0x55, 0x5b, 0x21, 0x00, 0x00, \
+        0x00, 0x00
+#define SYSVAR_STAKE_HISTORY /* "SysvarStakeHistory1111111111111111111111111" */                  \
+    0x06, 0xa7, 0xd5, 0x17, 0x19, 0x35, 0x84, 0xd0, 0xfe, 0xed, 0x9b, 0xb3, 0x43, 0x1d, 0x13,     \
+        0x20, 0x6b, 0xe5, 0x44, 0x28, 0x1b, 0x57, 0xb8, 0x56, 0x6c, 0xc5, 0x37, 0x5f, 0xf4, 0x00, \
+        0x00, 0x00
+#define SYSVAR_RECENT_BLOCKHASHES /* "SysvarRecentB1ockHashes11111111111111111111" */             \
+    0x06, 0xa7, 0xd5, 0x17, 0x19, 0x2c, 0x56, 0x8e, 0xe0, 0x8a, 0x84, 0x5f, 0x73, 0xd2, 0x97,     \
+        0x88, 0xcf, 0x03, 0x5c, 0x31, 0x45, 0xb2, 0x1a, 0xb3, 0x44, 0xd8, 0x06, 0x2e, 0xa9, 0x40, \
+        0x00, 0x00
+#define SYSVAR_SLOT_HASHES /* "SysvarS1otHashes111111111111111111111111111" */                    \
+    0x06, 0xa7, 0xd5, 0x17, 0x19, 0x2f, 0x0a, 0xaf, 0xc6, 0xf2, 0x65, 0xe3, 0xfb, 0x77, 0xcc,     \
+        0x7a, 0xda, 0x82, 0xc5, 0x29, 0xd0, 0xbe, 0x3b, 0x13, 0x6e, 0x2d, 0x00, 0x55, 0x20, 0x00, \
+        0x00, 0x00
+#define SYSVAR_INSTRUCTIONS /* "Sysvar1nstructions1111111111111111111111111" */                   \
+    0x06, 0xa7, 0xd5, 0x17, 0x18, 0x7b, 0xd1, 0x66, 0x35, 0xda, 0xd4, 0x04, 0x55, 0xfd, 0xc2,     \
+        0xc0, 0xc1, 0x24, 0xc6, 0x8f, 0x21, 0x56, 0x75, 0xa5, 0xdb, 0xba, 0xcb, 0x5f, 0x08, 0x00, \
+        0x00, 0x00
+#define SYSVAR_EPOCH_SCHEDULE /* "SysvarEpochSchedu1e111111111111111111111111" */                 \
+    0x06, 0xa7, 0xd5, 0x17, 0x18, 0xdc, 0x3f, 0xee, 0x02, 0xd3, 0xe4, 0x7f, 0x01, 0x00, 0xf8,     \
+        0xb0, 0x54, 0xf7, 0x94, 0x2e, 0x60, 0x59, 0x1e, 0x3f, 0x50, 0x87, 0x19, 0xa8, 0x05, 0x00, \
+        0x00, 0x00
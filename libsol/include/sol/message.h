@@ -3,6 +3,9 @@
 #include "parser.h"
 #include "print_config.h"
 
+// Instructions a message may hold, see parse_message_instructions()
+#define MAX_INSTRUCTIONS 4
+
 int process_message_body(const uint8_t* message_body,
                          int message_body_length,
                          const PrintConfig* print_config);
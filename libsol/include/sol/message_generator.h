@@ -0,0 +1,62 @@
+#pragma once
+
+// Host-only generator of synthetic messages for benchmarks and replay tools.
+// Messages cover every instruction pattern the transaction printers
+// recognize, with or without a durable nonce and compute budget
+// instructions, legacy or v0, over random account tables. A share of them
+// are near misses of those patterns or call an unknown program, which the
+// device must refuse. The sequence of messages only depends on the seed.
+
+#include "sol/parser.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+#define MESSAGE_GENERATOR_MAX_LENGTH 1232
+
+typedef enum GeneratedMessageKind {
+    // A recognized pattern, process_message_body() accepts it
+    GeneratedMessageValid = 0,
+    // A recognized pattern with a single defect, refused
+    GeneratedMessageNearMiss,
+    // A recognized pattern with one instruction sent to an unknown program,
+    // refused
+    GeneratedMessageUnknownProgram,
+} GeneratedMessageKind;
+
+typedef struct GeneratedMessage {
+    GeneratedMessageKind kind;
+    // Index of the pattern, see message_generator_pattern_name()
+    size_t pattern;
+    bool nonced;
+    size_t num_compute_budget_instructions;
+    bool versioned;
+    uint8_t data[MESSAGE_GENERATOR_MAX_LENGTH];
+    size_t length;
+} GeneratedMessage;
+
+typedef struct MessageGenerator {
+    uint64_t state;
+    // Share of near misses and of unknown programs, in percent
+    unsigned near_miss_percent;
+    unsigned unknown_program_percent;
+} MessageGenerator;
+
+void message_generator_init(MessageGenerator* generator,
+                            uint64_t seed,
+                            unsigned near_miss_percent,
+                            unsigned unknown_program_percent);
+
+int message_generator_next(MessageGenerator* generator, GeneratedMessage* message);
+
+size_t message_generator_pattern_count(void);
+
+// NULL past the last pattern
+const char* message_generator_pattern_name(size_t pattern);
+
+// A message stream is the messages one after the other, each preceded by
+// its length as a little-endian u32
+int message_stream_write(FILE* file, const uint8_t* message, size_t length);
+
+// 0 and the next message in buffer, 1 at the end of the stream or if the
+// next message is not whole or does not fit
+int message_stream_read(FILE* file, uint8_t* buffer, size_t buffer_size, size_t* length);
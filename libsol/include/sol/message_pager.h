@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Splits a long text into pages for review. Page breaks are computed once,
+// in a single pass, when the message is parsed; fetching any page afterwards
+// is O(1) and reads the text in place.
+//
+// A page holds at most page_length bytes. When a page has to be cut, it ends
+// after the last space found in its final quarter, if any, so words are
+// rarely split and every page but the last is at least 3/4 full.
+
+#define MESSAGE_PAGER_MAX_PAGES 40
+
+typedef struct MessagePager {
+    const uint8_t* text;
+    // Page i spans [offsets[i], offsets[i + 1])
+    uint16_t offsets[MESSAGE_PAGER_MAX_PAGES + 1];
+    uint8_t page_count;
+} MessagePager;
+
+int message_pager_init(MessagePager* pager,
+                       const uint8_t* text,
+                       size_t length,
+                       size_t page_length);
+
+// Points *page at page index and returns its length, 0 if out of range
+size_t message_pager_get_page(const MessagePager* pager, size_t index, const uint8_t** page);
@@ -6,7 +6,9 @@
 typedef struct PrintConfig {
     MessageHeader header;
     bool expert_mode;
-    const Pubkey* signer_pubkey;
+    // Keys the device signs with, authorities matching one of them are implied
+    const Pubkey* signer_pubkeys;
+    size_t num_signer_pubkeys;
 } PrintConfig;
 
 bool print_config_show_authority(const PrintConfig* print_config, const Pubkey* authority);
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "sol/parser.h"
+
+// Session cache of public keys derived on the device, keyed by derivation
+// path, so that signing repeatedly from one account derives its key once.
+// It only ever holds public data, lives in RAM and is emptied by
+// pubkey_cache_reset().
+
+#ifdef TARGET_NANOS
+#define PUBKEY_CACHE_ENTRIES 4
+#else
+#define PUBKEY_CACHE_ENTRIES 8
+#endif
+
+#define PUBKEY_CACHE_MAX_PATH_LENGTH 5
+
+void pubkey_cache_reset();
+
+// Insert or refresh the key of path, evicting the least recently used entry
+// when full
+int pubkey_cache_insert(const uint32_t* path, size_t path_length, const Pubkey* pubkey);
+
+// NULL if path is not cached. A hit marks the entry most recently used
+const Pubkey* pubkey_cache_lookup(const uint32_t* path, size_t path_length);
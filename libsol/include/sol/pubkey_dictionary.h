@@ -0,0 +1,68 @@
+#pragma once
+
+#include "sol/parser.h"
+
+// Transfer encoding of a message in which the host replaces keys of the
+// account table that the device already knows (program IDs, sysvars and
+// registry mints) by a reference into a fixed dictionary. Each key of the
+// table is sent as:
+//
+//   00 followed by the 32 bytes of the key
+//   01..EF, dictionary entry (byte - 01)
+//   F0..FF then a byte b, dictionary entry 0xEF + ((byte - F0) << 8 | b)
+//
+// Everything else is sent as is. The device expands the message as chunks
+// arrive, so what is hashed and signed is the original message.
+
+#define PUBKEY_DICTIONARY_LITERAL  0x00
+#define PUBKEY_DICTIONARY_SHORT    0xef
+#define PUBKEY_DICTIONARY_LONG     0xf0
+#define PUBKEY_DICTIONARY_MAX_SIZE (PUBKEY_DICTIONARY_SHORT + 16 * 256)
+
+size_t pubkey_dictionary_size();
+
+// NULL if index is out of the dictionary
+const Pubkey* pubkey_dictionary_get(size_t index);
+
+// Index of pubkey in the dictionary, -1 if it is not in it
+int pubkey_dictionary_find(const Pubkey* pubkey);
+
+typedef enum MessageExpanderStage {
+    MessageExpanderPrefix = 0,
+    MessageExpanderHeader,
+    MessageExpanderKeyCount,
+    MessageExpanderKeyTag,
+    MessageExpanderKeyIndex,
+    MessageExpanderKeyLiteral,
+    MessageExpanderBody,
+} MessageExpanderStage;
+
+// State of the expansion of one message, zero initialized
+typedef struct MessageExpander {
+    MessageExpanderStage stage;
+    // Bytes left in the current header or literal key
+    size_t remaining;
+    // Keys of the table, then keys left to expand
+    size_t num_keys;
+    uint8_t key_count_bytes;
+    uint8_t tag;
+} MessageExpander;
+
+// Expand in, appending at most out_size bytes to out. out_length is set to
+// the number of bytes written
+int message_expander_update(MessageExpander* expander,
+                            const uint8_t* in,
+                            size_t in_length,
+                            uint8_t* out,
+                            size_t out_size,
+                            size_t* out_length);
+
+// 0 once the whole key table was expanded
+int message_expander_finish(const MessageExpander* expander);
+
+// Encode message, the reverse of the expansion, for hosts and tests
+int message_compress(const uint8_t* message,
+                     size_t message_length,
+                     uint8_t* out,
+                     size_t out_size,
+                     size_t* out_length);
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "sol/parser.h"
+
+// Policy under which transactions are signed without review (see
+// INS_SET_SIGNING_POLICY in doc/api.md). A policy allows a single
+// transaction shape: one instruction of a given pattern, authorized by the
+// policy signer, on one account and within an amount cap. The cap applies to
+// each transaction, nothing accumulates across them. Anything else is
+// reviewed as usual.
+
+enum SigningPolicyPattern {
+    SigningPolicyNone = 0,
+    // Vote UpdateCommission, max_amount caps the new commission (percent)
+    SigningPolicyVoteUpdateCommission = 1,
+    // Vote Withdraw to destination, max_amount caps the lamports withdrawn
+    SigningPolicyVoteWithdraw = 2,
+};
+
+typedef struct SigningPolicy {
+    uint8_t pattern;
+    Pubkey signer;
+    Pubkey account;
+    // All zeros for patterns without a destination
+    Pubkey destination;
+    uint64_t max_amount;
+} SigningPolicy;
+
+// Check the fields of a policy before it is installed
+int signing_policy_validate(const SigningPolicy* policy);
+
+// 0 if the message, whose header was parsed already, is allowed by policy
+int signing_policy_match(const SigningPolicy* policy,
+                         const MessageHeader* header,
+                         const uint8_t* message_body,
+                         int message_body_length);
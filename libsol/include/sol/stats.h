@@ -0,0 +1,69 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Counters of the work done on libsol's hot paths, to attribute cost and
+// cache effectiveness without a profiler. They only exist in builds with
+// LIBSOL_STATS defined (`make -C libsol STATS=1`): otherwise counting compiles
+// to nothing, libsol_stats_reset() does nothing and snapshots are all zero.
+
+#define LIBSOL_STATS_MAX_BAIL_SITES 64
+
+// A BAIL_IF that failed, and how often
+typedef struct LibsolStatsBailSite {
+    const char* file;
+    int line;
+    uint64_t count;
+} LibsolStatsBailSite;
+
+typedef struct LibsolStats {
+    // Bytes the parser consumed
+    uint64_t parser_bytes;
+    // Compares of an instruction's program id to a known one
+    uint64_t program_id_compares;
+    uint64_t base58_encodes;
+    // Input bytes of encode_base58()
+    uint64_t base58_bytes;
+    uint64_t token_amount_prints;
+    uint64_t summary_item_renders;
+    // get_token_symbol() answers, by where they came from
+    uint64_t token_cache_hits;
+    uint64_t token_registry_hits;
+    uint64_t token_provider_hits;
+    uint64_t token_symbol_misses;
+    // Every BAIL_IF failure, then by call site. A failure is counted by each
+    // BAIL_IF it unwinds through, sites past the table only in the total.
+    uint64_t bail_failures;
+    size_t num_bail_sites;
+    LibsolStatsBailSite bail_sites[LIBSOL_STATS_MAX_BAIL_SITES];
+} LibsolStats;
+
+#ifdef LIBSOL_STATS
+
+extern LibsolStats G_libsol_stats;
+
+void libsol_stats_reset(void);
+
+void libsol_stats_snapshot(LibsolStats* snapshot);
+
+void libsol_stats_bail(const char* file, int line);
+
+#define LIBSOL_STATS_ADD(counter, n) (G_libsol_stats.counter += (n))
+#define LIBSOL_STATS_BAIL()          libsol_stats_bail(__FILE__, __LINE__)
+
+#else
+
+#include <string.h>
+
+static inline void libsol_stats_reset(void) {
+}
+
+static inline void libsol_stats_snapshot(LibsolStats* snapshot) {
+    memset(snapshot, 0, sizeof(*snapshot));
+}
+
+#define LIBSOL_STATS_ADD(counter, n) ((void) 0)
+#define LIBSOL_STATS_BAIL()          ((void) 0)
+
+#endif
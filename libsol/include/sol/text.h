@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Printable ASCII only, 0x20 to 0x7e
+bool is_data_ascii(const uint8_t* data, size_t length);
+
+// Well-formed UTF-8 without overlong forms, surrogates, code points above
+// U+10FFFF, or the noncharacters U+FFFE and U+FFFF
+bool is_data_utf8(const uint8_t* data, size_t length);
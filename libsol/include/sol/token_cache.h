@@ -0,0 +1,31 @@
+#pragma once
+
+#include "sol/parser.h"
+
+// Session cache of token metadata provisioned at runtime (see
+// INS_PROVIDE_TOKEN_DESCRIPTOR in doc/api.md). get_token_symbol() consults it
+// before the static TOKEN_REGISTRY. The cache only lives in RAM: it is
+// emptied by token_cache_reset() and never persisted.
+//
+// Entries must have been authenticated by the caller before insertion.
+
+#ifdef TARGET_NANOS
+#define TOKEN_CACHE_ENTRIES 4
+#else
+#define TOKEN_CACHE_ENTRIES 8
+#endif
+
+#define TOKEN_SYMBOL_MAX_LENGTH 9
+
+typedef struct TokenCacheEntry {
+    Pubkey mint_address;
+    char symbol[TOKEN_SYMBOL_MAX_LENGTH + 1];
+} TokenCacheEntry;
+
+void token_cache_reset();
+
+// Insert or refresh an entry, evicting the least recently used one when full
+int token_cache_insert(const Pubkey* mint_address, const char* symbol, size_t symbol_length);
+
+// NULL if mint_address is not cached. A hit marks the entry most recently used
+const TokenCacheEntry* token_cache_lookup(const Pubkey* mint_address);
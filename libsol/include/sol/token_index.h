@@ -0,0 +1,44 @@
+#pragma once
+
+#include "sol/parser.h"
+#include "sol/token_provider.h"
+
+// Host-only, read-only token metadata index backed by a memory-mapped file
+// produced by util/gen-token-index.py.
+//
+// File layout, all integers little endian:
+//   header   magic "SOLTKIDX" | u32 version | u32 record count
+//   records  fixed 48-byte TokenIndexRecord entries in Eytzinger order, that
+//            is the breadth-first layout of a binary search tree over the
+//            mints sorted by their bytes
+//
+// Opening only validates the header and the file size, so startup cost does
+// not depend on the number of records. Lookups never allocate.
+
+#define TOKEN_INDEX_MAGIC   "SOLTKIDX"
+#define TOKEN_INDEX_VERSION 1
+
+typedef struct TokenIndexRecord {
+    Pubkey mint_address;
+    char symbol[10];
+    uint8_t decimals;
+    uint8_t reserved[5];
+} TokenIndexRecord;
+
+typedef struct TokenIndex {
+    const TokenIndexRecord* records;
+    size_t count;
+    // Whole mapping, kept for token_index_close()
+    const void* mapping;
+    size_t mapping_length;
+} TokenIndex;
+
+int token_index_open(const char* path, TokenIndex* index);
+
+void token_index_close(TokenIndex* index);
+
+// NULL if mint_address is not in the index
+const TokenIndexRecord* token_index_lookup(const TokenIndex* index, const Pubkey* mint_address);
+
+// TokenSymbolProvider adapter, context is a TokenIndex*
+const char* token_index_get_symbol(const Pubkey* mint_address, const void* context);
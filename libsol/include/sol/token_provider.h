@@ -0,0 +1,15 @@
+#pragma once
+
+#include "sol/parser.h"
+
+// Pluggable source of token symbols consulted by get_token_symbol() after the
+// session cache and the compiled-in TOKEN_REGISTRY. Host builds use it to
+// serve a much larger token list (see sol/token_index.h); the app never
+// installs one.
+//
+// A provider returns NULL for mints it does not know. The returned string
+// must stay valid for as long as the provider is installed.
+typedef const char* (*TokenSymbolProvider)(const Pubkey* mint_address, const void* context);
+
+// Pass NULL to remove the current provider
+void set_token_symbol_provider(TokenSymbolProvider provider, const void* context);
@@ -8,23 +8,28 @@
 #include "util.h"
 #include <string.h>
 
+static bool is_program_id(const Pubkey* program_id, const Pubkey* expected) {
+    LIBSOL_STATS_ADD(program_id_compares, 1);
+    return memcmp(program_id, expected, PUBKEY_SIZE) == 0;
+}
+
 enum ProgramId instruction_program_id(const Instruction* instruction, const MessageHeader* header) {
     const Pubkey* program_id = &header->pubkeys[instruction->program_id_index];
-    if (memcmp(program_id, &system_program_id, PUBKEY_SIZE) == 0) {
+    if (is_program_id(program_id, &system_program_id)) {
         return ProgramIdSystem;
-    } else if (memcmp(program_id, &stake_program_id, PUBKEY_SIZE) == 0) {
+    } else if (is_program_id(program_id, &stake_program_id)) {
         return ProgramIdStake;
-    } else if (memcmp(program_id, &vote_program_id, PUBKEY_SIZE) == 0) {
+    } else if (is_program_id(program_id, &vote_program_id)) {
         return ProgramIdVote;
-    } else if (memcmp(program_id, &spl_token_program_id, PUBKEY_SIZE) == 0) {
+    } else if (is_program_id(program_id, &spl_token_program_id)) {
         return ProgramIdSplToken;
-    } else if (memcmp(program_id, &spl_associated_token_account_program_id, PUBKEY_SIZE) == 0) {
+    } else if (is_program_id(program_id, &spl_associated_token_account_program_id)) {
         return ProgramIdSplAssociatedTokenAccount;
     } else if (is_serum_assert_owner_program_id(program_id)) {
         return ProgramIdSerumAssertOwner;
-    } else if (memcmp(program_id, &spl_memo_program_id, PUBKEY_SIZE) == 0) {
+    } else if (is_program_id(program_id, &spl_memo_program_id)) {
         return ProgramIdSplMemo;
-    } else if (memcmp(program_id, &compute_budget_program_id, PUBKEY_SIZE) == 0) {
+    } else if (is_program_id(program_id, &compute_budget_program_id)) {
         return ProgramIdComputeBudget;
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "sol/message.h"
 #include "sol/parser.h"
 #include "spl_associated_token_account_instruction.h"
 #include "spl_token_instruction.h"
@@ -36,6 +37,14 @@ typedef struct InstructionInfo {
 enum ProgramId instruction_program_id(const Instruction* instruction, const MessageHeader* header);
 int instruction_validate(const Instruction* instruction, const MessageHeader* header);
 
+// Parse every instruction of a message body into instruction_info, which
+// holds MAX_INSTRUCTIONS entries. Fails unless all of them are known and the
+// body is fully consumed. Defined in message.c
+int parse_message_instructions(const uint8_t* message_body,
+                               int message_body_length,
+                               const MessageHeader* header,
+                               InstructionInfo* instruction_info);
+
 typedef struct InstructionBrief {
     enum ProgramId program_id;
     union {
@@ -0,0 +1,53 @@
+#include "lru_cache.h"
+#include <string.h>
+
+static void* lru_cache_entry(const LruCache* cache, size_t index) {
+    return (uint8_t*) cache->entries + index * cache->entry_size;
+}
+
+static void lru_cache_touch(const LruCache* cache, size_t index) {
+    cache->last_used[index] = ++*cache->clock;
+}
+
+static int lru_cache_find(const LruCache* cache, const void* key) {
+    for (size_t i = 0; i < cache->capacity; i++) {
+        if (cache->last_used[i] != 0 && cache->match(lru_cache_entry(cache, i), key)) {
+            return (int) i;
+        }
+    }
+    return -1;
+}
+
+void lru_cache_reset(const LruCache* cache) {
+    explicit_bzero(cache->entries, cache->capacity * cache->entry_size);
+    explicit_bzero(cache->last_used, cache->capacity * sizeof(cache->last_used[0]));
+    *cache->clock = 0;
+}
+
+void* lru_cache_lookup(const LruCache* cache, const void* key) {
+    int found = lru_cache_find(cache, key);
+    if (found < 0) {
+        return NULL;
+    }
+    lru_cache_touch(cache, (size_t) found);
+    return lru_cache_entry(cache, (size_t) found);
+}
+
+void* lru_cache_claim(const LruCache* cache, const void* key) {
+    int found = lru_cache_find(cache, key);
+    size_t index = 0;
+    if (found >= 0) {
+        index = (size_t) found;
+    } else {
+        for (size_t i = 1; i < cache->capacity; i++) {
+            if (cache->last_used[i] < cache->last_used[index]) {
+                index = i;
+            }
+        }
+    }
+
+    void* entry = lru_cache_entry(cache, index);
+    explicit_bzero(entry, cache->entry_size);
+    lru_cache_touch(cache, index);
+    return entry;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Whether entry is the one of key
+typedef bool (*LruCacheMatch)(const void* entry, const void* key);
+
+// A fixed number of entries of one size, the least recently used being
+// replaced when full. The caller owns the storage, this only describes it:
+// build it on the stack for each call, so that no pointer has to be
+// relocated.
+typedef struct LruCache {
+    void* entries;
+    // Zero marks an unused entry, higher values were used more recently
+    uint32_t* last_used;
+    uint32_t* clock;
+    size_t entry_size;
+    size_t capacity;
+    LruCacheMatch match;
+} LruCache;
+
+#define LRU_CACHE(storage, match_entry)                                   \
+    ((LruCache){(storage).entries,                                        \
+                (storage).last_used,                                      \
+                &(storage).clock,                                         \
+                sizeof((storage).entries[0]),                             \
+                sizeof((storage).entries) / sizeof((storage).entries[0]), \
+                (match_entry)})
+
+void lru_cache_reset(const LruCache* cache);
+
+// The entry of key, NULL if not cached. A hit marks the entry most recently
+// used
+void* lru_cache_lookup(const LruCache* cache, const void* key);
+
+// The entry of key if cached, otherwise the least recently used one, wiped.
+// Either way it is marked most recently used, for the caller to fill in
+void* lru_cache_claim(const LruCache* cache, const void* key);
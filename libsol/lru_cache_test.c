@@ -0,0 +1,114 @@
+#include "lru_cache.h"
+#include "util.h"
+#include <assert.h>
+#include <stdio.h>
+
+#define TEST_CACHE_ENTRIES 4
+
+typedef struct TestEntry {
+    uint32_t key;
+    uint32_t value;
+} TestEntry;
+
+typedef struct TestCache {
+    TestEntry entries[TEST_CACHE_ENTRIES];
+    uint32_t last_used[TEST_CACHE_ENTRIES];
+    uint32_t clock;
+} TestCache;
+
+static TestCache G_test_cache;
+
+static bool test_entry_match(const void* entry, const void* key) {
+    return ((const TestEntry*) entry)->key == *(const uint32_t*) key;
+}
+
+static void insert(const LruCache* cache, uint32_t key, uint32_t value) {
+    TestEntry* entry = lru_cache_claim(cache, &key);
+    assert(entry->key == 0 && entry->value == 0);
+    entry->key = key;
+    entry->value = value;
+}
+
+static const TestEntry* lookup(const LruCache* cache, uint32_t key) {
+    return lru_cache_lookup(cache, &key);
+}
+
+void test_lru_cache_insert_lookup() {
+    const LruCache cache = LRU_CACHE(G_test_cache, test_entry_match);
+    lru_cache_reset(&cache);
+
+    assert(cache.capacity == TEST_CACHE_ENTRIES);
+    assert(cache.entry_size == sizeof(TestEntry));
+    assert(lookup(&cache, 1) == NULL);
+    insert(&cache, 1, 10);
+
+    const TestEntry* entry = lookup(&cache, 1);
+    assert(entry != NULL);
+    assert(entry->value == 10);
+}
+
+void test_lru_cache_unused_entries_never_match() {
+    const LruCache cache = LRU_CACHE(G_test_cache, test_entry_match);
+    lru_cache_reset(&cache);
+
+    // the wiped entries all hold key 0
+    assert(lookup(&cache, 0) == NULL);
+}
+
+void test_lru_cache_refresh_existing() {
+    const LruCache cache = LRU_CACHE(G_test_cache, test_entry_match);
+    lru_cache_reset(&cache);
+
+    insert(&cache, 1, 10);
+    insert(&cache, 1, 11);
+    assert(lookup(&cache, 1)->value == 11);
+
+    // refreshing took no other entry
+    for (uint32_t key = 2; key < TEST_CACHE_ENTRIES + 1; key++) {
+        insert(&cache, key, key);
+    }
+    assert(lookup(&cache, 1)->value == 11);
+}
+
+void test_lru_cache_evicts_least_recently_used() {
+    const LruCache cache = LRU_CACHE(G_test_cache, test_entry_match);
+    lru_cache_reset(&cache);
+    for (uint32_t key = 1; key <= TEST_CACHE_ENTRIES; key++) {
+        insert(&cache, key, key);
+    }
+
+    // Touch the oldest entry so the second one becomes least recently used
+    assert(lookup(&cache, 1) != NULL);
+    insert(&cache, TEST_CACHE_ENTRIES + 1, 0);
+
+    assert(lookup(&cache, 1) != NULL);
+    assert(lookup(&cache, 2) == NULL);
+    assert(lookup(&cache, TEST_CACHE_ENTRIES + 1) != NULL);
+
+    // then the third, the one untouched the longest
+    insert(&cache, TEST_CACHE_ENTRIES + 2, 0);
+    assert(lookup(&cache, 3) == NULL);
+    assert(lookup(&cache, 4) != NULL);
+}
+
+void test_lru_cache_reset() {
+    const LruCache cache = LRU_CACHE(G_test_cache, test_entry_match);
+    lru_cache_reset(&cache);
+
+    insert(&cache, 1, 10);
+    lru_cache_reset(&cache);
+    assert(lookup(&cache, 1) == NULL);
+    assert(G_test_cache.entries[0].value == 0);
+    assert(G_test_cache.clock == 0);
+}
+
+int main() {
+    test_lru_cache_insert_lookup();
+    test_lru_cache_unused_entries_never_match();
+    test_lru_cache_refresh_existing();
+    test_lru_cache_evicts_least_recently_used();
+    test_lru_cache_reset();
+
+    printf("passed\n");
+    return 0;
+}
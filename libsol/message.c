@@ -12,30 +12,22 @@
 #include "compute_budget_instruction.h"
 #include <string.h>
 
-#define MAX_INSTRUCTIONS 4
-
-int process_message_body(const uint8_t* message_body,
-                         int message_body_length,
-                         const PrintConfig* print_config) {
-    const MessageHeader* header = &print_config->header;
-
+int parse_message_instructions(const uint8_t* message_body,
+                               int message_body_length,
+                               const MessageHeader* header,
+                               InstructionInfo* instruction_info) {
     BAIL_IF(header->instructions_length == 0);
     BAIL_IF(header->instructions_length > MAX_INSTRUCTIONS);
 
-    size_t instruction_count = 0;
-    InstructionInfo instruction_info[MAX_INSTRUCTIONS];
     explicit_bzero(instruction_info, sizeof(InstructionInfo) * MAX_INSTRUCTIONS);
 
-    size_t display_instruction_count = 0;
-    InstructionInfo* display_instruction_info[MAX_INSTRUCTIONS];
-
     Parser parser = {message_body, message_body_length};
-    for (; instruction_count < header->instructions_length; instruction_count++) {
+    for (size_t i = 0; i < header->instructions_length; i++) {
         Instruction instruction;
         BAIL_IF(parse_instruction(&parser, &instruction));
         BAIL_IF(instruction_validate(&instruction, header));
 
-        InstructionInfo* info = &instruction_info[instruction_count];
+        InstructionInfo* info = &instruction_info[i];
         enum ProgramId program_id = instruction_program_id(&instruction, header);
         switch (program_id) {
             case ProgramIdSerumAssertOwner: {
@@ -91,6 +83,40 @@ int process_message_body(const uint8_t* message_body,
             case ProgramIdUnknown:
                 break;
         }
+    }
+
+    if (header->versioned) {
+        size_t account_tables_length;
+        BAIL_IF(parse_length(&parser, &account_tables_length));
+        BAIL_IF(account_tables_length > 0);
+    }
+
+    // Ensure we've consumed the entire message body
+    BAIL_IF(!parser_is_empty(&parser));
+
+    // If we don't know about all of the instructions, bail
+    for (size_t i = 0; i < header->instructions_length; i++) {
+        BAIL_IF(instruction_info[i].kind == ProgramIdUnknown);
+    }
+
+    return 0;
+}
+
+int process_message_body(const uint8_t* message_body,
+                         int message_body_length,
+                         const PrintConfig* print_config) {
+    const MessageHeader* header = &print_config->header;
+
+    InstructionInfo instruction_info[MAX_INSTRUCTIONS];
+    BAIL_IF(parse_message_instructions(message_body,
+                                       message_body_length,
+                                       header,
+                                       instruction_info));
+
+    size_t display_instruction_count = 0;
+    InstructionInfo* display_instruction_info[MAX_INSTRUCTIONS];
+    for (size_t i = 0; i < header->instructions_length; i++) {
+        InstructionInfo* info = &instruction_info[i];
         switch (info->kind) {
             case ProgramIdSplAssociatedTokenAccount:
             case ProgramIdSplToken:
@@ -108,19 +134,5 @@ int process_message_body(const uint8_t* message_body,
         }
     }
 
-    if (header->versioned) {
-        size_t account_tables_length;
-        BAIL_IF(parse_length(&parser, &account_tables_length));
-        BAIL_IF(account_tables_length > 0);
-    }
-
-    // Ensure we've consumed the entire message body
-    BAIL_IF(!parser_is_empty(&parser));
-
-    // If we don't know about all of the instructions, bail
-    for (size_t i = 0; i < instruction_count; i++) {
-        BAIL_IF(instruction_info[i].kind == ProgramIdUnknown);
-    }
-
     return print_transaction(print_config, display_instruction_info, display_instruction_count);
 }
@@ -0,0 +1,362 @@
+#include "bench.h"
+#include "sol/message_generator.h"
+#include "util.h"
+#include <dirent.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Replays the transactions of the fuzzing corpus through what the device
+// does to review one: parse, summarize, finalize, render every item.
+// `message_bench results.json` also writes the results as JSON, to compare
+// them between commits. `message_bench -s stream [results.json]` replays a
+// stream of message_generator_tool instead, once per round as it is large.
+// `message_bench -c phase` runs every message once up to phase, or "load"
+// for none, and times nothing: instruction counts of such runs under an
+// emulator tell what each phase costs on the device, see util/arm-profile.sh.
+// Built with STATS=1, it also reports the hot path counters of loading, which
+// reviews every message once, refused ones included.
+#define CORPUS_DIR         "../fuzzing/corpus"
+#define MAX_MESSAGES       128
+#define MAX_MESSAGE_LENGTH 1280
+#define ROUNDS             10
+#define ITERATIONS         100
+#define STREAM_ROUNDS      3
+
+typedef struct Message {
+    char name[64];
+    uint8_t data[MAX_MESSAGE_LENGTH];
+    size_t length;
+} Message;
+
+static Message G_messages[MAX_MESSAGES];
+static size_t G_num_messages;
+
+// Stream messages, back to back, and where each one starts
+static uint8_t* G_stream;
+static size_t* G_stream_offsets;
+static size_t G_num_stream_messages;
+
+static size_t G_rounds = ROUNDS;
+static size_t G_iterations = ITERATIONS;
+
+// Each phase is timed as the difference between running the pipeline up to
+// it and up to the one before, so that no clock is read inside the pipeline
+//
+// Nanoseconds per run of a corpus message, up to a phase, in a round
+static double G_ns[ROUNDS][BenchPhaseCount][MAX_MESSAGES];
+
+// Nanoseconds per message, up to a phase, averaged over a round
+static double G_round_ns[ROUNDS][BenchPhaseCount];
+
+static size_t read_file(const char* path, uint8_t* buffer, size_t buffer_size) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    const size_t length = fread(buffer, 1, buffer_size, file);
+    fclose(file);
+    return length;
+}
+
+// Load the corpus entries the device would display, some are meant to fail
+static int load_corpus(size_t* num_skipped) {
+    DIR* dir = opendir(CORPUS_DIR);
+    if (dir == NULL) {
+        printf("cannot open %s\n", CORPUS_DIR);
+        return 1;
+    }
+    *num_skipped = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL && G_num_messages < MAX_MESSAGES) {
+        const size_t name_length = strlen(entry->d_name);
+        if (name_length < 4 || strcmp(entry->d_name + name_length - 4, ".raw") != 0) {
+            continue;
+        }
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", CORPUS_DIR, entry->d_name);
+
+        Message* message = &G_messages[G_num_messages];
+        snprintf(message->name,
+                 sizeof(message->name),
+                 "%.*s",
+                 (int) name_length - 4,
+                 entry->d_name);
+        message->length = read_file(path, message->data, sizeof(message->data));
+        if (message->length == 0 ||
+            bench_run_pipeline(message->data, message->length, BenchPhaseDisplay) != 0) {
+            (*num_skipped)++;
+            continue;
+        }
+        G_num_messages++;
+    }
+    closedir(dir);
+
+    if (G_num_messages == 0) {
+        printf("no message in %s\n", CORPUS_DIR);
+        return 1;
+    }
+    return 0;
+}
+
+// Load the stream messages the device would display, near misses and
+// unknown programs are meant to fail
+static int load_stream(const char* path, size_t* num_skipped) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        printf("cannot open %s\n", path);
+        return 1;
+    }
+    *num_skipped = 0;
+    size_t stream_size = 0, capacity = 0, length = 0;
+    uint8_t message[MAX_MESSAGE_LENGTH];
+    while (message_stream_read(file, message, sizeof(message), &length) == 0) {
+        if (bench_run_pipeline(message, length, BenchPhaseDisplay) != 0) {
+            (*num_skipped)++;
+            continue;
+        }
+        if (G_num_stream_messages == capacity) {
+            capacity = capacity ? 2 * capacity : 1024;
+            G_stream = realloc(G_stream, capacity * MAX_MESSAGE_LENGTH);
+            G_stream_offsets = realloc(G_stream_offsets, (capacity + 1) * sizeof(size_t));
+            if (G_stream == NULL || G_stream_offsets == NULL) {
+                printf("out of memory\n");
+                fclose(file);
+                return 1;
+            }
+        }
+        memcpy(G_stream + stream_size, message, length);
+        G_stream_offsets[G_num_stream_messages++] = stream_size;
+        stream_size += length;
+        G_stream_offsets[G_num_stream_messages] = stream_size;
+    }
+    fclose(file);
+
+    if (G_num_stream_messages == 0) {
+        printf("no message in %s\n", path);
+        return 1;
+    }
+    G_rounds = STREAM_ROUNDS;
+    G_iterations = 1;
+    return 0;
+}
+
+static size_t num_messages(void) {
+    return G_stream != NULL ? G_num_stream_messages : G_num_messages;
+}
+
+static const uint8_t* message_at(size_t m, size_t* length) {
+    if (G_stream != NULL) {
+        *length = G_stream_offsets[m + 1] - G_stream_offsets[m];
+        return G_stream + G_stream_offsets[m];
+    }
+    *length = G_messages[m].length;
+    return G_messages[m].data;
+}
+
+static void run_rounds(void) {
+    for (size_t round = 0; round < G_rounds; round++) {
+        for (BenchPhase phase = BenchPhaseParse; phase < BenchPhaseCount; phase++) {
+            double sum = 0;
+            for (size_t m = 0; m < num_messages(); m++) {
+                size_t length = 0;
+                const uint8_t* data = message_at(m, &length);
+                const uint64_t start = bench_now_ns();
+                for (size_t i = 0; i < G_iterations; i++) {
+                    bench_do_not_optimize(data);
+                    bench_run_pipeline(data, length, phase);
+                }
+                const double ns = (double) (bench_now_ns() - start) / G_iterations;
+                if (G_stream == NULL) {
+                    G_ns[round][phase][m] = ns;
+                }
+                sum += ns;
+            }
+            G_round_ns[round][phase] = sum / num_messages();
+        }
+    }
+}
+
+// Nanoseconds per message spent in phase, averaged over the messages
+static double phase_ns(size_t round, BenchPhase phase) {
+    const double ns = G_round_ns[round][phase];
+    return phase == BenchPhaseParse ? ns : ns - G_round_ns[round][phase - 1];
+}
+
+static double total_ns(size_t round) {
+    return G_round_ns[round][BenchPhaseDisplay];
+}
+
+typedef struct Stats {
+    double mean;
+    double stddev;
+} Stats;
+
+static Stats stats_of(const double* values, size_t count) {
+    Stats stats = {0, 0};
+    for (size_t i = 0; i < count; i++) {
+        stats.mean += values[i];
+    }
+    stats.mean /= count;
+    for (size_t i = 0; i < count; i++) {
+        stats.stddev += (values[i] - stats.mean) * (values[i] - stats.mean);
+    }
+    stats.stddev = sqrt(stats.stddev / count);
+    return stats;
+}
+
+static Stats total_stats(void) {
+    double values[ROUNDS];
+    for (size_t round = 0; round < G_rounds; round++) {
+        values[round] = total_ns(round);
+    }
+    return stats_of(values, G_rounds);
+}
+
+static Stats phase_stats(BenchPhase phase) {
+    double values[ROUNDS];
+    for (size_t round = 0; round < G_rounds; round++) {
+        values[round] = phase_ns(round, phase);
+    }
+    return stats_of(values, G_rounds);
+}
+
+static Stats message_stats(size_t m) {
+    double values[ROUNDS];
+    for (size_t round = 0; round < G_rounds; round++) {
+        values[round] = G_ns[round][BenchPhaseDisplay][m];
+    }
+    return stats_of(values, G_rounds);
+}
+
+static int write_json(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (file == NULL) {
+        printf("cannot write %s\n", path);
+        return 1;
+    }
+    const Stats total = total_stats();
+    fprintf(file, "{\n");
+    fprintf(file, "  \"rounds\": %zu,\n  \"iterations\": %zu,\n", G_rounds, G_iterations);
+    fprintf(file, "  \"messages\": %zu,\n", num_messages());
+    fprintf(file,
+            "  \"total\": {\"mean_ns\": %.1f, \"stddev_ns\": %.1f},\n",
+            total.mean,
+            total.stddev);
+    fprintf(file, "  \"phases\": {\n");
+    for (BenchPhase phase = BenchPhaseParse; phase < BenchPhaseCount; phase++) {
+        const Stats stats = phase_stats(phase);
+        fprintf(file,
+                "    \"%s\": {\"mean_ns\": %.1f, \"stddev_ns\": %.1f}%s\n",
+                BENCH_PHASE_NAMES[phase],
+                stats.mean,
+                stats.stddev,
+                phase + 1 < BenchPhaseCount ? "," : "");
+    }
+    // Stream messages are too many to list
+    if (G_stream != NULL) {
+        fprintf(file, "  }\n}\n");
+        fclose(file);
+        return 0;
+    }
+    fprintf(file, "  },\n  \"per_message\": {\n");
+    for (size_t m = 0; m < G_num_messages; m++) {
+        const Stats stats = message_stats(m);
+        fprintf(file,
+                "    \"%s\": {\"mean_ns\": %.1f, \"stddev_ns\": %.1f}%s\n",
+                G_messages[m].name,
+                stats.mean,
+                stats.stddev,
+                m + 1 < G_num_messages ? "," : "");
+    }
+    fprintf(file, "  }\n}\n");
+    fclose(file);
+    return 0;
+}
+
+static int run_once(const char* phase_name) {
+    BenchPhase last_phase = BenchPhaseCount;
+    for (BenchPhase phase = BenchPhaseParse; phase < BenchPhaseCount; phase++) {
+        if (strcmp(phase_name, BENCH_PHASE_NAMES[phase]) == 0) {
+            last_phase = phase;
+        }
+    }
+    if (last_phase == BenchPhaseCount && strcmp(phase_name, "load") != 0) {
+        printf("unknown phase %s\n", phase_name);
+        return 1;
+    }
+    for (size_t m = 0; m < num_messages() && last_phase != BenchPhaseCount; m++) {
+        size_t length = 0;
+        const uint8_t* data = message_at(m, &length);
+        bench_run_pipeline(data, length, last_phase);
+    }
+    printf("%zu messages\n", num_messages());
+    return 0;
+}
+
+#ifdef LIBSOL_STATS
+static void print_stats(const LibsolStats* stats, size_t count) {
+    printf("==> Counters per message, over %zu\n", count);
+    printf("%-22s %10.1f\n", "parser bytes", (double) stats->parser_bytes / count);
+    printf("%-22s %10.1f\n", "program id compares", (double) stats->program_id_compares / count);
+    printf("%-22s %10.1f\n", "base58 encodes", (double) stats->base58_encodes / count);
+    printf("%-22s %10.1f\n", "base58 bytes", (double) stats->base58_bytes / count);
+    printf("%-22s %10.1f\n", "token amount prints", (double) stats->token_amount_prints / count);
+    printf("%-22s %10.1f\n", "summary item renders", (double) stats->summary_item_renders / count);
+    printf("==> Token symbols\n");
+    printf("%-22s %10" PRIu64 "\n", "cache hits", stats->token_cache_hits);
+    printf("%-22s %10" PRIu64 "\n", "registry hits", stats->token_registry_hits);
+    printf("%-22s %10" PRIu64 "\n", "provider hits", stats->token_provider_hits);
+    printf("%-22s %10" PRIu64 "\n", "misses", stats->token_symbol_misses);
+    printf("==> BAIL_IF failures, %" PRIu64 " in all\n", stats->bail_failures);
+    for (size_t i = 0; i < stats->num_bail_sites; i++) {
+        const LibsolStatsBailSite* site = &stats->bail_sites[i];
+        printf("%10" PRIu64 " %s:%d\n", site->count, site->file, site->line);
+    }
+}
+#endif
+
+int main(int argc, char* argv[]) {
+    const char* stream = NULL;
+    if (argc > 2 && strcmp(argv[1], "-s") == 0) {
+        stream = argv[2];
+        argc -= 2;
+        argv += 2;
+    }
+    size_t num_skipped = 0;
+    libsol_stats_reset();
+    if ((stream != NULL ? load_stream(stream, &num_skipped) : load_corpus(&num_skipped)) != 0) {
+        return 1;
+    }
+    LibsolStats counters;
+    libsol_stats_snapshot(&counters);
+    if (argc > 2 && strcmp(argv[1], "-c") == 0) {
+        return run_once(argv[2]);
+    }
+    run_rounds();
+
+    const Stats total = total_stats();
+    printf("%zu messages (%zu skipped), %zu rounds of %zu iterations\n",
+           num_messages(),
+           num_skipped,
+           G_rounds,
+           G_iterations);
+    printf("%-10s %8.0f ns/message (stddev %.0f)\n", "total", total.mean, total.stddev);
+    for (BenchPhase phase = BenchPhaseParse; phase < BenchPhaseCount; phase++) {
+        const Stats stats = phase_stats(phase);
+        printf("%-10s %8.0f ns/message (stddev %.0f)\n",
+               BENCH_PHASE_NAMES[phase],
+               stats.mean,
+               stats.stddev);
+    }
+#ifdef LIBSOL_STATS
+    print_stats(&counters, num_messages() + num_skipped);
+#endif
+
+    if (argc > 1) {
+        return write_json(argv[1]);
+    }
+    return 0;
+}
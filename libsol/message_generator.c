@@ -0,0 +1,1122 @@
+#include "common_byte_strings.h"
+#include "compute_budget_instruction.h"
+#include "sol/message.h"
+#include "sol/message_generator.h"
+#include "spl/token.h"
+#include "spl_associated_token_account_instruction.h"
+#include "spl_token_instruction.h"
+#include "stake_instruction.h"
+#include "system_instruction.h"
+#include "vote_instruction.h"
+#include "util.h"
+#include <string.h>
+
+#define MAX_KEYS     32
+#define MAX_ACCOUNTS 16
+#define MAX_DATA     160
+#define MAX_SEED     20
+
+#define KEY_SIGNER   0x01
+#define KEY_WRITABLE 0x02
+
+static const Pubkey SYSVAR_RENT_ID = {{SYSVAR_RENT}};
+static const Pubkey SYSVAR_CLOCK_ID = {{SYSVAR_CLOCK}};
+static const Pubkey SYSVAR_STAKE_HISTORY_ID = {{SYSVAR_STAKE_HISTORY}};
+static const Pubkey SYSVAR_RECENT_BLOCKHASHES_ID = {{SYSVAR_RECENT_BLOCKHASHES}};
+static const Pubkey STAKE_CONFIG_ID = {{STAKE_CONFIG}};
+
+// Accounts of a message, by what they stand for in its instructions
+enum Role {
+    RolePayer = 0,
+    RoleAuthority,
+    RoleNewAuthority,
+    RoleAccount,
+    RoleNewAccount,
+    RoleVote,
+    RoleMint,
+    RoleDestination,
+    RoleNonce,
+    RoleUnknownProgram,
+    RoleCount,
+};
+
+typedef struct GeneratedInstruction {
+    const Pubkey* program_id;
+    const Pubkey* accounts[MAX_ACCOUNTS];
+    uint8_t account_flags[MAX_ACCOUNTS];
+    size_t num_accounts;
+    uint8_t data[MAX_DATA];
+    size_t data_length;
+    // Bytes of the instruction kind at the start of data, 0 if it has none
+    size_t kind_length;
+    // Near miss, its first account refers past the account table
+    bool bad_account_index;
+} GeneratedInstruction;
+
+typedef struct Builder {
+    MessageGenerator* generator;
+    Pubkey roles[RoleCount];
+    Pubkey multisig_signers[Token_MAX_SIGNERS];
+    GeneratedInstruction instructions[MAX_INSTRUCTIONS];
+    size_t num_instructions;
+} Builder;
+
+//
+// Randomness
+//
+
+static uint64_t next_random(MessageGenerator* generator) {
+    uint64_t x = generator->state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    generator->state = x;
+    return x;
+}
+
+static size_t random_below(Builder* b, size_t bound) {
+    return next_random(b->generator) % bound;
+}
+
+static bool random_chance(Builder* b, unsigned percent) {
+    return random_below(b, 100) < percent;
+}
+
+static void random_pubkey(MessageGenerator* generator, Pubkey* pubkey) {
+    for (size_t i = 0; i < PUBKEY_SIZE; i += sizeof(uint64_t)) {
+        const uint64_t word = next_random(generator);
+        memcpy(&pubkey->data[i], &word, sizeof(word));
+    }
+}
+
+//
+// Instructions
+//
+
+static GeneratedInstruction* begin(Builder* b, const Pubkey* program_id) {
+    GeneratedInstruction* ix = &b->instructions[b->num_instructions++];
+    memset(ix, 0, sizeof(*ix));
+    ix->program_id = program_id;
+    return ix;
+}
+
+static void account(GeneratedInstruction* ix, const Pubkey* key, uint8_t flags) {
+    ix->accounts[ix->num_accounts] = key;
+    ix->account_flags[ix->num_accounts] = flags;
+    ix->num_accounts++;
+}
+
+static void role(Builder* b, GeneratedInstruction* ix, enum Role r, uint8_t flags) {
+    account(ix, &b->roles[r], flags);
+}
+
+static void put_bytes(GeneratedInstruction* ix, const void* bytes, size_t length) {
+    memcpy(ix->data + ix->data_length, bytes, length);
+    ix->data_length += length;
+}
+
+static void put_u8(GeneratedInstruction* ix, uint8_t value) {
+    put_bytes(ix, &value, 1);
+}
+
+static void put_u32(GeneratedInstruction* ix, uint32_t value) {
+    for (size_t i = 0; i < 4; i++) {
+        put_u8(ix, value >> (8 * i));
+    }
+}
+
+static void put_u64(GeneratedInstruction* ix, uint64_t value) {
+    for (size_t i = 0; i < 8; i++) {
+        put_u8(ix, value >> (8 * i));
+    }
+}
+
+static void put_pubkey(GeneratedInstruction* ix, const Pubkey* pubkey) {
+    put_bytes(ix, pubkey->data, PUBKEY_SIZE);
+}
+
+static void put_role(Builder* b, GeneratedInstruction* ix, enum Role r) {
+    put_pubkey(ix, &b->roles[r]);
+}
+
+static void put_seed(Builder* b, GeneratedInstruction* ix) {
+    const size_t length = 1 + random_below(b, MAX_SEED);
+    put_u64(ix, length);
+    for (size_t i = 0; i < length; i++) {
+        put_u8(ix, 'a' + random_below(b, 26));
+    }
+}
+
+static void put_kind_u8(GeneratedInstruction* ix, uint8_t kind) {
+    put_u8(ix, kind);
+    ix->kind_length = 1;
+}
+
+static void put_kind_u32(GeneratedInstruction* ix, uint32_t kind) {
+    put_u32(ix, kind);
+    ix->kind_length = 4;
+}
+
+static uint64_t random_lamports(Builder* b) {
+    return 1 + random_below(b, 1000000000000ull);
+}
+
+// System
+
+static void system_create_account(Builder* b, const Pubkey* owner, bool funded) {
+    GeneratedInstruction* ix = begin(b, &system_program_id);
+    role(b, ix, RolePayer, KEY_SIGNER | KEY_WRITABLE);
+    role(b, ix, RoleNewAccount, KEY_SIGNER | KEY_WRITABLE);
+    put_kind_u32(ix, SystemCreateAccount);
+    put_u64(ix, funded ? random_lamports(b) : 0);
+    put_u64(ix, random_below(b, 1024));
+    put_pubkey(ix, owner);
+}
+
+static void system_create_account_with_seed(Builder* b, const Pubkey* owner, bool funded) {
+    GeneratedInstruction* ix = begin(b, &system_program_id);
+    role(b, ix, RolePayer, KEY_SIGNER | KEY_WRITABLE);
+    role(b, ix, RoleNewAccount, KEY_WRITABLE);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, SystemCreateAccountWithSeed);
+    put_role(b, ix, RoleAuthority);
+    put_seed(b, ix);
+    put_u64(ix, funded ? random_lamports(b) : 0);
+    put_u64(ix, random_below(b, 1024));
+    put_pubkey(ix, owner);
+}
+
+static void system_transfer(Builder* b, enum Role to) {
+    GeneratedInstruction* ix = begin(b, &system_program_id);
+    role(b, ix, RoleAuthority, KEY_SIGNER | KEY_WRITABLE);
+    role(b, ix, to, KEY_WRITABLE);
+    put_kind_u32(ix, SystemTransfer);
+    put_u64(ix, random_lamports(b));
+}
+
+static void system_assign(Builder* b, const Pubkey* owner) {
+    GeneratedInstruction* ix = begin(b, &system_program_id);
+    role(b, ix, RoleNewAccount, KEY_SIGNER | KEY_WRITABLE);
+    put_kind_u32(ix, SystemAssign);
+    put_pubkey(ix, owner);
+}
+
+static void system_allocate(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &system_program_id);
+    role(b, ix, RoleNewAccount, KEY_SIGNER | KEY_WRITABLE);
+    put_kind_u32(ix, SystemAllocate);
+    put_u64(ix, random_below(b, 1024));
+}
+
+static void system_allocate_with_seed(Builder* b, const Pubkey* owner) {
+    GeneratedInstruction* ix = begin(b, &system_program_id);
+    role(b, ix, RoleNewAccount, KEY_WRITABLE);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, SystemAllocateWithSeed);
+    put_role(b, ix, RoleAuthority);
+    put_seed(b, ix);
+    put_u64(ix, random_below(b, 1024));
+    put_pubkey(ix, owner);
+}
+
+static void system_advance_nonce(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &system_program_id);
+    role(b, ix, RoleNonce, KEY_WRITABLE);
+    account(ix, &SYSVAR_RECENT_BLOCKHASHES_ID, 0);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, SystemAdvanceNonceAccount);
+}
+
+static void system_initialize_nonce(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &system_program_id);
+    role(b, ix, RoleNewAccount, KEY_WRITABLE);
+    account(ix, &SYSVAR_RECENT_BLOCKHASHES_ID, 0);
+    account(ix, &SYSVAR_RENT_ID, 0);
+    put_kind_u32(ix, SystemInitializeNonceAccount);
+    put_role(b, ix, RoleAuthority);
+}
+
+static void system_withdraw_nonce(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &system_program_id);
+    role(b, ix, RoleNonce, KEY_WRITABLE);
+    role(b, ix, RoleDestination, KEY_WRITABLE);
+    account(ix, &SYSVAR_RECENT_BLOCKHASHES_ID, 0);
+    account(ix, &SYSVAR_RENT_ID, 0);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, SystemWithdrawNonceAccount);
+    put_u64(ix, random_lamports(b));
+}
+
+static void system_authorize_nonce(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &system_program_id);
+    role(b, ix, RoleNonce, KEY_WRITABLE);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, SystemAuthorizeNonceAccount);
+    put_role(b, ix, RoleNewAuthority);
+}
+
+// Stake
+
+static void stake_initialize(Builder* b, bool lockup_allowed) {
+    GeneratedInstruction* ix = begin(b, &stake_program_id);
+    role(b, ix, RoleNewAccount, KEY_WRITABLE);
+    account(ix, &SYSVAR_RENT_ID, 0);
+    put_kind_u32(ix, StakeInitialize);
+    put_role(b, ix, RoleAuthority);
+    put_role(b, ix, random_chance(b, 50) ? RoleAuthority : RoleNewAuthority);
+    // Lockup, in force or not
+    const bool lockup = lockup_allowed && random_chance(b, 25);
+    put_u64(ix, lockup ? random_below(b, 2000000000) : 0);
+    put_u64(ix, lockup ? random_below(b, 1000) : 0);
+    if (lockup) {
+        put_role(b, ix, RoleNewAuthority);
+    } else {
+        put_pubkey(ix, &system_program_id);
+    }
+}
+
+static void stake_initialize_checked(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &stake_program_id);
+    role(b, ix, RoleNewAccount, KEY_WRITABLE);
+    account(ix, &SYSVAR_RENT_ID, 0);
+    role(b, ix, RoleAuthority, 0);
+    role(b, ix, RoleNewAuthority, KEY_SIGNER);
+    put_kind_u32(ix, StakeInitializeChecked);
+}
+
+static void stake_delegate(Builder* b, enum Role stake) {
+    GeneratedInstruction* ix = begin(b, &stake_program_id);
+    role(b, ix, stake, KEY_WRITABLE);
+    role(b, ix, RoleVote, 0);
+    account(ix, &SYSVAR_CLOCK_ID, 0);
+    account(ix, &SYSVAR_STAKE_HISTORY_ID, 0);
+    account(ix, &STAKE_CONFIG_ID, 0);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, StakeDelegate);
+}
+
+static void stake_split(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &stake_program_id);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    role(b, ix, RoleNewAccount, KEY_WRITABLE);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, StakeSplit);
+    put_u64(ix, random_lamports(b));
+}
+
+static void stake_withdraw(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &stake_program_id);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    role(b, ix, RoleDestination, KEY_WRITABLE);
+    account(ix, &SYSVAR_CLOCK_ID, 0);
+    account(ix, &SYSVAR_STAKE_HISTORY_ID, 0);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, StakeWithdraw);
+    put_u64(ix, random_lamports(b));
+}
+
+static void stake_authorize(Builder* b, enum StakeAuthorize authorize) {
+    GeneratedInstruction* ix = begin(b, &stake_program_id);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    account(ix, &SYSVAR_CLOCK_ID, 0);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, StakeAuthorize);
+    put_role(b, ix, RoleNewAuthority);
+    put_u32(ix, authorize);
+}
+
+static void stake_authorize_checked(Builder* b, enum StakeAuthorize authorize) {
+    GeneratedInstruction* ix = begin(b, &stake_program_id);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    account(ix, &SYSVAR_CLOCK_ID, 0);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    role(b, ix, RoleNewAuthority, KEY_SIGNER);
+    put_kind_u32(ix, StakeAuthorizeChecked);
+    put_u32(ix, authorize);
+}
+
+static void stake_deactivate(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &stake_program_id);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    account(ix, &SYSVAR_CLOCK_ID, 0);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, StakeDeactivate);
+}
+
+static void stake_merge(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &stake_program_id);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    role(b, ix, RoleNewAccount, KEY_WRITABLE);
+    account(ix, &SYSVAR_CLOCK_ID, 0);
+    account(ix, &SYSVAR_STAKE_HISTORY_ID, 0);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, StakeMerge);
+}
+
+static void stake_set_lockup(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &stake_program_id);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, StakeSetLockup);
+    put_u8(ix, OptionSome);
+    put_u64(ix, random_below(b, 2000000000));
+    put_u8(ix, OptionNone);
+    put_u8(ix, OptionSome);
+    put_role(b, ix, RoleNewAuthority);
+}
+
+// Vote
+
+static void vote_initialize(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &vote_program_id);
+    role(b, ix, RoleNewAccount, KEY_WRITABLE);
+    account(ix, &SYSVAR_RENT_ID, 0);
+    account(ix, &SYSVAR_CLOCK_ID, 0);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, VoteInitialize);
+    put_role(b, ix, RoleAuthority);
+    put_role(b, ix, RoleNewAuthority);
+    put_role(b, ix, RoleAuthority);
+    put_u8(ix, random_below(b, 101));
+}
+
+static void vote_authorize(Builder* b, enum VoteAuthorize authorize) {
+    GeneratedInstruction* ix = begin(b, &vote_program_id);
+    role(b, ix, RoleVote, KEY_WRITABLE);
+    account(ix, &SYSVAR_CLOCK_ID, 0);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, VoteAuthorize);
+    put_role(b, ix, RoleNewAuthority);
+    put_u32(ix, authorize);
+}
+
+static void vote_authorize_checked(Builder* b, enum VoteAuthorize authorize) {
+    GeneratedInstruction* ix = begin(b, &vote_program_id);
+    role(b, ix, RoleVote, KEY_WRITABLE);
+    account(ix, &SYSVAR_CLOCK_ID, 0);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    role(b, ix, RoleNewAuthority, KEY_SIGNER);
+    put_kind_u32(ix, VoteAuthorizeChecked);
+    put_u32(ix, authorize);
+}
+
+static void vote_withdraw(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &vote_program_id);
+    role(b, ix, RoleVote, KEY_WRITABLE);
+    role(b, ix, RoleDestination, KEY_WRITABLE);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, VoteWithdraw);
+    put_u64(ix, random_lamports(b));
+}
+
+static void vote_update_commission(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &vote_program_id);
+    role(b, ix, RoleVote, KEY_WRITABLE);
+    role(b, ix, RoleAuthority, KEY_SIGNER);
+    put_kind_u32(ix, VoteUpdateCommission);
+    put_u8(ix, random_below(b, 101));
+}
+
+// SPL token
+
+// The owner signs alone, or a multisig with its signers
+static void token_owner(Builder* b, GeneratedInstruction* ix) {
+    role(b, ix, RoleAuthority, random_chance(b, 80) ? KEY_SIGNER : 0);
+    if (ix->account_flags[ix->num_accounts - 1] == 0) {
+        const size_t num_signers = 1 + random_below(b, 3);
+        for (size_t i = 0; i < num_signers; i++) {
+            account(ix, &b->multisig_signers[i], KEY_SIGNER);
+        }
+    }
+}
+
+static void token_amount(Builder* b, GeneratedInstruction* ix) {
+    put_u64(ix, random_lamports(b));
+    put_u8(ix, random_below(b, 10));
+}
+
+static void token_initialize_mint(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &spl_token_program_id);
+    role(b, ix, RoleNewAccount, KEY_WRITABLE);
+    account(ix, &SYSVAR_RENT_ID, 0);
+    put_kind_u8(ix, SplTokenKind(InitializeMint));
+    put_u8(ix, random_below(b, 10));
+    put_role(b, ix, RoleAuthority);
+    if (random_chance(b, 50)) {
+        put_u8(ix, OptionSome);
+        put_role(b, ix, RoleNewAuthority);
+    } else {
+        put_u8(ix, OptionNone);
+    }
+}
+
+static void token_initialize_account(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &spl_token_program_id);
+    role(b, ix, RoleNewAccount, KEY_WRITABLE);
+    role(b, ix, RoleMint, 0);
+    role(b, ix, RoleAuthority, 0);
+    account(ix, &SYSVAR_RENT_ID, 0);
+    put_kind_u8(ix, SplTokenKind(InitializeAccount));
+}
+
+static void token_initialize_account2(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &spl_token_program_id);
+    role(b, ix, RoleNewAccount, KEY_WRITABLE);
+    role(b, ix, RoleMint, 0);
+    account(ix, &SYSVAR_RENT_ID, 0);
+    put_kind_u8(ix, SplTokenKind(InitializeAccount2));
+    put_role(b, ix, RoleAuthority);
+}
+
+static void token_initialize_multisig(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &spl_token_program_id);
+    role(b, ix, RoleNewAccount, KEY_WRITABLE);
+    account(ix, &SYSVAR_RENT_ID, 0);
+    const size_t num_signers = 1 + random_below(b, Token_MAX_SIGNERS);
+    for (size_t i = 0; i < num_signers; i++) {
+        account(ix, &b->multisig_signers[i], 0);
+    }
+    put_kind_u8(ix, SplTokenKind(InitializeMultisig));
+    put_u8(ix, 1 + random_below(b, num_signers));
+}
+
+static void token_transfer_checked(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &spl_token_program_id);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    role(b, ix, RoleMint, 0);
+    role(b, ix, RoleDestination, KEY_WRITABLE);
+    token_owner(b, ix);
+    put_kind_u8(ix, SplTokenKind(TransferChecked));
+    token_amount(b, ix);
+}
+
+static void token_approve_checked(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &spl_token_program_id);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    role(b, ix, RoleMint, 0);
+    role(b, ix, RoleNewAuthority, 0);
+    token_owner(b, ix);
+    put_kind_u8(ix, SplTokenKind(ApproveChecked));
+    token_amount(b, ix);
+}
+
+static void token_revoke(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &spl_token_program_id);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    token_owner(b, ix);
+    put_kind_u8(ix, SplTokenKind(Revoke));
+}
+
+static void token_set_authority(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &spl_token_program_id);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    token_owner(b, ix);
+    put_kind_u8(ix, SplTokenKind(SetAuthority));
+    put_u8(ix, random_below(b, 4));
+    if (random_chance(b, 80)) {
+        put_u8(ix, OptionSome);
+        put_role(b, ix, RoleNewAuthority);
+    } else {
+        put_u8(ix, OptionNone);
+    }
+}
+
+static void token_mint_to_checked(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &spl_token_program_id);
+    role(b, ix, RoleMint, KEY_WRITABLE);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    token_owner(b, ix);
+    put_kind_u8(ix, SplTokenKind(MintToChecked));
+    token_amount(b, ix);
+}
+
+static void token_burn_checked(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &spl_token_program_id);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    role(b, ix, RoleMint, KEY_WRITABLE);
+    token_owner(b, ix);
+    put_kind_u8(ix, SplTokenKind(BurnChecked));
+    token_amount(b, ix);
+}
+
+static void token_close_account(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &spl_token_program_id);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    role(b, ix, RoleDestination, KEY_WRITABLE);
+    token_owner(b, ix);
+    put_kind_u8(ix, SplTokenKind(CloseAccount));
+}
+
+static void token_freeze_or_thaw(Builder* b, uint8_t kind) {
+    GeneratedInstruction* ix = begin(b, &spl_token_program_id);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    role(b, ix, RoleMint, 0);
+    token_owner(b, ix);
+    put_kind_u8(ix, kind);
+}
+
+static void token_sync_native(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &spl_token_program_id);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    put_kind_u8(ix, SplTokenKind(SyncNative));
+}
+
+static void associated_token_account_create(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &spl_associated_token_account_program_id);
+    role(b, ix, RolePayer, KEY_SIGNER | KEY_WRITABLE);
+    role(b, ix, RoleAccount, KEY_WRITABLE);
+    role(b, ix, RoleAuthority, 0);
+    role(b, ix, RoleMint, 0);
+    account(ix, &system_program_id, 0);
+    account(ix, &spl_token_program_id, 0);
+    // The rent sysvar is optional
+    if (random_chance(b, 50)) {
+        account(ix, &SYSVAR_RENT_ID, 0);
+    }
+}
+
+// Compute budget
+
+static void compute_budget_unit_limit(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &compute_budget_program_id);
+    put_kind_u8(ix, ComputeBudgetChangeUnitLimit);
+    put_u32(ix, 1000 + random_below(b, 1400000));
+}
+
+static void compute_budget_unit_price(Builder* b) {
+    GeneratedInstruction* ix = begin(b, &compute_budget_program_id);
+    put_kind_u8(ix, ComputeBudgetChangeUnitPrice);
+    put_u64(ix, random_below(b, 100000));
+}
+
+//
+// Patterns, as print_transaction_nonce_processed() recognizes them
+//
+
+static void single_system_create_account(Builder* b) {
+    system_create_account(b, &system_program_id, true);
+}
+static void single_system_create_account_with_seed(Builder* b) {
+    system_create_account_with_seed(b, &system_program_id, true);
+}
+static void single_system_transfer(Builder* b) {
+    system_transfer(b, RoleDestination);
+}
+static void single_system_assign(Builder* b) {
+    system_assign(b, &stake_program_id);
+}
+static void single_system_allocate_with_seed(Builder* b) {
+    system_allocate_with_seed(b, &stake_program_id);
+}
+static void single_stake_initialize(Builder* b) {
+    stake_initialize(b, true);
+}
+static void single_stake_delegate(Builder* b) {
+    stake_delegate(b, RoleAccount);
+}
+static void single_stake_authorize(Builder* b) {
+    stake_authorize(b, random_below(b, 2));
+}
+static void single_stake_authorize_checked(Builder* b) {
+    stake_authorize_checked(b, random_below(b, 2));
+}
+static void single_vote_authorize(Builder* b) {
+    vote_authorize(b, random_below(b, 2));
+}
+static void single_vote_authorize_checked(Builder* b) {
+    vote_authorize_checked(b, random_below(b, 2));
+}
+static void single_token_freeze_account(Builder* b) {
+    token_freeze_or_thaw(b, SplTokenKind(FreezeAccount));
+}
+static void single_token_thaw_account(Builder* b) {
+    token_freeze_or_thaw(b, SplTokenKind(ThawAccount));
+}
+
+static void create_stake_account(Builder* b) {
+    system_create_account(b, &stake_program_id, true);
+    stake_initialize(b, true);
+}
+static void create_stake_account_checked(Builder* b) {
+    system_create_account(b, &stake_program_id, true);
+    stake_initialize_checked(b);
+}
+static void create_stake_account_with_seed(Builder* b) {
+    system_create_account_with_seed(b, &stake_program_id, true);
+    stake_initialize(b, true);
+}
+static void create_stake_account_with_seed_checked(Builder* b) {
+    system_create_account_with_seed(b, &stake_program_id, true);
+    stake_initialize_checked(b);
+}
+static void create_stake_account_and_delegate(Builder* b) {
+    create_stake_account(b);
+    stake_delegate(b, RoleNewAccount);
+}
+// The summary has no room left for a lockup in force
+static void create_stake_account_with_seed_and_delegate(Builder* b) {
+    system_create_account_with_seed(b, &stake_program_id, true);
+    stake_initialize(b, false);
+    stake_delegate(b, RoleNewAccount);
+}
+static void stake_split_v1_1(Builder* b) {
+    system_allocate(b);
+    system_assign(b, &stake_program_id);
+    stake_split(b);
+}
+static void stake_split_with_seed_v1_1(Builder* b) {
+    system_allocate_with_seed(b, &stake_program_id);
+    stake_split(b);
+}
+static void stake_split_v1_2(Builder* b) {
+    system_create_account(b, &stake_program_id, false);
+    stake_split(b);
+}
+static void stake_split_with_seed_v1_2(Builder* b) {
+    system_create_account_with_seed(b, &stake_program_id, false);
+    stake_split(b);
+}
+static void stake_split_v1_3(Builder* b) {
+    system_transfer(b, RoleNewAccount);
+    stake_split_v1_1(b);
+}
+static void stake_split_with_seed_v1_3(Builder* b) {
+    system_transfer(b, RoleNewAccount);
+    stake_split_with_seed_v1_1(b);
+}
+static void stake_authorize_both(Builder* b) {
+    stake_authorize(b, StakeAuthorizeStaker);
+    stake_authorize(b, StakeAuthorizeWithdrawer);
+}
+static void stake_authorize_checked_both(Builder* b) {
+    stake_authorize_checked(b, StakeAuthorizeStaker);
+    stake_authorize_checked(b, StakeAuthorizeWithdrawer);
+}
+static void create_nonce_account(Builder* b) {
+    system_create_account(b, &system_program_id, true);
+    system_initialize_nonce(b);
+}
+static void create_nonce_account_with_seed(Builder* b) {
+    system_create_account_with_seed(b, &system_program_id, true);
+    system_initialize_nonce(b);
+}
+static void create_vote_account(Builder* b) {
+    system_create_account(b, &vote_program_id, true);
+    vote_initialize(b);
+}
+static void create_vote_account_with_seed(Builder* b) {
+    system_create_account_with_seed(b, &vote_program_id, true);
+    vote_initialize(b);
+}
+static void vote_authorize_both(Builder* b) {
+    vote_authorize(b, VoteAuthorizeVoter);
+    vote_authorize(b, VoteAuthorizeWithdrawer);
+}
+static void vote_authorize_checked_both(Builder* b) {
+    vote_authorize_checked(b, VoteAuthorizeVoter);
+    vote_authorize_checked(b, VoteAuthorizeWithdrawer);
+}
+static void token_create_mint(Builder* b) {
+    system_create_account(b, &spl_token_program_id, true);
+    token_initialize_mint(b);
+}
+static void token_create_account(Builder* b) {
+    system_create_account(b, &spl_token_program_id, true);
+    token_initialize_account(b);
+}
+static void token_create_account2(Builder* b) {
+    system_create_account(b, &spl_token_program_id, true);
+    token_initialize_account2(b);
+}
+static void token_create_multisig(Builder* b) {
+    system_create_account(b, &spl_token_program_id, true);
+    token_initialize_multisig(b);
+}
+static void associated_token_account_create_with_transfer(Builder* b) {
+    associated_token_account_create(b);
+    token_transfer_checked(b);
+}
+
+typedef struct Pattern {
+    const char* name;
+    size_t num_instructions;
+    void (*emit)(Builder* b);
+} Pattern;
+
+static const Pattern PATTERNS[] = {
+    {"system_create_account", 1, single_system_create_account},
+    {"system_create_account_with_seed", 1, single_system_create_account_with_seed},
+    {"system_transfer", 1, single_system_transfer},
+    {"system_assign", 1, single_system_assign},
+    {"system_allocate", 1, system_allocate},
+    {"system_allocate_with_seed", 1, single_system_allocate_with_seed},
+    {"system_advance_nonce", 1, system_advance_nonce},
+    {"system_initialize_nonce", 1, system_initialize_nonce},
+    {"system_withdraw_nonce", 1, system_withdraw_nonce},
+    {"system_authorize_nonce", 1, system_authorize_nonce},
+    {"stake_initialize", 1, single_stake_initialize},
+    {"stake_initialize_checked", 1, stake_initialize_checked},
+    {"stake_delegate", 1, single_stake_delegate},
+    {"stake_split", 1, stake_split},
+    {"stake_withdraw", 1, stake_withdraw},
+    {"stake_authorize", 1, single_stake_authorize},
+    {"stake_authorize_checked", 1, single_stake_authorize_checked},
+    {"stake_deactivate", 1, stake_deactivate},
+    {"stake_merge", 1, stake_merge},
+    {"stake_set_lockup", 1, stake_set_lockup},
+    {"vote_initialize", 1, vote_initialize},
+    {"vote_authorize", 1, single_vote_authorize},
+    {"vote_authorize_checked", 1, single_vote_authorize_checked},
+    {"vote_withdraw", 1, vote_withdraw},
+    {"vote_update_commission", 1, vote_update_commission},
+    {"spl_token_initialize_mint", 1, token_initialize_mint},
+    {"spl_token_initialize_account", 1, token_initialize_account},
+    {"spl_token_initialize_account2", 1, token_initialize_account2},
+    {"spl_token_initialize_multisig", 1, token_initialize_multisig},
+    {"spl_token_transfer_checked", 1, token_transfer_checked},
+    {"spl_token_approve_checked", 1, token_approve_checked},
+    {"spl_token_revoke", 1, token_revoke},
+    {"spl_token_set_authority", 1, token_set_authority},
+    {"spl_token_mint_to_checked", 1, token_mint_to_checked},
+    {"spl_token_burn_checked", 1, token_burn_checked},
+    {"spl_token_close_account", 1, token_close_account},
+    {"spl_token_freeze_account", 1, single_token_freeze_account},
+    {"spl_token_thaw_account", 1, single_token_thaw_account},
+    {"spl_token_sync_native", 1, token_sync_native},
+    {"spl_associated_token_account_create", 1, associated_token_account_create},
+    {"create_stake_account", 2, create_stake_account},
+    {"create_stake_account_checked", 2, create_stake_account_checked},
+    {"create_stake_account_with_seed", 2, create_stake_account_with_seed},
+    {"create_stake_account_with_seed_checked", 2, create_stake_account_with_seed_checked},
+    {"create_stake_account_and_delegate", 3, create_stake_account_and_delegate},
+    {"create_stake_account_with_seed_and_delegate",
+     3,
+     create_stake_account_with_seed_and_delegate},
+    {"stake_split_v1_1", 3, stake_split_v1_1},
+    {"stake_split_with_seed_v1_1", 2, stake_split_with_seed_v1_1},
+    {"stake_split_v1_2", 2, stake_split_v1_2},
+    {"stake_split_with_seed_v1_2", 2, stake_split_with_seed_v1_2},
+    {"stake_split_v1_3", 4, stake_split_v1_3},
+    {"stake_split_with_seed_v1_3", 3, stake_split_with_seed_v1_3},
+    {"stake_authorize_both", 2, stake_authorize_both},
+    {"stake_authorize_checked_both", 2, stake_authorize_checked_both},
+    {"create_nonce_account", 2, create_nonce_account},
+    {"create_nonce_account_with_seed", 2, create_nonce_account_with_seed},
+    {"create_vote_account", 2, create_vote_account},
+    {"create_vote_account_with_seed", 2, create_vote_account_with_seed},
+    {"vote_authorize_both", 2, vote_authorize_both},
+    {"vote_authorize_checked_both", 2, vote_authorize_checked_both},
+    {"spl_token_create_mint", 2, token_create_mint},
+    {"spl_token_create_account", 2, token_create_account},
+    {"spl_token_create_account2", 2, token_create_account2},
+    {"spl_token_create_multisig", 2, token_create_multisig},
+    {"spl_associated_token_account_create_with_transfer",
+     2,
+     associated_token_account_create_with_transfer},
+};
+
+size_t message_generator_pattern_count(void) {
+    return ARRAY_LEN(PATTERNS);
+}
+
+const char* message_generator_pattern_name(size_t pattern) {
+    return pattern < ARRAY_LEN(PATTERNS) ? PATTERNS[pattern].name : NULL;
+}
+
+//
+// Encoding
+//
+
+typedef struct Writer {
+    uint8_t* buffer;
+    size_t size;
+    size_t length;
+} Writer;
+
+static int write_bytes(Writer* w, const void* bytes, size_t length) {
+    BAIL_IF(length > w->size - w->length);
+    memcpy(w->buffer + w->length, bytes, length);
+    w->length += length;
+    return 0;
+}
+
+static int write_u8(Writer* w, uint8_t value) {
+    return write_bytes(w, &value, 1);
+}
+
+// compact-u16, as read by parse_length()
+static int write_length(Writer* w, size_t value) {
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        if (value) {
+            byte |= 0x80;
+        }
+        BAIL_IF(write_u8(w, byte));
+    } while (value);
+    return 0;
+}
+
+typedef struct AccountTable {
+    const Pubkey* keys[MAX_KEYS];
+    uint8_t flags[MAX_KEYS];
+    size_t num_keys;
+} AccountTable;
+
+static int table_add(AccountTable* table, const Pubkey* key, uint8_t flags) {
+    for (size_t i = 0; i < table->num_keys; i++) {
+        if (memcmp(table->keys[i], key, PUBKEY_SIZE) == 0) {
+            table->flags[i] |= flags;
+            return 0;
+        }
+    }
+    BAIL_IF(table->num_keys == MAX_KEYS);
+    table->keys[table->num_keys] = key;
+    table->flags[table->num_keys] = flags;
+    table->num_keys++;
+    return 0;
+}
+
+static int table_index(const AccountTable* table, const Pubkey* key) {
+    for (size_t i = 0; i < table->num_keys; i++) {
+        if (memcmp(table->keys[i], key, PUBKEY_SIZE) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Signers then the others, writable ones first, the fee payer leading. Keys
+// are shuffled within each group.
+static void table_order(Builder* b, AccountTable* table, uint8_t header[3]) {
+    static const uint8_t GROUPS[] = {
+        KEY_SIGNER | KEY_WRITABLE,
+        KEY_SIGNER,
+        KEY_WRITABLE,
+        0,
+    };
+    AccountTable ordered = {.num_keys = 1};
+    ordered.keys[0] = table->keys[0];
+    ordered.flags[0] = table->flags[0];
+    memset(header, 0, 3);
+    header[0] = 1;
+    for (size_t g = 0; g < ARRAY_LEN(GROUPS); g++) {
+        const size_t start = ordered.num_keys;
+        for (size_t i = 1; i < table->num_keys; i++) {
+            if (table->flags[i] == GROUPS[g]) {
+                ordered.keys[ordered.num_keys] = table->keys[i];
+                ordered.flags[ordered.num_keys] = table->flags[i];
+                ordered.num_keys++;
+            }
+        }
+        const size_t count = ordered.num_keys - start;
+        for (size_t i = count; i > 1; i--) {
+            const size_t j = random_below(b, i);
+            const Pubkey* key = ordered.keys[start + i - 1];
+            ordered.keys[start + i - 1] = ordered.keys[start + j];
+            ordered.keys[start + j] = key;
+        }
+        if (GROUPS[g] & KEY_SIGNER) {
+            header[0] += count;
+        }
+        if (GROUPS[g] == KEY_SIGNER) {
+            header[1] = count;
+        }
+        if (GROUPS[g] == 0) {
+            header[2] = count;
+        }
+    }
+    *table = ordered;
+}
+
+static int encode(Builder* b, bool versioned, Writer* w) {
+    AccountTable table = {0};
+    BAIL_IF(table_add(&table, &b->roles[RolePayer], KEY_SIGNER | KEY_WRITABLE));
+    for (size_t i = 0; i < b->num_instructions; i++) {
+        const GeneratedInstruction* ix = &b->instructions[i];
+        for (size_t j = 0; j < ix->num_accounts; j++) {
+            BAIL_IF(table_add(&table, ix->accounts[j], ix->account_flags[j]));
+        }
+    }
+    // Programs are read-only, whatever else refers to them
+    for (size_t i = 0; i < b->num_instructions; i++) {
+        BAIL_IF(table_add(&table, b->instructions[i].program_id, 0));
+        const int index = table_index(&table, b->instructions[i].program_id);
+        table.flags[index] &= ~KEY_WRITABLE;
+    }
+    uint8_t header[3];
+    table_order(b, &table, header);
+
+    if (versioned) {
+        BAIL_IF(write_u8(w, 0x80));
+    }
+    BAIL_IF(write_bytes(w, header, sizeof(header)));
+    BAIL_IF(write_length(w, table.num_keys));
+    for (size_t i = 0; i < table.num_keys; i++) {
+        BAIL_IF(write_bytes(w, table.keys[i]->data, PUBKEY_SIZE));
+    }
+    Hash blockhash;
+    random_pubkey(b->generator, (Pubkey*) &blockhash);
+    BAIL_IF(write_bytes(w, blockhash.data, HASH_SIZE));
+
+    BAIL_IF(write_length(w, b->num_instructions));
+    for (size_t i = 0; i < b->num_instructions; i++) {
+        const GeneratedInstruction* ix = &b->instructions[i];
+        BAIL_IF(write_u8(w, table_index(&table, ix->program_id)));
+        BAIL_IF(write_length(w, ix->num_accounts));
+        for (size_t j = 0; j < ix->num_accounts; j++) {
+            const bool bad = ix->bad_account_index && j == 0;
+            const int index = bad ? (int) table.num_keys : table_index(&table, ix->accounts[j]);
+            BAIL_IF(write_u8(w, index));
+        }
+        BAIL_IF(write_length(w, ix->data_length));
+        BAIL_IF(write_bytes(w, ix->data, ix->data_length));
+    }
+    if (versioned) {
+        // No address table lookups
+        BAIL_IF(write_length(w, 0));
+    }
+    return 0;
+}
+
+//
+// Generation
+//
+
+typedef enum NearMiss {
+    NearMissInvalidKind = 0,
+    NearMissBadAccountIndex,
+    NearMissTruncated,
+    NearMissTrailingByte,
+    NearMissSwappedInstructions,
+    NearMissCount,
+} NearMiss;
+
+void message_generator_init(MessageGenerator* generator,
+                            uint64_t seed,
+                            unsigned near_miss_percent,
+                            unsigned unknown_program_percent) {
+    // xorshift must not start from 0
+    generator->state = seed ? seed : 0x9e3779b97f4a7c15ull;
+    generator->near_miss_percent = near_miss_percent;
+    generator->unknown_program_percent = unknown_program_percent;
+}
+
+int message_generator_next(MessageGenerator* generator, GeneratedMessage* message) {
+    Builder b;
+    memset(&b, 0, sizeof(b));
+    b.generator = generator;
+    for (size_t i = 0; i < RoleCount; i++) {
+        random_pubkey(generator, &b.roles[i]);
+    }
+    for (size_t i = 0; i < Token_MAX_SIGNERS; i++) {
+        random_pubkey(generator, &b.multisig_signers[i]);
+    }
+    // The fee payer often is the authority, and sometimes the recipient
+    if (random_chance(&b, 50)) {
+        b.roles[RoleAuthority] = b.roles[RolePayer];
+    }
+    if (random_chance(&b, 10)) {
+        b.roles[RoleDestination] = b.roles[RolePayer];
+    }
+
+    memset(message, 0, sizeof(*message));
+    message->pattern = random_below(&b, ARRAY_LEN(PATTERNS));
+    const Pattern* pattern = &PATTERNS[message->pattern];
+
+    const unsigned roll = random_below(&b, 100);
+    if (roll < generator->near_miss_percent) {
+        message->kind = GeneratedMessageNearMiss;
+    } else if (roll < generator->near_miss_percent + generator->unknown_program_percent) {
+        message->kind = GeneratedMessageUnknownProgram;
+    } else {
+        message->kind = GeneratedMessageValid;
+    }
+
+    // Wrappers, as room allows
+    size_t room = MAX_INSTRUCTIONS - pattern->num_instructions;
+    if (room > 0 && random_chance(&b, 25)) {
+        system_advance_nonce(&b);
+        message->nonced = true;
+        room--;
+    }
+    const size_t max_compute_budget = MIN(room, 2);
+    message->num_compute_budget_instructions = random_below(&b, max_compute_budget + 1);
+    if (message->num_compute_budget_instructions == 2) {
+        compute_budget_unit_limit(&b);
+        compute_budget_unit_price(&b);
+    } else if (message->num_compute_budget_instructions == 1) {
+        if (random_chance(&b, 50)) {
+            compute_budget_unit_limit(&b);
+        } else {
+            compute_budget_unit_price(&b);
+        }
+    }
+    const size_t first = b.num_instructions;
+    pattern->emit(&b);
+    GeneratedInstruction* last = &b.instructions[b.num_instructions - 1];
+    message->versioned = random_chance(&b, 50);
+
+    NearMiss near_miss = NearMissCount;
+    if (message->kind == GeneratedMessageNearMiss) {
+        near_miss = random_below(&b, NearMissCount);
+        if (near_miss == NearMissInvalidKind && last->kind_length == 0) {
+            near_miss = NearMissTruncated;
+        }
+        if (near_miss == NearMissSwappedInstructions && pattern->num_instructions < 2) {
+            near_miss = NearMissTrailingByte;
+        }
+        switch (near_miss) {
+            case NearMissInvalidKind:
+                memset(last->data, 0xff, last->kind_length);
+                break;
+            case NearMissBadAccountIndex:
+                last->bad_account_index = true;
+                break;
+            case NearMissSwappedInstructions: {
+                const GeneratedInstruction swapped = b.instructions[first];
+                b.instructions[first] = b.instructions[first + 1];
+                b.instructions[first + 1] = swapped;
+                break;
+            }
+            default:
+                break;
+        }
+    } else if (message->kind == GeneratedMessageUnknownProgram) {
+        b.instructions[first + random_below(&b, pattern->num_instructions)].program_id =
+            &b.roles[RoleUnknownProgram];
+    }
+
+    Writer w = {message->data, sizeof(message->data), 0};
+    BAIL_IF(encode(&b, message->versioned, &w));
+    if (near_miss == NearMissTruncated) {
+        w.length--;
+    } else if (near_miss == NearMissTrailingByte) {
+        BAIL_IF(write_u8(&w, random_below(&b, 256)));
+    }
+    message->length = w.length;
+    return 0;
+}
+
+//
+// Streams
+//
+
+int message_stream_write(FILE* file, const uint8_t* message, size_t length) {
+    BAIL_IF(length > UINT32_MAX);
+    const uint8_t prefix[4] = {length, length >> 8, length >> 16, length >> 24};
+    BAIL_IF(fwrite(prefix, 1, sizeof(prefix), file) != sizeof(prefix));
+    BAIL_IF(fwrite(message, 1, length, file) != length);
+    return 0;
+}
+
+int message_stream_read(FILE* file, uint8_t* buffer, size_t buffer_size, size_t* length) {
+    uint8_t prefix[4];
+    BAIL_IF(fread(prefix, 1, sizeof(prefix), file) != sizeof(prefix));
+    const uint32_t value =
+        prefix[0] | prefix[1] << 8 | prefix[2] << 16 | (uint32_t) prefix[3] << 24;
+    BAIL_IF(value > buffer_size);
+    BAIL_IF(fread(buffer, 1, value, file) != value);
+    *length = value;
+    return 0;
+}
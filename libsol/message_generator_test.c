@@ -0,0 +1,138 @@
+#include "sol/message.h"
+#include "sol/message_generator.h"
+#include "sol/print_config.h"
+#include "sol/transaction_summary.h"
+#include "util.h"
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#define NUM_MESSAGES 20000
+
+static int review(const GeneratedMessage* message) {
+    Parser parser = {message->data, message->length};
+    PrintConfig print_config;
+    MessageHeader* header = &print_config.header;
+    print_config.expert_mode = true;
+    print_config.signer_pubkeys = NULL;
+    print_config.num_signer_pubkeys = 0;
+
+    BAIL_IF(parse_message_header(&parser, header));
+    transaction_summary_reset();
+    BAIL_IF(process_message_body(parser.buffer, parser.buffer_length, &print_config));
+    transaction_summary_set_fee_payer_pubkey(&header->pubkeys[0]);
+
+    enum SummaryItemKind kinds[MAX_TRANSACTION_SUMMARY_ITEMS];
+    size_t num_items = 0;
+    BAIL_IF(transaction_summary_finalize(kinds, &num_items));
+    for (size_t i = 0; i < num_items; i++) {
+        BAIL_IF(transaction_summary_display_item(i, DisplayFlagNone));
+    }
+    return 0;
+}
+
+void test_message_generator_patterns() {
+    const size_t count = message_generator_pattern_count();
+    assert(count > 0);
+    for (size_t i = 0; i < count; i++) {
+        assert(message_generator_pattern_name(i) != NULL);
+    }
+    assert(message_generator_pattern_name(count) == NULL);
+}
+
+void test_message_generator_covers_every_pattern() {
+    MessageGenerator generator;
+    message_generator_init(&generator, 1, 10, 10);
+    const size_t count = message_generator_pattern_count();
+    size_t num_valid[128] = {0};
+    size_t num_kinds[3] = {0};
+    size_t num_nonced = 0, num_versioned = 0, num_compute_budget = 0;
+    assert(count <= ARRAY_LEN(num_valid));
+
+    GeneratedMessage message;
+    for (size_t i = 0; i < NUM_MESSAGES; i++) {
+        assert(message_generator_next(&generator, &message) == 0);
+        assert(message.pattern < count);
+        const int result = review(&message);
+        if (message.kind == GeneratedMessageValid) {
+            if (result != 0) {
+                printf("%zu: %s refused\n", i, message_generator_pattern_name(message.pattern));
+            }
+            assert(result == 0);
+            num_valid[message.pattern]++;
+        } else {
+            assert(result != 0);
+        }
+        num_kinds[message.kind]++;
+        num_nonced += message.nonced;
+        num_versioned += message.versioned;
+        num_compute_budget += message.num_compute_budget_instructions > 0;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        assert(num_valid[i] > 0);
+    }
+    assert(num_kinds[GeneratedMessageNearMiss] > 0);
+    assert(num_kinds[GeneratedMessageUnknownProgram] > 0);
+    assert(num_nonced > 0 && num_versioned > 0 && num_compute_budget > 0);
+}
+
+void test_message_generator_is_deterministic() {
+    MessageGenerator a, b;
+    message_generator_init(&a, 42, 20, 5);
+    message_generator_init(&b, 42, 20, 5);
+    GeneratedMessage message_a, message_b;
+    for (size_t i = 0; i < 100; i++) {
+        assert(message_generator_next(&a, &message_a) == 0);
+        assert(message_generator_next(&b, &message_b) == 0);
+        assert(message_a.length == message_b.length);
+        assert(memcmp(message_a.data, message_b.data, message_a.length) == 0);
+    }
+
+    message_generator_init(&b, 43, 20, 5);
+    assert(message_generator_next(&b, &message_b) == 0);
+    assert(message_a.length != message_b.length ||
+           memcmp(message_a.data, message_b.data, message_a.length) != 0);
+}
+
+void test_message_stream() {
+    FILE* file = tmpfile();
+    assert(file != NULL);
+    const uint8_t first[] = {1, 2, 3};
+    const uint8_t second[] = {4};
+    assert(message_stream_write(file, first, sizeof(first)) == 0);
+    assert(message_stream_write(file, second, sizeof(second)) == 0);
+    assert(message_stream_write(file, second, 0) == 0);
+    rewind(file);
+
+    uint8_t buffer[4];
+    size_t length = 0;
+    assert(message_stream_read(file, buffer, sizeof(buffer), &length) == 0);
+    assert(length == sizeof(first) && memcmp(buffer, first, length) == 0);
+    // does not fit
+    assert(message_stream_read(file, buffer, 0, &length) == 1);
+    fclose(file);
+
+    file = tmpfile();
+    assert(file != NULL);
+    assert(message_stream_write(file, second, sizeof(second)) == 0);
+    assert(message_stream_write(file, first, sizeof(first)) == 0);
+    rewind(file);
+    assert(message_stream_read(file, buffer, sizeof(buffer), &length) == 0);
+    assert(length == sizeof(second) && buffer[0] == 4);
+    assert(message_stream_read(file, buffer, sizeof(buffer), &length) == 0);
+    assert(length == sizeof(first));
+    // end of stream
+    assert(message_stream_read(file, buffer, sizeof(buffer), &length) == 1);
+    fclose(file);
+}
+
+int main() {
+    test_message_generator_patterns();
+    test_message_generator_covers_every_pattern();
+    test_message_generator_is_deterministic();
+    test_message_stream();
+
+    printf("passed\n");
+    return 0;
+}
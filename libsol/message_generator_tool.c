@@ -0,0 +1,99 @@
+#include "sol/message.h"
+#include "sol/message_generator.h"
+#include "sol/print_config.h"
+#include "sol/transaction_summary.h"
+#include "util.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Writes a stream of synthetic messages, for benchmarks and replay tools:
+//
+//   message_generator_tool <count> <seed> <stream> [near miss %] [unknown program %]
+//
+// Every message is checked against libsol on the way, valid ones must be
+// accepted and the others refused.
+#define DEFAULT_NEAR_MISS_PERCENT       5
+#define DEFAULT_UNKNOWN_PROGRAM_PERCENT 5
+
+static int review(const GeneratedMessage* message) {
+    Parser parser = {message->data, message->length};
+    PrintConfig print_config;
+    MessageHeader* header = &print_config.header;
+    print_config.expert_mode = true;
+    print_config.signer_pubkeys = NULL;
+    print_config.num_signer_pubkeys = 0;
+
+    BAIL_IF(parse_message_header(&parser, header));
+    transaction_summary_reset();
+    BAIL_IF(process_message_body(parser.buffer, parser.buffer_length, &print_config));
+    transaction_summary_set_fee_payer_pubkey(&header->pubkeys[0]);
+
+    enum SummaryItemKind kinds[MAX_TRANSACTION_SUMMARY_ITEMS];
+    size_t num_items = 0;
+    return transaction_summary_finalize(kinds, &num_items);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 4 || argc > 6) {
+        printf("usage: %s <count> <seed> <stream> [near miss %%] [unknown program %%]\n", argv[0]);
+        return 1;
+    }
+    const unsigned long long count = strtoull(argv[1], NULL, 0);
+    const unsigned long long seed = strtoull(argv[2], NULL, 0);
+    const unsigned near_miss_percent =
+        argc > 4 ? strtoul(argv[4], NULL, 0) : DEFAULT_NEAR_MISS_PERCENT;
+    const unsigned unknown_program_percent =
+        argc > 5 ? strtoul(argv[5], NULL, 0) : DEFAULT_UNKNOWN_PROGRAM_PERCENT;
+    if (near_miss_percent + unknown_program_percent > 100) {
+        printf("near misses and unknown programs exceed 100%%\n");
+        return 1;
+    }
+
+    FILE* file = fopen(argv[3], "wb");
+    if (file == NULL) {
+        printf("cannot write %s\n", argv[3]);
+        return 1;
+    }
+
+    MessageGenerator generator;
+    message_generator_init(&generator, seed, near_miss_percent, unknown_program_percent);
+    const size_t num_patterns = message_generator_pattern_count();
+    unsigned long long num_kinds[3] = {0};
+    unsigned long long* num_per_pattern = calloc(num_patterns, sizeof(*num_per_pattern));
+    unsigned long long num_bytes = 0, num_mismatches = 0;
+
+    GeneratedMessage message;
+    for (unsigned long long i = 0; i < count; i++) {
+        if (message_generator_next(&generator, &message) != 0 ||
+            message_stream_write(file, message.data, message.length) != 0) {
+            printf("message %llu: cannot generate or write\n", i);
+            fclose(file);
+            free(num_per_pattern);
+            return 1;
+        }
+        const bool accepted = review(&message) == 0;
+        if (accepted != (message.kind == GeneratedMessageValid)) {
+            printf("message %llu: %s %s\n",
+                   i,
+                   message_generator_pattern_name(message.pattern),
+                   accepted ? "accepted" : "refused");
+            num_mismatches++;
+        }
+        num_kinds[message.kind]++;
+        num_per_pattern[message.pattern]++;
+        num_bytes += message.length;
+    }
+    fclose(file);
+
+    printf("%llu messages, %llu bytes: %llu valid, %llu near misses, %llu unknown programs\n",
+           count,
+           num_bytes,
+           num_kinds[GeneratedMessageValid],
+           num_kinds[GeneratedMessageNearMiss],
+           num_kinds[GeneratedMessageUnknownProgram]);
+    for (size_t i = 0; i < num_patterns; i++) {
+        printf("%-50s %llu\n", message_generator_pattern_name(i), num_per_pattern[i]);
+    }
+    free(num_per_pattern);
+    return num_mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,42 @@
+#include "sol/message_pager.h"
+#include "util.h"
+
+int message_pager_init(MessagePager* pager,
+                       const uint8_t* text,
+                       size_t length,
+                       size_t page_length) {
+    BAIL_IF(pager == NULL || text == NULL);
+    BAIL_IF(page_length == 0 || length > UINT16_MAX);
+    explicit_bzero(pager, sizeof(*pager));
+    pager->text = text;
+
+    size_t start = 0;
+    size_t count = 0;
+    while (start < length) {
+        BAIL_IF(count == MESSAGE_PAGER_MAX_PAGES);
+        size_t end = length;
+        if (length - start > page_length) {
+            end = start + page_length;
+            const size_t min_end = start + page_length - page_length / 4;
+            for (size_t i = end; i > min_end; i--) {
+                if (text[i - 1] == ' ') {
+                    end = i;
+                    break;
+                }
+            }
+        }
+        pager->offsets[count++] = start;
+        start = end;
+    }
+    pager->offsets[count] = length;
+    pager->page_count = count;
+    return 0;
+}
+
+size_t message_pager_get_page(const MessagePager* pager, size_t index, const uint8_t** page) {
+    if (index >= pager->page_count) {
+        return 0;
+    }
+    *page = pager->text + pager->offsets[index];
+    return pager->offsets[index + 1] - pager->offsets[index];
+}
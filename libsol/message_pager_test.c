@@ -0,0 +1,99 @@
+#include "sol/message_pager.h"
+#include "util.h"
+#include <assert.h>
+#include <stdio.h>
+
+#define MESSAGE_LENGTH 1212
+
+static void assert_pages_cover(const MessagePager* pager,
+                               const uint8_t* text,
+                               size_t length,
+                               size_t page_length) {
+    size_t covered = 0;
+    for (size_t i = 0; i < pager->page_count; i++) {
+        const uint8_t* page = NULL;
+        const size_t page_size = message_pager_get_page(pager, i, &page);
+        assert(page == text + covered);
+        assert(page_size > 0);
+        assert(page_size <= page_length);
+        if (i + 1 < pager->page_count) {
+            assert(page_size >= page_length - page_length / 4);
+        }
+        covered += page_size;
+    }
+    assert(covered == length);
+}
+
+void test_message_pager_single_page() {
+    const uint8_t text[] = "Sign in to example.com";
+    MessagePager pager;
+    assert(message_pager_init(&pager, text, sizeof(text) - 1, 64) == 0);
+    assert(pager.page_count == 1);
+
+    const uint8_t* page = NULL;
+    assert(message_pager_get_page(&pager, 0, &page) == sizeof(text) - 1);
+    assert(page == text);
+    assert(message_pager_get_page(&pager, 1, &page) == 0);
+}
+
+void test_message_pager_empty() {
+    const uint8_t text[] = "";
+    MessagePager pager;
+    assert(message_pager_init(&pager, text, 0, 64) == 0);
+    assert(pager.page_count == 0);
+}
+
+void test_message_pager_breaks_after_space() {
+    const uint8_t text[] = "aaaaaaaaaaaaaaa bbbbb";
+    MessagePager pager;
+    assert(message_pager_init(&pager, text, sizeof(text) - 1, 18) == 0);
+    assert(pager.page_count == 2);
+
+    const uint8_t* page = NULL;
+    assert(message_pager_get_page(&pager, 0, &page) == 16);
+    assert(message_pager_get_page(&pager, 1, &page) == 5);
+    assert(memcmp(page, "bbbbb", 5) == 0);
+}
+
+void test_message_pager_hard_cut_without_space() {
+    uint8_t text[MESSAGE_LENGTH];
+    memset(text, 'x', sizeof(text));
+    MessagePager pager;
+    assert(message_pager_init(&pager, text, sizeof(text), 100) == 0);
+    assert(pager.page_count == 13);
+    assert_pages_cover(&pager, text, sizeof(text), 100);
+}
+
+void test_message_pager_long_text() {
+    uint8_t text[MESSAGE_LENGTH];
+    const char* words = "Sign this message to prove ownership of your wallet ";
+    for (size_t i = 0; i < sizeof(text); i++) {
+        text[i] = words[i % strlen(words)];
+    }
+    const size_t page_lengths[] = {40, 48, 64, 100, 128, 200};
+    for (size_t i = 0; i < ARRAY_LEN(page_lengths); i++) {
+        MessagePager pager;
+        assert(message_pager_init(&pager, text, sizeof(text), page_lengths[i]) == 0);
+        assert_pages_cover(&pager, text, sizeof(text), page_lengths[i]);
+    }
+}
+
+void test_message_pager_too_many_pages() {
+    uint8_t text[MESSAGE_LENGTH];
+    memset(text, 'x', sizeof(text));
+    MessagePager pager;
+    assert(message_pager_init(&pager, text, sizeof(text), 16) != 0);
+    assert(message_pager_init(&pager, text, sizeof(text), 2) != 0);
+}
+
+int main() {
+    test_message_pager_single_page();
+    test_message_pager_empty();
+    test_message_pager_breaks_after_space();
+    test_message_pager_hard_cut_without_space();
+    test_message_pager_long_text();
+    test_message_pager_too_many_pages();
+
+    printf("passed\n");
+    return 0;
+}
@@ -10,6 +10,7 @@ static int check_buffer_length(Parser* parser, size_t num) {
 }
 
 static void advance(Parser* parser, size_t num) {
+    LIBSOL_STATS_ADD(parser_bytes, num);
     parser->buffer += num;
     parser->buffer_length -= num;
 }
@@ -2,5 +2,13 @@
 #include "util.h"
 
 bool print_config_show_authority(const PrintConfig* print_config, const Pubkey* authority) {
-    return print_config->expert_mode || !pubkeys_equal(print_config->signer_pubkey, authority);
+    if (print_config->expert_mode) {
+        return true;
+    }
+    for (size_t i = 0; i < print_config->num_signer_pubkeys; i++) {
+        if (pubkeys_equal(&print_config->signer_pubkeys[i], authority)) {
+            return false;
+        }
+    }
+    return true;
 }
@@ -6,7 +6,9 @@
 void test_print_config_show_authority() {
     Pubkey signer = {{BYTES32_BS58_1}};
     Pubkey not_signer = {{BYTES32_BS58_2}};
-    PrintConfig print_config = {.expert_mode = false, .signer_pubkey = &signer};
+    PrintConfig print_config = {.expert_mode = false,
+                                .signer_pubkeys = &signer,
+                                .num_signer_pubkeys = 1};
 
     assert(!print_config_show_authority(&print_config, &signer));
     assert(print_config_show_authority(&print_config, &not_signer));
@@ -15,8 +17,21 @@ void test_print_config_show_authority() {
     assert(print_config_show_authority(&print_config, &not_signer));
 }
 
+void test_print_config_show_authority_multiple_signers() {
+    Pubkey signers[] = {{{BYTES32_BS58_1}}, {{BYTES32_BS58_2}}};
+    Pubkey not_signer = {{BYTES32_BS58_3}};
+    PrintConfig print_config = {.expert_mode = false,
+                                .signer_pubkeys = signers,
+                                .num_signer_pubkeys = ARRAY_LEN(signers)};
+
+    assert(!print_config_show_authority(&print_config, &signers[0]));
+    assert(!print_config_show_authority(&print_config, &signers[1]));
+    assert(print_config_show_authority(&print_config, &not_signer));
+}
+
 int main() {
     test_print_config_show_authority();
+    test_print_config_show_authority_multiple_signers();
 
     printf("passed\n");
     return 0;
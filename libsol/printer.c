@@ -13,6 +13,7 @@ int print_token_amount(uint64_t amount,
                        uint8_t decimals,
                        char *out,
                        const size_t out_length) {
+    LIBSOL_STATS_ADD(token_amount_prints, 1);
     BAIL_IF(out_length > INT_MAX);
     uint64_t dVal = amount;
     const int outlen = (int) out_length;
@@ -128,6 +129,8 @@ int encode_base58(const void *in, size_t length, char *out, size_t maxoutlen) {
     uint8_t j;
     size_t start_at;
     size_t zero_count = 0;
+    LIBSOL_STATS_ADD(base58_encodes, 1);
+    LIBSOL_STATS_ADD(base58_bytes, length);
     if (length > sizeof(tmp)) {
         return INVALID_PARAMETER;
     }
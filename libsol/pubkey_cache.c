@@ -0,0 +1,57 @@
+#include "sol/pubkey_cache.h"
+#include "lru_cache.h"
+#include "util.h"
+
+typedef struct PubkeyCacheEntry {
+    uint32_t path[PUBKEY_CACHE_MAX_PATH_LENGTH];
+    uint8_t path_length;
+    Pubkey pubkey;
+} PubkeyCacheEntry;
+
+typedef struct PubkeyCache {
+    PubkeyCacheEntry entries[PUBKEY_CACHE_ENTRIES];
+    uint32_t last_used[PUBKEY_CACHE_ENTRIES];
+    uint32_t clock;
+} PubkeyCache;
+
+typedef struct PubkeyCacheKey {
+    const uint32_t* path;
+    size_t path_length;
+} PubkeyCacheKey;
+
+static PubkeyCache G_pubkey_cache;
+
+static bool pubkey_cache_match(const void* entry, const void* key) {
+    const PubkeyCacheEntry* cached = entry;
+    const PubkeyCacheKey* path = key;
+    return cached->path_length == path->path_length &&
+           memcmp(cached->path, path->path, path->path_length * sizeof(uint32_t)) == 0;
+}
+
+void pubkey_cache_reset() {
+    const LruCache cache = LRU_CACHE(G_pubkey_cache, pubkey_cache_match);
+    lru_cache_reset(&cache);
+}
+
+int pubkey_cache_insert(const uint32_t* path, size_t path_length, const Pubkey* pubkey) {
+    BAIL_IF(path == NULL || pubkey == NULL);
+    BAIL_IF(path_length == 0 || path_length > PUBKEY_CACHE_MAX_PATH_LENGTH);
+
+    const LruCache cache = LRU_CACHE(G_pubkey_cache, pubkey_cache_match);
+    const PubkeyCacheKey key = {path, path_length};
+    PubkeyCacheEntry* entry = lru_cache_claim(&cache, &key);
+    memcpy(entry->path, path, path_length * sizeof(uint32_t));
+    entry->path_length = path_length;
+    memcpy(&entry->pubkey, pubkey, PUBKEY_SIZE);
+    return 0;
+}
+
+const Pubkey* pubkey_cache_lookup(const uint32_t* path, size_t path_length) {
+    if (path == NULL || path_length == 0 || path_length > PUBKEY_CACHE_MAX_PATH_LENGTH) {
+        return NULL;
+    }
+    const LruCache cache = LRU_CACHE(G_pubkey_cache, pubkey_cache_match);
+    const PubkeyCacheKey key = {path, path_length};
+    const PubkeyCacheEntry* entry = lru_cache_lookup(&cache, &key);
+    return entry == NULL ? NULL : &entry->pubkey;
+}
@@ -0,0 +1,58 @@
+#include "sol/pubkey_cache.h"
+#include "util.h"
+#include <assert.h>
+#include <stdio.h>
+
+static void make_pubkey(Pubkey* pubkey, uint8_t seed) {
+    for (size_t i = 0; i < PUBKEY_SIZE; i++) {
+        pubkey->data[i] = seed + i;
+    }
+}
+
+void test_pubkey_cache_insert_lookup() {
+    pubkey_cache_reset();
+    const uint32_t path[] = {0x8000002c, 0x800001f5, 0x80000000};
+    Pubkey pubkey;
+    make_pubkey(&pubkey, 1);
+
+    assert(pubkey_cache_lookup(path, ARRAY_LEN(path)) == NULL);
+    assert(pubkey_cache_insert(path, ARRAY_LEN(path), &pubkey) == 0);
+
+    const Pubkey* cached = pubkey_cache_lookup(path, ARRAY_LEN(path));
+    assert(cached != NULL);
+    assert_pubkey_equal(cached, &pubkey);
+}
+
+void test_pubkey_cache_matches_whole_path() {
+    pubkey_cache_reset();
+    const uint32_t path[] = {0x8000002c, 0x800001f5, 0x80000000, 0x80000000};
+    const uint32_t other_account[] = {0x8000002c, 0x800001f5, 0x80000001, 0x80000000};
+    Pubkey pubkey;
+    make_pubkey(&pubkey, 1);
+
+    assert(pubkey_cache_insert(path, ARRAY_LEN(path), &pubkey) == 0);
+    // a prefix or a sibling is a different key
+    assert(pubkey_cache_lookup(path, ARRAY_LEN(path) - 1) == NULL);
+    assert(pubkey_cache_lookup(other_account, ARRAY_LEN(other_account)) == NULL);
+}
+
+void test_pubkey_cache_rejects_invalid_paths() {
+    pubkey_cache_reset();
+    const uint32_t path[PUBKEY_CACHE_MAX_PATH_LENGTH + 1] = {0};
+    Pubkey pubkey;
+    make_pubkey(&pubkey, 1);
+
+    assert(pubkey_cache_insert(path, 0, &pubkey) != 0);
+    assert(pubkey_cache_insert(path, ARRAY_LEN(path), &pubkey) != 0);
+    assert(pubkey_cache_lookup(path, 0) == NULL);
+    assert(pubkey_cache_lookup(path, ARRAY_LEN(path)) == NULL);
+}
+
+int main() {
+    test_pubkey_cache_insert_lookup();
+    test_pubkey_cache_matches_whole_path();
+    test_pubkey_cache_rejects_invalid_paths();
+
+    printf("passed\n");
+    return 0;
+}
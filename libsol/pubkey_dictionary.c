@@ -0,0 +1,194 @@
+#include "common_byte_strings.h"
+#include "sol/pubkey_dictionary.h"
+#include "token_info.h"
+#include "token_registry.h"
+#include "util.h"
+
+// Order is part of the transfer encoding, only ever append
+static const Pubkey WELL_KNOWN_PUBKEYS[] = {
+    {{PROGRAM_ID_SYSTEM}},
+    {{PROGRAM_ID_STAKE}},
+    {{PROGRAM_ID_VOTE}},
+    {{PROGRAM_ID_SPL_TOKEN}},
+    {{PROGRAM_ID_SPL_TOKEN_2022}},
+    {{PROGRAM_ID_SPL_ASSOCIATED_TOKEN_ACCOUNT}},
+    {{PROGRAM_ID_SPL_MEMO}},
+    {{PROGRAM_ID_SPL_MEMO_V1}},
+    {{PROGRAM_ID_COMPUTE_BUDGET}},
+    {{PROGRAM_ID_ADDRESS_LOOKUP_TABLE}},
+    {{PROGRAM_ID_SERUM_ASSERT_OWNER}},
+    {{PROGRAM_ID_SERUM_ASSERT_OWNER_PHANTOM}},
+    {{STAKE_CONFIG}},
+    {{SYSVAR_RENT}},
+    {{SYSVAR_CLOCK}},
+    {{SYSVAR_STAKE_HISTORY}},
+    {{SYSVAR_RECENT_BLOCKHASHES}},
+    {{SYSVAR_SLOT_HASHES}},
+    {{SYSVAR_INSTRUCTIONS}},
+    {{SYSVAR_EPOCH_SCHEDULE}},
+};
+
+// Registry mints follow the well-known keys, in the order of
+// token_registry.txt rather than of the hash slots, so that appending a token
+// leaves the index of every other entry unchanged
+size_t pubkey_dictionary_size() {
+    return ARRAY_LEN(WELL_KNOWN_PUBKEYS) + TOKEN_REGISTRY_LENGTH;
+}
+
+const Pubkey* pubkey_dictionary_get(size_t index) {
+    if (index < ARRAY_LEN(WELL_KNOWN_PUBKEYS)) {
+        return &WELL_KNOWN_PUBKEYS[index];
+    }
+    index -= ARRAY_LEN(WELL_KNOWN_PUBKEYS);
+    if (index < TOKEN_REGISTRY_LENGTH) {
+        return &TOKEN_REGISTRY[TOKEN_REGISTRY_FILE_ORDER[index]].mint_address;
+    }
+    return NULL;
+}
+
+int pubkey_dictionary_find(const Pubkey* pubkey) {
+    const size_t size = pubkey_dictionary_size();
+    for (size_t i = 0; i < size; i++) {
+        if (pubkeys_equal(pubkey, pubkey_dictionary_get(i))) {
+            return (int) i;
+        }
+    }
+    return -1;
+}
+
+static int append(uint8_t* out,
+                  size_t out_size,
+                  size_t* out_length,
+                  const uint8_t* data,
+                  size_t data_length) {
+    BAIL_IF(data_length > out_size - *out_length);
+    memcpy(out + *out_length, data, data_length);
+    *out_length += data_length;
+    return 0;
+}
+
+static void next_key(MessageExpander* expander) {
+    expander->num_keys--;
+    expander->stage = expander->num_keys ? MessageExpanderKeyTag : MessageExpanderBody;
+}
+
+int message_expander_update(MessageExpander* expander,
+                            const uint8_t* in,
+                            size_t in_length,
+                            uint8_t* out,
+                            size_t out_size,
+                            size_t* out_length) {
+    *out_length = 0;
+    size_t i = 0;
+    while (i < in_length) {
+        const uint8_t byte = in[i];
+        switch (expander->stage) {
+            case MessageExpanderPrefix:
+                // A version prefix comes before the three header bytes
+                expander->remaining = (byte & 0x80) ? 3 : 2;
+                expander->stage = MessageExpanderHeader;
+                BAIL_IF(append(out, out_size, out_length, &byte, 1));
+                i++;
+                break;
+            case MessageExpanderHeader:
+                if (--expander->remaining == 0) {
+                    expander->stage = MessageExpanderKeyCount;
+                }
+                BAIL_IF(append(out, out_size, out_length, &byte, 1));
+                i++;
+                break;
+            case MessageExpanderKeyCount:
+                // compact-u16, as read by parse_length()
+                expander->num_keys |= (byte & 0x7f) << (7 * expander->key_count_bytes);
+                if (!(byte & 0x80) || ++expander->key_count_bytes == 3) {
+                    expander->stage =
+                        expander->num_keys ? MessageExpanderKeyTag : MessageExpanderBody;
+                }
+                BAIL_IF(append(out, out_size, out_length, &byte, 1));
+                i++;
+                break;
+            case MessageExpanderKeyTag:
+                i++;
+                if (byte == PUBKEY_DICTIONARY_LITERAL) {
+                    expander->remaining = PUBKEY_SIZE;
+                    expander->stage = MessageExpanderKeyLiteral;
+                } else if (byte < PUBKEY_DICTIONARY_LONG) {
+                    const Pubkey* pubkey = pubkey_dictionary_get(byte - 1);
+                    BAIL_IF(pubkey == NULL);
+                    BAIL_IF(append(out, out_size, out_length, pubkey->data, PUBKEY_SIZE));
+                    next_key(expander);
+                } else {
+                    expander->tag = byte;
+                    expander->stage = MessageExpanderKeyIndex;
+                }
+                break;
+            case MessageExpanderKeyIndex: {
+                i++;
+                const size_t high = expander->tag - PUBKEY_DICTIONARY_LONG;
+                const size_t index = PUBKEY_DICTIONARY_SHORT + (high << 8 | byte);
+                const Pubkey* pubkey = pubkey_dictionary_get(index);
+                BAIL_IF(pubkey == NULL);
+                BAIL_IF(append(out, out_size, out_length, pubkey->data, PUBKEY_SIZE));
+                next_key(expander);
+                break;
+            }
+            case MessageExpanderKeyLiteral: {
+                const size_t length = MIN(expander->remaining, in_length - i);
+                BAIL_IF(append(out, out_size, out_length, in + i, length));
+                i += length;
+                expander->remaining -= length;
+                if (expander->remaining == 0) {
+                    next_key(expander);
+                }
+                break;
+            }
+            case MessageExpanderBody:
+                BAIL_IF(append(out, out_size, out_length, in + i, in_length - i));
+                i = in_length;
+                break;
+            default:
+                return 1;
+        }
+    }
+    return 0;
+}
+
+int message_expander_finish(const MessageExpander* expander) {
+    BAIL_IF(expander->stage != MessageExpanderBody);
+    return 0;
+}
+
+int message_compress(const uint8_t* message,
+                     size_t message_length,
+                     uint8_t* out,
+                     size_t out_size,
+                     size_t* out_length) {
+    // A version prefix comes before the header
+    const size_t prefix_length = (message_length > 0 && (message[0] & 0x80)) ? 1 : 0;
+    Parser parser = {message + prefix_length, message_length - prefix_length};
+    PubkeysHeader pubkeys_header;
+    BAIL_IF(parse_pubkeys_header(&parser, &pubkeys_header));
+    BAIL_IF(pubkeys_header.pubkeys_length * PUBKEY_SIZE > parser.buffer_length);
+
+    *out_length = 0;
+    BAIL_IF(append(out, out_size, out_length, message, parser.buffer - message));
+    for (size_t i = 0; i < pubkeys_header.pubkeys_length; i++) {
+        const Pubkey* pubkey;
+        BAIL_IF(parse_pubkey(&parser, &pubkey));
+        const int index = pubkey_dictionary_find(pubkey);
+        if (index < 0) {
+            const uint8_t tag = PUBKEY_DICTIONARY_LITERAL;
+            BAIL_IF(append(out, out_size, out_length, &tag, 1));
+            BAIL_IF(append(out, out_size, out_length, pubkey->data, PUBKEY_SIZE));
+        } else if (index < PUBKEY_DICTIONARY_SHORT) {
+            const uint8_t tag = index + 1;
+            BAIL_IF(append(out, out_size, out_length, &tag, 1));
+        } else {
+            const size_t offset = index - PUBKEY_DICTIONARY_SHORT;
+            const uint8_t reference[] = {PUBKEY_DICTIONARY_LONG + (offset >> 8), offset & 0xff};
+            BAIL_IF(append(out, out_size, out_length, reference, sizeof(reference)));
+        }
+    }
+    BAIL_IF(append(out, out_size, out_length, parser.buffer, parser.buffer_length));
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include "bench.h"
+#include "sol/pubkey_dictionary.h"
+#include "util.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <string.h>
+
+// Messages of the fuzzing corpus, sent as is and compressed
+#define CORPUS_DIR         "../fuzzing/corpus"
+#define MAX_MESSAGE_LENGTH 1280
+#define ITERATIONS         10000
+
+// Modern APDUs carry 255 bytes, the first one also carries the number of
+// signers and a 4 level derivation path
+#define APDU_DATA_LENGTH 255
+#define SIGNER_LENGTH    (1 + 1 + 4 * 4)
+
+static size_t apdus_for(size_t message_length) {
+    const size_t length = SIGNER_LENGTH + message_length;
+    return (length + APDU_DATA_LENGTH - 1) / APDU_DATA_LENGTH;
+}
+
+static size_t read_file(const char* path, uint8_t* buffer, size_t buffer_size) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    const size_t length = fread(buffer, 1, buffer_size, file);
+    fclose(file);
+    return length;
+}
+
+int main() {
+    DIR* dir = opendir(CORPUS_DIR);
+    if (dir == NULL) {
+        printf("cannot open %s\n", CORPUS_DIR);
+        return 1;
+    }
+
+    size_t num_messages = 0;
+    size_t plain_bytes = 0, compressed_bytes = 0;
+    size_t plain_apdus = 0, compressed_apdus = 0;
+    uint64_t expand_ns = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", CORPUS_DIR, entry->d_name);
+
+        uint8_t message[MAX_MESSAGE_LENGTH];
+        uint8_t compressed[MAX_MESSAGE_LENGTH];
+        uint8_t expanded[MAX_MESSAGE_LENGTH];
+        const size_t message_length = read_file(path, message, sizeof(message));
+        size_t compressed_length = 0;
+        if (message_length == 0 || message_compress(message,
+                                                    message_length,
+                                                    compressed,
+                                                    sizeof(compressed),
+                                                    &compressed_length) != 0) {
+            // not a message, some corpus entries are meant to fail parsing
+            continue;
+        }
+
+        const uint64_t start = bench_now_ns();
+        for (size_t i = 0; i < ITERATIONS; i++) {
+            MessageExpander expander = {0};
+            size_t expanded_length = 0;
+            if (message_expander_update(&expander,
+                                        compressed,
+                                        compressed_length,
+                                        expanded,
+                                        sizeof(expanded),
+                                        &expanded_length) != 0 ||
+                message_expander_finish(&expander) != 0 || expanded_length != message_length) {
+                printf("%s: expansion failed\n", entry->d_name);
+                closedir(dir);
+                return 1;
+            }
+            bench_do_not_optimize(expanded);
+        }
+        expand_ns += bench_now_ns() - start;
+        if (memcmp(expanded, message, message_length) != 0) {
+            printf("%s: expansion differs\n", entry->d_name);
+            closedir(dir);
+            return 1;
+        }
+
+        num_messages++;
+        plain_bytes += message_length;
+        compressed_bytes += compressed_length;
+        plain_apdus += apdus_for(message_length);
+        compressed_apdus += apdus_for(compressed_length);
+        printf("%-50s %5zu -> %5zu bytes, %zu -> %zu APDUs\n",
+               entry->d_name,
+               message_length,
+               compressed_length,
+               apdus_for(message_length),
+               apdus_for(compressed_length));
+    }
+    closedir(dir);
+
+    if (num_messages == 0 || plain_bytes == 0) {
+        printf("no message in %s\n", CORPUS_DIR);
+        return 1;
+    }
+    printf("%zu messages: %zu -> %zu bytes (%zu%% saved), %zu -> %zu APDUs\n",
+           num_messages,
+           plain_bytes,
+           compressed_bytes,
+           100 * (plain_bytes - compressed_bytes) / plain_bytes,
+           plain_apdus,
+           compressed_apdus);
+    printf("expansion: %.1f ns per byte\n",
+           (double) expand_ns / ((double) plain_bytes * ITERATIONS));
+    return 0;
+}
@@ -0,0 +1,192 @@
+#include "common_byte_strings.h"
+#include "sol/pubkey_dictionary.h"
+#include "token_info.h"
+#include "token_registry.h"
+#include "util.h"
+#include <assert.h>
+#include <stdio.h>
+
+// Disable clang format for this file to keep clear buffer formatting
+/* clang-format off */
+
+// Transfer from BYTES32_BS58_2 to BYTES32_BS58_3, with a nonce sysvar and
+// the system program
+static const uint8_t MESSAGE[] = {
+    1, 0, 2,
+    4,
+        BYTES32_BS58_2,
+        BYTES32_BS58_3,
+        SYSVAR_RECENT_BLOCKHASHES,
+        PROGRAM_ID_SYSTEM,
+    BYTES32_BS58_4,
+    1,
+        3, 2, 0, 1, 12, 2, 0, 0, 0, 42, 0, 0, 0, 0, 0, 0, 0
+};
+
+static const uint8_t COMPRESSED_MESSAGE[] = {
+    1, 0, 2,
+    4,
+        0x00, BYTES32_BS58_2,
+        0x00, BYTES32_BS58_3,
+        17,
+        1,
+    BYTES32_BS58_4,
+    1,
+        3, 2, 0, 1, 12, 2, 0, 0, 0, 42, 0, 0, 0, 0, 0, 0, 0
+};
+
+/* clang-format on */
+
+// Expand in chunks of chunk_size bytes, as they would arrive over APDUs
+static int expand(const uint8_t* in,
+                  size_t in_length,
+                  size_t chunk_size,
+                  uint8_t* out,
+                  size_t out_size,
+                  size_t* out_length) {
+    MessageExpander expander = {0};
+    *out_length = 0;
+    for (size_t offset = 0; offset < in_length; offset += chunk_size) {
+        const size_t length = in_length - offset < chunk_size ? in_length - offset : chunk_size;
+        size_t written = 0;
+        BAIL_IF(message_expander_update(&expander,
+                                        in + offset,
+                                        length,
+                                        out + *out_length,
+                                        out_size - *out_length,
+                                        &written));
+        *out_length += written;
+    }
+    return message_expander_finish(&expander);
+}
+
+void test_pubkey_dictionary_entries_are_unique() {
+    const size_t size = pubkey_dictionary_size();
+    assert(size > 0 && size <= PUBKEY_DICTIONARY_MAX_SIZE);
+    for (size_t i = 0; i < size; i++) {
+        assert(pubkey_dictionary_find(pubkey_dictionary_get(i)) == (int) i);
+    }
+    assert(pubkey_dictionary_get(size) == NULL);
+
+    // registry mints follow the well-known keys
+    const Pubkey system = {{PROGRAM_ID_SYSTEM}};
+    assert(pubkey_dictionary_find(&system) == 0);
+    assert(pubkey_dictionary_find(&TOKEN_REGISTRY[0].mint_address) >= 0);
+    const Pubkey unknown = {{BYTES32_BS58_2}};
+    assert(pubkey_dictionary_find(&unknown) == -1);
+}
+
+// The first two tokens of token_registry.txt
+static const Pubkey WRAPPED_SOL_MINT = {{
+    0x06, 0x9b, 0x88, 0x57, 0xfe, 0xab, 0x81, 0x84, 0xfb, 0x68, 0x7f,
+    0x63, 0x46, 0x18, 0xc0, 0x35, 0xda, 0xc4, 0x39, 0xdc, 0x1a, 0xeb,
+    0x3b, 0x55, 0x98, 0xa0, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x01}};
+static const Pubkey JUP_MINT = {{
+    0x04, 0x79, 0xd9, 0xc7, 0xcc, 0x10, 0x35, 0xde, 0x72, 0x11, 0xf9,
+    0x9e, 0xb4, 0x8c, 0x09, 0xd7, 0x0b, 0x2b, 0xdf, 0x5b, 0xdf, 0x9e,
+    0x2e, 0x56, 0xb8, 0xa1, 0xfb, 0xb5, 0xa2, 0xea, 0x33, 0x27}};
+
+void test_pubkey_dictionary_mints_in_registry_file_order() {
+    // not in hash slot order, which changes whenever a token is added
+    const size_t first_mint = pubkey_dictionary_size() - TOKEN_REGISTRY_LENGTH;
+    assert(pubkey_dictionary_find(&WRAPPED_SOL_MINT) == (int) first_mint);
+    assert(pubkey_dictionary_find(&JUP_MINT) == (int) first_mint + 1);
+
+    // every registry mint is in the dictionary
+    for (size_t i = 0; i < TOKEN_REGISTRY_LENGTH; i++) {
+        assert(pubkey_dictionary_find(&TOKEN_REGISTRY[i].mint_address) >= (int) first_mint);
+    }
+}
+
+void test_message_compress() {
+    uint8_t out[sizeof(MESSAGE)];
+    size_t out_length = 0;
+    assert(message_compress(MESSAGE, sizeof(MESSAGE), out, sizeof(out), &out_length) == 0);
+    assert(out_length == sizeof(COMPRESSED_MESSAGE));
+    assert(memcmp(out, COMPRESSED_MESSAGE, out_length) == 0);
+
+    // the account table must be complete
+    assert(message_compress(MESSAGE, 4 + 3 * PUBKEY_SIZE, out, sizeof(out), &out_length) == 1);
+    // and the output large enough
+    assert(message_compress(MESSAGE, sizeof(MESSAGE), out, 10, &out_length) == 1);
+}
+
+void test_message_expand_any_chunking() {
+    uint8_t out[sizeof(MESSAGE)];
+    size_t out_length = 0;
+    for (size_t chunk_size = 1; chunk_size <= sizeof(COMPRESSED_MESSAGE); chunk_size++) {
+        assert(expand(COMPRESSED_MESSAGE,
+                      sizeof(COMPRESSED_MESSAGE),
+                      chunk_size,
+                      out,
+                      sizeof(out),
+                      &out_length) == 0);
+        assert(out_length == sizeof(MESSAGE));
+        assert(memcmp(out, MESSAGE, sizeof(MESSAGE)) == 0);
+    }
+}
+
+void test_message_expand_versioned() {
+    uint8_t message[1 + sizeof(MESSAGE)] = {0x80};
+    memcpy(message + 1, MESSAGE, sizeof(MESSAGE));
+    uint8_t compressed[sizeof(message)];
+    size_t compressed_length = 0;
+    assert(message_compress(message,
+                            sizeof(message),
+                            compressed,
+                            sizeof(compressed),
+                            &compressed_length) == 0);
+    assert(compressed_length == 1 + sizeof(COMPRESSED_MESSAGE));
+
+    uint8_t out[sizeof(message)];
+    size_t out_length = 0;
+    assert(expand(compressed, compressed_length, 7, out, sizeof(out), &out_length) == 0);
+    assert(out_length == sizeof(message));
+    assert(memcmp(out, message, sizeof(message)) == 0);
+}
+
+void test_message_expand_long_references() {
+    // a long reference is only valid within the dictionary
+    const uint8_t compressed[] = {1, 0, 0, 2, 0xf0, 0x00, 0x01};
+    uint8_t out[3 * PUBKEY_SIZE];
+    size_t out_length = 0;
+    const int expected = pubkey_dictionary_size() > PUBKEY_DICTIONARY_SHORT ? 0 : 1;
+    assert(expand(compressed, sizeof(compressed), 1, out, sizeof(out), &out_length) == expected);
+}
+
+void test_message_expand_invalid() {
+    uint8_t out[sizeof(MESSAGE)];
+    size_t out_length = 0;
+
+    // the account table is incomplete
+    const size_t incomplete_length = 4 + 2 * (1 + PUBKEY_SIZE);
+    assert(expand(COMPRESSED_MESSAGE, incomplete_length, 16, out, sizeof(out), &out_length) == 1);
+
+    // a reference past the dictionary
+    uint8_t compressed[sizeof(COMPRESSED_MESSAGE)];
+    memcpy(compressed, COMPRESSED_MESSAGE, sizeof(compressed));
+    compressed[4 + 2 * (1 + PUBKEY_SIZE)] = PUBKEY_DICTIONARY_SHORT;
+    const int expected = pubkey_dictionary_size() >= PUBKEY_DICTIONARY_SHORT ? 0 : 1;
+    assert(expand(compressed, sizeof(compressed), 16, out, sizeof(out), &out_length) == expected);
+
+    // the expanded message does not fit
+    assert(expand(COMPRESSED_MESSAGE,
+                  sizeof(COMPRESSED_MESSAGE),
+                  16,
+                  out,
+                  sizeof(out) - 1,
+                  &out_length) == 1);
+}
+
+int main() {
+    test_pubkey_dictionary_entries_are_unique();
+    test_pubkey_dictionary_mints_in_registry_file_order();
+    test_message_compress();
+    test_message_expand_any_chunking();
+    test_message_expand_versioned();
+    test_message_expand_long_references();
+    test_message_expand_invalid();
+
+    printf("passed\n");
+    return 0;
+}
@@ -11,6 +11,7 @@ bool is_serum_assert_owner_program_id(const Pubkey* program_id) {
         {{PROGRAM_ID_SERUM_ASSERT_OWNER}},
     };
     for (size_t i = 0; i < ARRAY_LEN(program_ids); i++) {
+        LIBSOL_STATS_ADD(program_id_compares, 1);
         if (pubkeys_equal(program_id, &program_ids[i])) {
             return true;
         }
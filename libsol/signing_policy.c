@@ -0,0 +1,69 @@
+#include "sol/signing_policy.h"
+#include "instruction.h"
+#include "util.h"
+
+// Commission is a percentage
+#define MAX_COMMISSION 100
+
+static bool pubkey_is_zero(const Pubkey* pubkey) {
+    for (size_t i = 0; i < PUBKEY_SIZE; i++) {
+        if (pubkey->data[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int signing_policy_validate(const SigningPolicy* policy) {
+    BAIL_IF(policy == NULL);
+    switch (policy->pattern) {
+        case SigningPolicyVoteUpdateCommission:
+            BAIL_IF(!pubkey_is_zero(&policy->destination));
+            BAIL_IF(policy->max_amount > MAX_COMMISSION);
+            return 0;
+        case SigningPolicyVoteWithdraw:
+            BAIL_IF(pubkey_is_zero(&policy->destination));
+            return 0;
+        default:
+            break;
+    }
+    return 1;
+}
+
+int signing_policy_match(const SigningPolicy* policy,
+                         const MessageHeader* header,
+                         const uint8_t* message_body,
+                         int message_body_length) {
+    BAIL_IF(signing_policy_validate(policy));
+    BAIL_IF(header == NULL);
+    // Nothing else may ride along: no nonce, compute budget nor memo
+    BAIL_IF(header->instructions_length != 1);
+
+    InstructionInfo infos[MAX_INSTRUCTIONS];
+    BAIL_IF(parse_message_instructions(message_body, message_body_length, header, infos));
+    BAIL_IF(infos[0].kind != ProgramIdVote);
+
+    const VoteInfo* vote = &infos[0].vote;
+    switch (policy->pattern) {
+        case SigningPolicyVoteUpdateCommission: {
+            const VoteUpdateCommissionInfo* info = &vote->update_commission;
+            BAIL_IF(vote->kind != VoteUpdateCommission);
+            BAIL_IF(!pubkeys_equal(info->account, &policy->account));
+            BAIL_IF(!pubkeys_equal(info->authority, &policy->signer));
+            BAIL_IF(info->commission > policy->max_amount);
+            return 0;
+        }
+        case SigningPolicyVoteWithdraw: {
+            const VoteWithdrawInfo* info = &vote->withdraw;
+            BAIL_IF(vote->kind != VoteWithdraw);
+            BAIL_IF(!pubkeys_equal(info->account, &policy->account));
+            BAIL_IF(!pubkeys_equal(info->authority, &policy->signer));
+            BAIL_IF(!pubkeys_equal(info->to, &policy->destination));
+            BAIL_IF(info->lamports > policy->max_amount);
+            return 0;
+        }
+        default:
+            break;
+    }
+    return 1;
+}
@@ -0,0 +1,176 @@
+#include "common_byte_strings.h"
+#include "sol/signing_policy.h"
+#include "util.h"
+#include <assert.h>
+#include <stdio.h>
+
+// Disable clang format for this file to keep clear buffer formatting
+/* clang-format off */
+
+// Withdraw 42 lamports from account 1 to account 2, authorized by account 0
+static const uint8_t VOTE_WITHDRAW_MESSAGE[] = {
+    1, 1, 1,
+    4,
+        18, 67, 85, 168, 124, 173, 88, 142, 77, 171, 80, 178, 8, 218, 230, 68, 85, 231, 39, 54, 184, 42, 162, 85, 172, 139, 54, 173, 194, 7, 64, 250,
+        112, 173, 25, 161, 89, 143, 220, 223, 128, 33, 149, 41, 12, 152, 202, 202, 203, 163, 182, 246, 158, 15, 22, 77, 171, 71, 63, 249, 10, 117, 172, 52,
+        1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+        7, 97, 72, 29, 53, 116, 116, 187, 124, 77, 118, 36, 235, 211, 189, 179, 216, 53, 94, 115, 209, 16, 67, 252, 13, 163, 83, 128, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1,
+        // vote - withdraw
+        3,
+        3,
+            1, 2, 0,
+        12,
+            3, 0, 0, 0,
+            42, 0, 0, 0, 0, 0, 0, 0
+};
+
+// Set the commission of account 0 to 42, authorized by account 1
+static const uint8_t VOTE_UPDATE_COMMISSION_MESSAGE[] = {
+    2, 1, 1,
+    3,
+        19, 144, 25, 80, 156, 114, 186, 66, 29, 241, 166, 151, 127, 235, 131, 211, 64, 194, 62, 195, 227, 161, 166, 82, 59, 204, 214, 44, 193, 158, 63, 169,
+        10, 197, 71, 166, 84, 143, 238, 106, 60, 71, 210, 140, 50, 46, 5, 64, 197, 233, 184, 185, 240, 1, 189, 60, 85, 208, 255, 255, 23, 193, 128, 222,
+        7, 97, 72, 29, 53, 116, 116, 187, 124, 77, 118, 36, 235, 211, 189, 179, 216, 53, 94, 115, 209, 16, 67, 252, 13, 163, 83, 128, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1,
+        2,
+        2,
+            0, 1,
+        5,
+            5, 0, 0, 0,
+            42
+};
+
+/* clang-format on */
+
+static int match(const SigningPolicy* policy, const uint8_t* message, size_t message_length) {
+    MessageHeader header;
+    Parser parser = {message, message_length};
+    assert(parse_message_header(&parser, &header) == 0);
+    return signing_policy_match(policy, &header, parser.buffer, parser.buffer_length);
+}
+
+// Policy allowing exactly what message does, keys taken from its header
+static void make_policy(SigningPolicy* policy,
+                        uint8_t pattern,
+                        const uint8_t* message,
+                        size_t message_length) {
+    MessageHeader header;
+    Parser parser = {message, message_length};
+    assert(parse_message_header(&parser, &header) == 0);
+    memset(policy, 0, sizeof(*policy));
+    policy->pattern = pattern;
+    if (pattern == SigningPolicyVoteWithdraw) {
+        policy->signer = header.pubkeys[0];
+        policy->account = header.pubkeys[1];
+        policy->destination = header.pubkeys[2];
+        policy->max_amount = 42;
+    } else {
+        policy->signer = header.pubkeys[1];
+        policy->account = header.pubkeys[0];
+        policy->max_amount = 42;
+    }
+}
+
+void test_signing_policy_validate() {
+    SigningPolicy policy;
+    memset(&policy, 0, sizeof(policy));
+    assert(signing_policy_validate(&policy) == 1);
+    assert(signing_policy_validate(NULL) == 1);
+
+    policy.pattern = SigningPolicyVoteUpdateCommission;
+    policy.max_amount = 100;
+    assert(signing_policy_validate(&policy) == 0);
+    policy.max_amount = 101;
+    assert(signing_policy_validate(&policy) == 1);
+    policy.max_amount = 10;
+    policy.destination.data[0] = 1;
+    assert(signing_policy_validate(&policy) == 1);
+
+    // a withdrawal goes to a fixed destination
+    policy.pattern = SigningPolicyVoteWithdraw;
+    assert(signing_policy_validate(&policy) == 0);
+    memset(&policy.destination, 0, sizeof(policy.destination));
+    assert(signing_policy_validate(&policy) == 1);
+
+    policy.pattern = 3;
+    assert(signing_policy_validate(&policy) == 1);
+}
+
+void test_signing_policy_vote_withdraw() {
+    const uint8_t* message = VOTE_WITHDRAW_MESSAGE;
+    const size_t length = sizeof(VOTE_WITHDRAW_MESSAGE);
+    SigningPolicy policy;
+
+    make_policy(&policy, SigningPolicyVoteWithdraw, message, length);
+    assert(match(&policy, message, length) == 0);
+
+    // over the cap
+    policy.max_amount = 41;
+    assert(match(&policy, message, length) == 1);
+
+    // another destination, account or signer
+    make_policy(&policy, SigningPolicyVoteWithdraw, message, length);
+    policy.destination.data[0] ^= 1;
+    assert(match(&policy, message, length) == 1);
+    make_policy(&policy, SigningPolicyVoteWithdraw, message, length);
+    policy.account.data[0] ^= 1;
+    assert(match(&policy, message, length) == 1);
+    make_policy(&policy, SigningPolicyVoteWithdraw, message, length);
+    policy.signer.data[0] ^= 1;
+    assert(match(&policy, message, length) == 1);
+
+    // another pattern
+    policy = (SigningPolicy){0};
+    make_policy(&policy, SigningPolicyVoteUpdateCommission, message, length);
+    assert(match(&policy, message, length) == 1);
+}
+
+void test_signing_policy_vote_update_commission() {
+    const uint8_t* message = VOTE_UPDATE_COMMISSION_MESSAGE;
+    const size_t length = sizeof(VOTE_UPDATE_COMMISSION_MESSAGE);
+    SigningPolicy policy;
+
+    make_policy(&policy, SigningPolicyVoteUpdateCommission, message, length);
+    assert(match(&policy, message, length) == 0);
+    policy.max_amount = 41;
+    assert(match(&policy, message, length) == 1);
+
+    // an installed policy that does not validate never matches
+    make_policy(&policy, SigningPolicyVoteUpdateCommission, message, length);
+    policy.destination.data[0] = 1;
+    assert(match(&policy, message, length) == 1);
+}
+
+void test_signing_policy_single_instruction() {
+    // the withdrawal twice
+    const size_t instruction_length = 1 + 1 + 3 + 1 + 12;
+    const size_t count_offset = sizeof(VOTE_WITHDRAW_MESSAGE) - instruction_length - 1;
+    uint8_t message[sizeof(VOTE_WITHDRAW_MESSAGE) + instruction_length];
+    memcpy(message, VOTE_WITHDRAW_MESSAGE, sizeof(VOTE_WITHDRAW_MESSAGE));
+    memcpy(message + sizeof(VOTE_WITHDRAW_MESSAGE),
+           VOTE_WITHDRAW_MESSAGE + count_offset + 1,
+           instruction_length);
+    message[count_offset] = 2;
+
+    SigningPolicy policy;
+    make_policy(&policy, SigningPolicyVoteWithdraw, message, sizeof(message));
+    assert(match(&policy, message, sizeof(message)) == 1);
+
+    // trailing bytes
+    message[count_offset] = 1;
+    assert(match(&policy, message, sizeof(message)) == 1);
+    assert(match(&policy, message, sizeof(VOTE_WITHDRAW_MESSAGE)) == 0);
+}
+
+int main() {
+    test_signing_policy_validate();
+    test_signing_policy_vote_withdraw();
+    test_signing_policy_vote_update_commission();
+    test_signing_policy_single_instruction();
+
+    printf("passed\n");
+    return 0;
+}
@@ -0,0 +1,177 @@
+#include "bench.h"
+#include "sol/message_generator.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <string.h>
+#include <ucontext.h>
+
+// Stack high-water marks of reviewing the transactions of the fuzzing corpus,
+// then the generated messages of every pattern. Each message runs on its own
+// stack, painted beforehand, and the bytes no longer painted afterwards are
+// the ones it used. Marks are net of what running on that stack costs.
+// Under `make target=arm` they are those of the device's Thumb code.
+#define CORPUS_DIR           "../fuzzing/corpus"
+#define MAX_MESSAGE_LENGTH   1280
+#define STACK_SIZE           (64 * 1024)
+#define STACK_PAINT          0xa5
+#define MESSAGES_PER_PATTERN 256
+
+static uint8_t G_stack[STACK_SIZE] __attribute__((aligned(16)));
+static ucontext_t G_caller_context;
+static ucontext_t G_message_context;
+
+// The message to review, on the painted stack
+static const uint8_t* G_data;
+static size_t G_length;
+static BenchPhase G_last_phase;
+static bool G_review;
+
+static void review_on_stack(void) {
+    if (G_review) {
+        bench_run_pipeline(G_data, G_length, G_last_phase);
+    }
+}
+
+static size_t stack_used(void) {
+    memset(G_stack, STACK_PAINT, sizeof(G_stack));
+    getcontext(&G_message_context);
+    G_message_context.uc_stack.ss_sp = G_stack;
+    G_message_context.uc_stack.ss_size = sizeof(G_stack);
+    G_message_context.uc_link = &G_caller_context;
+    makecontext(&G_message_context, review_on_stack, 0);
+    swapcontext(&G_caller_context, &G_message_context);
+
+    // The stack grows down, from the end of G_stack
+    size_t unused = 0;
+    while (unused < sizeof(G_stack) && G_stack[unused] == STACK_PAINT) {
+        unused++;
+    }
+    return sizeof(G_stack) - unused;
+}
+
+static size_t G_baseline;
+
+// Bytes of stack reviewing a message used, up to each phase
+static void measure(const uint8_t* data, size_t length, size_t marks[BenchPhaseCount]) {
+    G_data = data;
+    G_length = length;
+    G_review = true;
+    for (BenchPhase phase = BenchPhaseParse; phase < BenchPhaseCount; phase++) {
+        G_last_phase = phase;
+        const size_t used = stack_used();
+        marks[phase] = used > G_baseline ? used - G_baseline : 0;
+    }
+}
+
+static void print_marks(const char* name, const size_t marks[BenchPhaseCount]) {
+    printf("%-50s", name);
+    for (BenchPhase phase = BenchPhaseParse; phase < BenchPhaseCount; phase++) {
+        printf(" %8zu", marks[phase]);
+    }
+    printf("\n");
+}
+
+static void print_header(const char* title) {
+    printf("==> %s\n%-50s", title, "bytes of stack, up to");
+    for (BenchPhase phase = BenchPhaseParse; phase < BenchPhaseCount; phase++) {
+        printf(" %8s", BENCH_PHASE_NAMES[phase]);
+    }
+    printf("\n");
+}
+
+static void keep_worst(size_t worst[BenchPhaseCount], const size_t marks[BenchPhaseCount]) {
+    for (BenchPhase phase = BenchPhaseParse; phase < BenchPhaseCount; phase++) {
+        if (marks[phase] > worst[phase]) {
+            worst[phase] = marks[phase];
+        }
+    }
+}
+
+static size_t read_file(const char* path, uint8_t* buffer, size_t buffer_size) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    const size_t length = fread(buffer, 1, buffer_size, file);
+    fclose(file);
+    return length;
+}
+
+// Corpus entries the device would not display are left out
+static int measure_corpus(size_t worst[BenchPhaseCount]) {
+    DIR* dir = opendir(CORPUS_DIR);
+    if (dir == NULL) {
+        printf("cannot open %s\n", CORPUS_DIR);
+        return 1;
+    }
+    print_header("Corpus");
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        const size_t name_length = strlen(entry->d_name);
+        if (name_length < 4 || strcmp(entry->d_name + name_length - 4, ".raw") != 0) {
+            continue;
+        }
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", CORPUS_DIR, entry->d_name);
+        uint8_t data[MAX_MESSAGE_LENGTH];
+        const size_t length = read_file(path, data, sizeof(data));
+        if (length == 0 || bench_run_pipeline(data, length, BenchPhaseDisplay) != 0) {
+            continue;
+        }
+
+        size_t marks[BenchPhaseCount];
+        measure(data, length, marks);
+        char name[64];
+        snprintf(name, sizeof(name), "%.*s", (int) name_length - 4, entry->d_name);
+        print_marks(name, marks);
+        keep_worst(worst, marks);
+    }
+    closedir(dir);
+    return 0;
+}
+
+// Worst of the valid generated messages of each pattern
+static int measure_patterns(size_t worst[BenchPhaseCount]) {
+    const size_t num_patterns = message_generator_pattern_count();
+    size_t pattern_worst[num_patterns][BenchPhaseCount];
+    size_t num_measured[num_patterns];
+    memset(pattern_worst, 0, sizeof(pattern_worst));
+    memset(num_measured, 0, sizeof(num_measured));
+
+    MessageGenerator generator;
+    message_generator_init(&generator, 1, 0, 0);
+    GeneratedMessage message;
+    for (size_t i = 0; i < num_patterns * MESSAGES_PER_PATTERN; i++) {
+        BAIL_IF(message_generator_next(&generator, &message));
+        if (bench_run_pipeline(message.data, message.length, BenchPhaseDisplay) != 0) {
+            printf("%s: refused\n", message_generator_pattern_name(message.pattern));
+            return 1;
+        }
+        size_t marks[BenchPhaseCount];
+        measure(message.data, message.length, marks);
+        keep_worst(pattern_worst[message.pattern], marks);
+        num_measured[message.pattern]++;
+    }
+
+    print_header("Patterns");
+    for (size_t i = 0; i < num_patterns; i++) {
+        if (num_measured[i] > 0) {
+            print_marks(message_generator_pattern_name(i), pattern_worst[i]);
+            keep_worst(worst, pattern_worst[i]);
+        }
+    }
+    return 0;
+}
+
+int main() {
+    G_review = false;
+    G_baseline = stack_used();
+
+    size_t worst[BenchPhaseCount] = {0};
+    if (measure_corpus(worst) != 0 || measure_patterns(worst) != 0) {
+        return 1;
+    }
+    print_header("Worst");
+    print_marks("all messages", worst);
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include "sol/stats.h"
+
+#ifdef LIBSOL_STATS
+
+#include "util.h"
+
+LibsolStats G_libsol_stats;
+
+void libsol_stats_reset(void) {
+    memset(&G_libsol_stats, 0, sizeof(G_libsol_stats));
+}
+
+void libsol_stats_snapshot(LibsolStats* snapshot) {
+    memcpy(snapshot, &G_libsol_stats, sizeof(*snapshot));
+}
+
+// Failures are the cold path, a linear search of the sites is enough
+void libsol_stats_bail(const char* file, int line) {
+    LibsolStats* stats = &G_libsol_stats;
+    stats->bail_failures++;
+    for (size_t i = 0; i < stats->num_bail_sites; i++) {
+        LibsolStatsBailSite* site = &stats->bail_sites[i];
+        if (site->line == line && strcmp(site->file, file) == 0) {
+            site->count++;
+            return;
+        }
+    }
+    if (stats->num_bail_sites < ARRAY_LEN(stats->bail_sites)) {
+        LibsolStatsBailSite* site = &stats->bail_sites[stats->num_bail_sites++];
+        site->file = file;
+        site->line = line;
+        site->count = 1;
+    }
+}
+
+#endif
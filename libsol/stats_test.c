@@ -0,0 +1,71 @@
+// Counting is built in for this test only, whatever libsol.a was built with
+#ifndef LIBSOL_STATS
+#define LIBSOL_STATS
+#endif
+#include "stats.c"
+#include <assert.h>
+#include <stdio.h>
+
+static int fail_at_first_site(void) {
+    BAIL_IF(1);
+    return 0;
+}
+
+static int fail_at_second_site(void) {
+    BAIL_IF(fail_at_first_site());
+    return 0;
+}
+
+void test_libsol_stats_counters() {
+    libsol_stats_reset();
+    LIBSOL_STATS_ADD(parser_bytes, 32);
+    LIBSOL_STATS_ADD(parser_bytes, 8);
+    LIBSOL_STATS_ADD(token_symbol_misses, 1);
+
+    LibsolStats snapshot;
+    libsol_stats_snapshot(&snapshot);
+    assert(snapshot.parser_bytes == 40);
+    assert(snapshot.token_symbol_misses == 1);
+    assert(snapshot.base58_encodes == 0);
+
+    // a snapshot does not move with the counters
+    LIBSOL_STATS_ADD(parser_bytes, 1);
+    assert(snapshot.parser_bytes == 40);
+
+    libsol_stats_reset();
+    libsol_stats_snapshot(&snapshot);
+    assert(snapshot.parser_bytes == 0);
+    assert(snapshot.token_symbol_misses == 0);
+}
+
+void test_libsol_stats_bail_sites() {
+    libsol_stats_reset();
+    assert(fail_at_second_site() == 1);
+    assert(fail_at_first_site() == 1);
+
+    // a failure counts at every BAIL_IF it unwinds through
+    LibsolStats snapshot;
+    libsol_stats_snapshot(&snapshot);
+    assert(snapshot.bail_failures == 3);
+    assert(snapshot.num_bail_sites == 2);
+    assert(snapshot.bail_sites[0].count == 2);
+    assert(snapshot.bail_sites[1].count == 1);
+    assert(snapshot.bail_sites[0].line < snapshot.bail_sites[1].line);
+    assert(strcmp(snapshot.bail_sites[0].file, __FILE__) == 0);
+
+    // sites past the table only count in the total
+    for (int line = 0; line < LIBSOL_STATS_MAX_BAIL_SITES; line++) {
+        libsol_stats_bail("elsewhere.c", line);
+    }
+    libsol_stats_snapshot(&snapshot);
+    assert(snapshot.num_bail_sites == LIBSOL_STATS_MAX_BAIL_SITES);
+    assert(snapshot.bail_failures == 3 + LIBSOL_STATS_MAX_BAIL_SITES);
+}
+
+int main() {
+    test_libsol_stats_counters();
+    test_libsol_stats_bail_sites();
+
+    printf("passed\n");
+    return 0;
+}
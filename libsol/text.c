@@ -0,0 +1,208 @@
+#include "sol/text.h"
+#include "util.h"
+
+// Both validators take 16 bytes at a time with SSE2 where the host has it,
+// then 4 bytes at a time (SWAR), then single bytes, so every path still runs
+// in host tests. The device only ever takes the last two.
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define TEXT_SIMD_BLOCK 16
+#endif
+
+#define HIGH_BITS_32 0x80808080u
+
+static uint32_t load_u32(const uint8_t* data) {
+    uint32_t word;
+    memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+// High bit set in any byte that is not printable ASCII. Byte order does not
+// matter, and no carry can cross a byte unless a high bit is already set.
+static uint32_t non_printable_bytes(uint32_t word) {
+    const uint32_t below_space = (word - 0x20202020u) & ~word;
+    const uint32_t above_tilde = (word + 0x01010101u) | word;
+    return (below_space | above_tilde) & HIGH_BITS_32;
+}
+
+#ifdef TEXT_SIMD_BLOCK
+static bool is_block_printable(const uint8_t* data) {
+    const __m128i block = _mm_loadu_si128((const __m128i*) (const void*) data);
+    // Signed compares, so bytes from 0x80 up count as below the space
+    const __m128i below_space = _mm_cmplt_epi8(block, _mm_set1_epi8(0x20));
+    const __m128i above_tilde = _mm_cmpgt_epi8(block, _mm_set1_epi8(0x7e));
+    return _mm_movemask_epi8(_mm_or_si128(below_space, above_tilde)) == 0;
+}
+
+static bool is_block_ascii(const uint8_t* data) {
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) (const void*) data)) == 0;
+}
+#endif
+
+bool is_data_ascii(const uint8_t* data, size_t length) {
+    if (!data) {
+        return false;
+    }
+    size_t i = 0;
+#ifdef TEXT_SIMD_BLOCK
+    for (; i + TEXT_SIMD_BLOCK <= length; i += TEXT_SIMD_BLOCK) {
+        if (!is_block_printable(data + i)) {
+            return false;
+        }
+    }
+#endif
+    for (; i + sizeof(uint32_t) <= length; i += sizeof(uint32_t)) {
+        if (non_printable_bytes(load_u32(data + i)) != 0) {
+            return false;
+        }
+    }
+    for (; i < length; i++) {
+        if (data[i] < 0x20 || data[i] > 0x7e) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// UTF-8 is validated by a "shift" DFA: every byte class has a 64-bit row
+// holding, at bit offset `state`, the offset of the next state. The row only
+// depends on the input byte, so the loop-carried dependency is a single shift
+// instead of a table load indexed by the previous state.
+//
+// The noncharacters U+FFFE and U+FFFF (EF BF BE, EF BF BF) are checked in a
+// separate pass to keep the state count within what fits a 64-bit row.
+enum Utf8Class {
+    Utf8ClassAscii,    // 00..7F
+    Utf8ClassCont80,   // 80..8F
+    Utf8ClassCont90,   // 90..9F
+    Utf8ClassContA0,   // A0..BF
+    Utf8ClassInvalid,  // C0, C1, F5..FF
+    Utf8ClassLead2,    // C2..DF
+    Utf8ClassLeadE0,   // E0
+    Utf8ClassLead3,    // E1..EC, EE, EF
+    Utf8ClassLeadED,   // ED
+    Utf8ClassLeadF0,   // F0
+    Utf8ClassLead4,    // F1..F3
+    Utf8ClassLeadF4,   // F4
+    Utf8ClassCount
+};
+
+// States are bit offsets into a row. Utf8Reject is 0 and absorbing because
+// no row sets the low six bits.
+enum Utf8State {
+    Utf8Reject = 0,
+    Utf8Accept = 6,
+    Utf8Need1 = 12,     // any continuation left, then accept
+    Utf8Need2 = 18,
+    Utf8Need3 = 24,
+    Utf8AfterE0 = 30,   // A0..BF, no overlong forms
+    Utf8AfterED = 36,   // 80..9F, no surrogates
+    Utf8AfterF0 = 42,   // 90..BF, no overlong forms
+    Utf8AfterF4 = 48,   // 80..8F, nothing above U+10FFFF
+};
+
+#define UTF8_STATE_MASK 0x3f
+#define UTF8_NEXT(from, to) ((uint64_t) (to) << (from))
+#define UTF8_CONTINUATION \
+    (UTF8_NEXT(Utf8Need1, Utf8Accept) | UTF8_NEXT(Utf8Need2, Utf8Need1) | \
+     UTF8_NEXT(Utf8Need3, Utf8Need2))
+
+static const uint64_t UTF8_ROWS[Utf8ClassCount] = {
+    [Utf8ClassAscii] = UTF8_NEXT(Utf8Accept, Utf8Accept),
+    [Utf8ClassCont80] = UTF8_CONTINUATION | UTF8_NEXT(Utf8AfterED, Utf8Need1) |
+                        UTF8_NEXT(Utf8AfterF4, Utf8Need2),
+    [Utf8ClassCont90] = UTF8_CONTINUATION | UTF8_NEXT(Utf8AfterED, Utf8Need1) |
+                        UTF8_NEXT(Utf8AfterF0, Utf8Need2),
+    [Utf8ClassContA0] = UTF8_CONTINUATION | UTF8_NEXT(Utf8AfterE0, Utf8Need1) |
+                        UTF8_NEXT(Utf8AfterF0, Utf8Need2),
+    [Utf8ClassInvalid] = 0,
+    [Utf8ClassLead2] = UTF8_NEXT(Utf8Accept, Utf8Need1),
+    [Utf8ClassLeadE0] = UTF8_NEXT(Utf8Accept, Utf8AfterE0),
+    [Utf8ClassLead3] = UTF8_NEXT(Utf8Accept, Utf8Need2),
+    [Utf8ClassLeadED] = UTF8_NEXT(Utf8Accept, Utf8AfterED),
+    [Utf8ClassLeadF0] = UTF8_NEXT(Utf8Accept, Utf8AfterF0),
+    [Utf8ClassLead4] = UTF8_NEXT(Utf8Accept, Utf8Need3),
+    [Utf8ClassLeadF4] = UTF8_NEXT(Utf8Accept, Utf8AfterF4),
+};
+
+// clang-format off
+static const uint8_t UTF8_CLASSES[256] = {
+    // 00..7F
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    // 80..BF
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    // C0..DF
+    4, 4, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    // E0..EF
+    6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 8, 7, 7,
+    // F0..FF
+    9, 10, 10, 10, 11, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+};
+// clang-format on
+
+static uint32_t utf8_step(uint32_t state, uint8_t byte) {
+    return (UTF8_ROWS[UTF8_CLASSES[byte]] >> state) & UTF8_STATE_MASK;
+}
+
+// EF BF BE and EF BF BF are only ever U+FFFE and U+FFFF in otherwise valid
+// UTF-8, since EF cannot be a continuation byte
+static bool has_noncharacter(const uint8_t* data, size_t length) {
+    const uint8_t* end = data + length;
+    const uint8_t* lead = memchr(data, 0xef, length);
+    while (lead != NULL && end - lead >= 3) {
+        if (lead[1] == 0xbf && (lead[2] & 0xfe) == 0xbe) {
+            return true;
+        }
+        lead = memchr(lead + 1, 0xef, end - lead - 1);
+    }
+    return false;
+}
+
+bool is_data_utf8(const uint8_t* data, size_t length) {
+    if (!data) {
+        return false;
+    }
+    uint32_t state = Utf8Accept;
+    size_t i = 0;
+    while (i < length) {
+        if (state == Utf8Accept && data[i] < 0x80) {
+            // Skip runs of ASCII between complete sequences
+#ifdef TEXT_SIMD_BLOCK
+            while (i + TEXT_SIMD_BLOCK <= length && is_block_ascii(data + i)) {
+                i += TEXT_SIMD_BLOCK;
+            }
+#endif
+            while (i + sizeof(uint32_t) <= length && (load_u32(data + i) & HIGH_BITS_32) == 0) {
+                i += sizeof(uint32_t);
+            }
+            while (i < length && data[i] < 0x80) {
+                i++;
+            }
+            continue;
+        }
+        // Utf8Reject is absorbing, so a whole word can be stepped through
+        // before looking for ASCII again
+        if (i + sizeof(uint32_t) <= length) {
+            state = utf8_step(state, data[i]);
+            state = utf8_step(state, data[i + 1]);
+            state = utf8_step(state, data[i + 2]);
+            state = utf8_step(state, data[i + 3]);
+            i += sizeof(uint32_t);
+        } else {
+            state = utf8_step(state, data[i]);
+            i++;
+        }
+    }
+    return state == Utf8Accept && !has_noncharacter(data, length);
+}
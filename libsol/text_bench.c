@@ -0,0 +1,58 @@
+#include "bench.h"
+#include "sol/text.h"
+#include "text_reference.h"
+#include <stdio.h>
+#include <string.h>
+
+// MAX_OFFCHAIN_MESSAGE_LENGTH on the larger devices
+#define MESSAGE_LENGTH 1212
+#define ITERATIONS     200000
+
+typedef bool (*validate_fn)(const uint8_t*, size_t);
+
+static double bench_validate(validate_fn validate, const uint8_t* data, size_t length) {
+    const uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        bench_do_not_optimize(data);
+        const bool valid = validate(data, length);
+        bench_do_not_optimize(&valid);
+    }
+    const double seconds = (double) (bench_now_ns() - start) / 1e9;
+    return (double) length * ITERATIONS / seconds / 1e6;
+}
+
+static void fill(uint8_t* data, size_t length, const char* pattern) {
+    const size_t pattern_length = strlen(pattern);
+    for (size_t i = 0; i < length; i++) {
+        data[i] = pattern[i % pattern_length];
+    }
+}
+
+int main() {
+    static uint8_t ascii[MESSAGE_LENGTH];
+    static uint8_t mixed[MESSAGE_LENGTH];
+    static uint8_t multibyte[MESSAGE_LENGTH];
+    fill(ascii, sizeof(ascii), "Sign in to example.com with your Solana account. ");
+    // 'é' every few words, and a 3-byte sequence filling the whole message
+    fill(mixed, sizeof(mixed), "Connexion \xc3\xa0 example.com ");
+    fill(multibyte, sizeof(multibyte), "\xe2\x82\xac");
+
+    printf("%-16s %14s %14s\n", "input", "reference", "libsol");
+    printf("%-16s %9.0f MB/s %9.0f MB/s\n",
+           "ascii/ascii",
+           bench_validate(reference_is_data_ascii, ascii, sizeof(ascii)),
+           bench_validate(is_data_ascii, ascii, sizeof(ascii)));
+    printf("%-16s %9.0f MB/s %9.0f MB/s\n",
+           "ascii/utf8",
+           bench_validate(reference_is_data_utf8, ascii, sizeof(ascii)),
+           bench_validate(is_data_utf8, ascii, sizeof(ascii)));
+    printf("%-16s %9.0f MB/s %9.0f MB/s\n",
+           "mixed/utf8",
+           bench_validate(reference_is_data_utf8, mixed, sizeof(mixed)),
+           bench_validate(is_data_utf8, mixed, sizeof(mixed)));
+    printf("%-16s %9.0f MB/s %9.0f MB/s\n",
+           "multibyte/utf8",
+           bench_validate(reference_is_data_utf8, multibyte, sizeof(multibyte)),
+           bench_validate(is_data_utf8, multibyte, sizeof(multibyte)));
+    return 0;
+}
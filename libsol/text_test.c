@@ -0,0 +1,111 @@
+#include "sol/text.h"
+#include "text_reference.h"
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#define assert_same(data, length)                                                     \
+    do {                                                                              \
+        assert(is_data_ascii(data, length) == reference_is_data_ascii(data, length)); \
+        assert(is_data_utf8(data, length) == reference_is_data_utf8(data, length));   \
+    } while (0)
+
+// Bytes on either side of every boundary the validators care about
+static const uint8_t EDGES[] = {0x00, 0x1f, 0x20, 0x7e, 0x7f, 0x80, 0x8f, 0x90, 0x9f, 0xa0, 0xbd,
+                                0xbe, 0xbf, 0xc0, 0xc1, 0xc2, 0xdf, 0xe0, 0xe1, 0xec, 0xed, 0xee,
+                                0xef, 0xf0, 0xf1, 0xf3, 0xf4, 0xf5, 0xf8, 0xff};
+
+void test_is_data_ascii() {
+    const uint8_t text[] = "Hello, Solana! ~";
+    assert(is_data_ascii(text, sizeof(text) - 1));
+    assert(is_data_ascii(text, 0));
+    assert(!is_data_ascii(NULL, 0));
+
+    uint8_t long_text[100];
+    memset(long_text, 'a', sizeof(long_text));
+    assert(is_data_ascii(long_text, sizeof(long_text)));
+    // A bad byte in the SIMD, SWAR and tail sections
+    for (size_t i = 0; i < sizeof(long_text); i++) {
+        long_text[i] = '\n';
+        assert(!is_data_ascii(long_text, sizeof(long_text)));
+        long_text[i] = 0x80;
+        assert(!is_data_ascii(long_text, sizeof(long_text)));
+        long_text[i] = 'a';
+    }
+}
+
+void test_is_data_utf8() {
+    const uint8_t text[] = "z\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80";  // z é € 😀
+    assert(is_data_utf8(text, sizeof(text) - 1));
+    assert(!is_data_utf8(text, sizeof(text) - 2));
+    assert(is_data_utf8(text, 0));
+    assert(!is_data_utf8(NULL, 0));
+
+    const uint8_t noncharacter[] = "\xef\xbf\xbe";  // U+FFFE
+    assert(!is_data_utf8(noncharacter, 3));
+    const uint8_t surrogate[] = "\xed\xa0\x80";  // U+D800
+    assert(!is_data_utf8(surrogate, 3));
+    const uint8_t overlong[] = "\xc0\xaf";
+    assert(!is_data_utf8(overlong, 2));
+    const uint8_t too_large[] = "\xf4\x90\x80\x80";  // U+110000
+    assert(!is_data_utf8(too_large, 4));
+}
+
+void test_matches_reference_short_sequences() {
+    uint8_t data[4];
+    for (size_t a = 0; a < 256; a++) {
+        data[0] = a;
+        assert_same(data, 1);
+        for (size_t b = 0; b < 256; b++) {
+            data[1] = b;
+            assert_same(data, 2);
+            for (size_t c = 0; c < 256; c++) {
+                data[2] = c;
+                assert_same(data, 3);
+            }
+        }
+    }
+    for (size_t a = 0; a < sizeof(EDGES); a++) {
+        for (size_t b = 0; b < sizeof(EDGES); b++) {
+            for (size_t c = 0; c < sizeof(EDGES); c++) {
+                for (size_t d = 0; d < sizeof(EDGES); d++) {
+                    data[0] = EDGES[a];
+                    data[1] = EDGES[b];
+                    data[2] = EDGES[c];
+                    data[3] = EDGES[d];
+                    assert_same(data, 4);
+                }
+            }
+        }
+    }
+}
+
+void test_matches_reference_at_every_offset() {
+    // Sequences straddling the 4 and 16 byte blocks, inside ASCII padding
+    uint8_t data[48];
+    for (size_t offset = 0; offset + 4 <= sizeof(data); offset++) {
+        for (size_t a = 0; a < sizeof(EDGES); a++) {
+            for (size_t b = 0; b < sizeof(EDGES); b++) {
+                for (size_t c = 0; c < sizeof(EDGES); c++) {
+                    memset(data, 'x', sizeof(data));
+                    data[offset] = EDGES[a];
+                    data[offset + 1] = EDGES[b];
+                    data[offset + 2] = EDGES[c];
+                    for (size_t length = offset; length <= sizeof(data); length += 5) {
+                        assert_same(data, length);
+                    }
+                }
+            }
+        }
+    }
+}
+
+int main() {
+    test_is_data_ascii();
+    test_is_data_utf8();
+    test_matches_reference_short_sequences();
+    test_matches_reference_at_every_offset();
+
+    printf("passed\n");
+    return 0;
+}
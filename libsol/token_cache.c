@@ -0,0 +1,40 @@
+#include "sol/token_cache.h"
+#include "lru_cache.h"
+#include "util.h"
+
+typedef struct TokenCache {
+    TokenCacheEntry entries[TOKEN_CACHE_ENTRIES];
+    uint32_t last_used[TOKEN_CACHE_ENTRIES];
+    uint32_t clock;
+} TokenCache;
+
+static TokenCache G_token_cache;
+
+static bool token_cache_match(const void* entry, const void* mint_address) {
+    return pubkeys_equal(&((const TokenCacheEntry*) entry)->mint_address, mint_address);
+}
+
+void token_cache_reset() {
+    const LruCache cache = LRU_CACHE(G_token_cache, token_cache_match);
+    lru_cache_reset(&cache);
+}
+
+int token_cache_insert(const Pubkey* mint_address, const char* symbol, size_t symbol_length) {
+    BAIL_IF(mint_address == NULL || symbol == NULL);
+    BAIL_IF(symbol_length == 0 || symbol_length > TOKEN_SYMBOL_MAX_LENGTH);
+    for (size_t i = 0; i < symbol_length; i++) {
+        // Printable ASCII only, the symbol is displayed verbatim
+        BAIL_IF(symbol[i] < 0x21 || symbol[i] > 0x7e);
+    }
+
+    const LruCache cache = LRU_CACHE(G_token_cache, token_cache_match);
+    TokenCacheEntry* entry = lru_cache_claim(&cache, mint_address);
+    memcpy(&entry->mint_address, mint_address, PUBKEY_SIZE);
+    memcpy(entry->symbol, symbol, symbol_length);
+    return 0;
+}
+
+const TokenCacheEntry* token_cache_lookup(const Pubkey* mint_address) {
+    const LruCache cache = LRU_CACHE(G_token_cache, token_cache_match);
+    return lru_cache_lookup(&cache, mint_address);
+}
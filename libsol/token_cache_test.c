@@ -0,0 +1,59 @@
+#include "common_byte_strings.h"
+#include "sol/token_cache.h"
+#include "token_info.h"
+#include "util.h"
+#include <assert.h>
+#include <stdio.h>
+
+static void make_mint(Pubkey* pubkey, uint8_t seed) {
+    for (size_t i = 0; i < PUBKEY_SIZE; i++) {
+        pubkey->data[i] = seed + i;
+    }
+}
+
+void test_token_cache_insert_lookup() {
+    token_cache_reset();
+    Pubkey mint;
+    make_mint(&mint, 1);
+
+    assert(token_cache_lookup(&mint) == NULL);
+    assert(token_cache_insert(&mint, "BONK", 4) == 0);
+
+    const TokenCacheEntry* entry = token_cache_lookup(&mint);
+    assert(entry != NULL);
+    assert_string_equal(entry->symbol, "BONK");
+    assert_pubkey_equal(&entry->mint_address, &mint);
+}
+
+void test_token_cache_rejects_invalid_symbols() {
+    token_cache_reset();
+    Pubkey mint;
+    make_mint(&mint, 1);
+
+    assert(token_cache_insert(&mint, "", 0) != 0);
+    assert(token_cache_insert(&mint, "TOOLONGSYM", 10) != 0);
+    assert(token_cache_insert(&mint, "BAD SYM", 7) != 0);
+    assert(token_cache_insert(&mint, "BAD\n", 4) != 0);
+    assert(token_cache_lookup(&mint) == NULL);
+}
+
+void test_get_token_symbol_prefers_cache() {
+    token_cache_reset();
+    Pubkey unknown = {{BYTES32_BS58_2}};
+    assert_string_equal(get_token_symbol(&unknown), "???");
+
+    assert(token_cache_insert(&unknown, "CACHED", 6) == 0);
+    assert_string_equal(get_token_symbol(&unknown), "CACHED");
+
+    token_cache_reset();
+    assert_string_equal(get_token_symbol(&unknown), "???");
+}
+
+int main() {
+    test_token_cache_insert_lookup();
+    test_token_cache_rejects_invalid_symbols();
+    test_get_token_symbol_prefers_cache();
+
+    printf("passed\n");
+    return 0;
+}
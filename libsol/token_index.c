@@ -0,0 +1,115 @@
+#include "sol/token_index.h"
+#include "util.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define TOKEN_INDEX_MAGIC_LENGTH  8
+#define TOKEN_INDEX_HEADER_LENGTH 16
+
+static uint32_t read_u32_le(const uint8_t* data) {
+    return (uint32_t) data[0] | ((uint32_t) data[1] << 8) | ((uint32_t) data[2] << 16) |
+           ((uint32_t) data[3] << 24);
+}
+
+static int token_index_validate(const uint8_t* data, size_t length, size_t* count) {
+    BAIL_IF(length < TOKEN_INDEX_HEADER_LENGTH);
+    BAIL_IF(memcmp(data, TOKEN_INDEX_MAGIC, TOKEN_INDEX_MAGIC_LENGTH) != 0);
+    BAIL_IF(read_u32_le(data + 8) != TOKEN_INDEX_VERSION);
+
+    *count = read_u32_le(data + 12);
+    BAIL_IF(length - TOKEN_INDEX_HEADER_LENGTH != *count * sizeof(TokenIndexRecord));
+    return 0;
+}
+
+int token_index_open(const char* path, TokenIndex* index) {
+    BAIL_IF(path == NULL || index == NULL);
+    explicit_bzero(index, sizeof(*index));
+
+    const int fd = open(path, O_RDONLY);
+    BAIL_IF(fd < 0);
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < TOKEN_INDEX_HEADER_LENGTH) {
+        close(fd);
+        return 1;
+    }
+    const size_t length = (size_t) st.st_size;
+    void* mapping = mmap(NULL, length, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping stays valid once the descriptor is closed
+    close(fd);
+    BAIL_IF(mapping == MAP_FAILED);
+
+    size_t count = 0;
+    if (token_index_validate(mapping, length, &count) != 0) {
+        munmap(mapping, length);
+        return 1;
+    }
+
+    index->records =
+        (const TokenIndexRecord*) ((const uint8_t*) mapping + TOKEN_INDEX_HEADER_LENGTH);
+    index->count = count;
+    index->mapping = mapping;
+    index->mapping_length = length;
+    return 0;
+}
+
+void token_index_close(TokenIndex* index) {
+    if (index == NULL) {
+        return;
+    }
+    if (index->mapping != NULL) {
+        munmap((void*) (uintptr_t) index->mapping, index->mapping_length);
+    }
+    explicit_bzero(index, sizeof(*index));
+}
+
+// Leading eight bytes of a mint as an integer that orders like memcmp()
+static uint64_t mint_prefix(const Pubkey* mint_address) {
+    uint64_t prefix = 0;
+    for (size_t i = 0; i < sizeof(prefix); i++) {
+        prefix = (prefix << 8) | mint_address->data[i];
+    }
+    return prefix;
+}
+
+const TokenIndexRecord* token_index_lookup(const TokenIndex* index, const Pubkey* mint_address) {
+    const TokenIndexRecord* records = index->records;
+    const size_t count = index->count;
+    const uint64_t key_prefix = mint_prefix(mint_address);
+
+    // Descend the implicit tree (children of node k are 2k and 2k+1, 1-based)
+    // turning right whenever the node is less than the key. The comparison
+    // feeds the index arithmetic instead of a branch, and the full compare is
+    // only needed when the leading bytes tie, which random mints rarely do.
+    size_t k = 1;
+    while (k <= count) {
+        // Grandchildren are contiguous, fetch them while this level resolves
+        __builtin_prefetch(records + 4 * k - 1);
+        const TokenIndexRecord* node = &records[k - 1];
+        const uint64_t node_prefix = mint_prefix(&node->mint_address);
+        const bool less =
+            node_prefix != key_prefix
+                ? node_prefix < key_prefix
+                : memcmp(&node->mint_address, mint_address, PUBKEY_SIZE) < 0;
+        k = 2 * k + less;
+    }
+    // Strip the trailing right turns plus the last left turn, which leaves the
+    // lower bound of the key, or 0 if every node is less than it
+    k >>= __builtin_ffsll(~(long long) k);
+
+    if (k == 0 || memcmp(&records[k - 1].mint_address, mint_address, PUBKEY_SIZE) != 0) {
+        return NULL;
+    }
+    return &records[k - 1];
+}
+
+const char* token_index_get_symbol(const Pubkey* mint_address, const void* context) {
+    const TokenIndexRecord* record = token_index_lookup(context, mint_address);
+    // Records are not validated at open time, never hand out an unterminated string
+    if (record == NULL || record->symbol[sizeof(record->symbol) - 1] != '\0') {
+        return NULL;
+    }
+    return record->symbol;
+}
@@ -0,0 +1,107 @@
+#include "bench.h"
+#include "sol/token_index.h"
+#include "util.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define RECORDS    1000000
+#define ITERATIONS 2000000
+
+static uint64_t xorshift64(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static void random_mint(Pubkey* mint, uint64_t* state) {
+    for (size_t j = 0; j < PUBKEY_SIZE; j += sizeof(uint64_t)) {
+        const uint64_t word = xorshift64(state);
+        memcpy(&mint->data[j], &word, sizeof(word));
+    }
+}
+
+static int compare_records(const void* a, const void* b) {
+    return memcmp(a, b, PUBKEY_SIZE);
+}
+
+static size_t eytzinger_fill(TokenIndexRecord* layout,
+                             const TokenIndexRecord* sorted,
+                             size_t position,
+                             size_t k) {
+    if (k <= RECORDS) {
+        position = eytzinger_fill(layout, sorted, position, 2 * k);
+        layout[k - 1] = sorted[position++];
+        position = eytzinger_fill(layout, sorted, position, 2 * k + 1);
+    }
+    return position;
+}
+
+// Same layout as util/gen-token-index.py, without going through base58
+static void write_index(const char* path) {
+    TokenIndexRecord* sorted = calloc(RECORDS, sizeof(TokenIndexRecord));
+    TokenIndexRecord* layout = calloc(RECORDS, sizeof(TokenIndexRecord));
+    uint64_t state = 0x9e3779b97f4a7c15ull;
+    for (size_t i = 0; i < RECORDS; i++) {
+        random_mint(&sorted[i].mint_address, &state);
+        snprintf(sorted[i].symbol, sizeof(sorted[i].symbol), "T%zu", i);
+    }
+    qsort(sorted, RECORDS, sizeof(TokenIndexRecord), compare_records);
+    eytzinger_fill(layout, sorted, 0, 1);
+
+    const uint32_t header[2] = {TOKEN_INDEX_VERSION, RECORDS};
+    FILE* file = fopen(path, "wb");
+    fwrite(TOKEN_INDEX_MAGIC, 1, 8, file);
+    fwrite(header, sizeof(header), 1, file);
+    fwrite(layout, sizeof(TokenIndexRecord), RECORDS, file);
+    fclose(file);
+    free(sorted);
+    free(layout);
+}
+
+static double bench_lookup(const TokenIndex* index, const Pubkey* keys, size_t count) {
+    const uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        bench_do_not_optimize(token_index_lookup(index, &keys[i % count]));
+    }
+    return (double) (bench_now_ns() - start) / ITERATIONS;
+}
+
+#define KEYS 4096
+
+int main() {
+    char path[] = "/tmp/token_index_bench_XXXXXX";
+    const int fd = mkstemp(path);
+    if (fd < 0) {
+        return 1;
+    }
+    close(fd);
+    write_index(path);
+
+    TokenIndex index;
+    const uint64_t open_start = bench_now_ns();
+    if (token_index_open(path, &index) != 0) {
+        unlink(path);
+        return 1;
+    }
+    const double open_us = (double) (bench_now_ns() - open_start) / 1000;
+
+    static Pubkey hit_keys[KEYS];
+    static Pubkey miss_keys[KEYS];
+    uint64_t state = 0x2545f4914f6cdd1dull;
+    for (size_t i = 0; i < KEYS; i++) {
+        hit_keys[i] = index.records[xorshift64(&state) % RECORDS].mint_address;
+        random_mint(&miss_keys[i], &state);
+    }
+
+    printf("%zu records, open %.1f us\n", index.count, open_us);
+    printf("%-8s %9.1f ns\n", "hit", bench_lookup(&index, hit_keys, KEYS));
+    printf("%-8s %9.1f ns\n", "miss", bench_lookup(&index, miss_keys, KEYS));
+
+    token_index_close(&index);
+    unlink(path);
+    return 0;
+}
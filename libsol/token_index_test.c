@@ -0,0 +1,147 @@
+#include "common_byte_strings.h"
+#include "sol/token_index.h"
+#include "token_info.h"
+#include "util.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define MAX_RECORDS 40
+
+// Even seeds only, so that odd seeds are guaranteed misses
+static void make_mint(Pubkey* pubkey, uint8_t seed) {
+    memset(pubkey->data, 0x5a, PUBKEY_SIZE);
+    pubkey->data[0] = seed;
+}
+
+static size_t eytzinger_fill(TokenIndexRecord* layout,
+                             const TokenIndexRecord* sorted,
+                             size_t count,
+                             size_t position,
+                             size_t k) {
+    if (k <= count) {
+        position = eytzinger_fill(layout, sorted, count, position, 2 * k);
+        layout[k - 1] = sorted[position++];
+        position = eytzinger_fill(layout, sorted, count, position, 2 * k + 1);
+    }
+    return position;
+}
+
+static void write_index(const char* path,
+                        const char* magic,
+                        uint32_t version,
+                        uint32_t declared_count,
+                        size_t count) {
+    TokenIndexRecord sorted[MAX_RECORDS] = {0};
+    TokenIndexRecord layout[MAX_RECORDS] = {0};
+    for (size_t i = 0; i < count; i++) {
+        make_mint(&sorted[i].mint_address, (uint8_t) (2 * i + 2));
+        snprintf(sorted[i].symbol, sizeof(sorted[i].symbol), "TKN%zu", i);
+        sorted[i].decimals = (uint8_t) i;
+    }
+    eytzinger_fill(layout, sorted, count, 0, 1);
+
+    FILE* file = fopen(path, "wb");
+    assert(file != NULL);
+    const uint8_t header[8] = {version,
+                               version >> 8,
+                               version >> 16,
+                               version >> 24,
+                               declared_count,
+                               declared_count >> 8,
+                               declared_count >> 16,
+                               declared_count >> 24};
+    assert(fwrite(magic, 1, 8, file) == 8);
+    assert(fwrite(header, 1, sizeof(header), file) == sizeof(header));
+    assert(fwrite(layout, sizeof(TokenIndexRecord), count, file) == count);
+    assert(fclose(file) == 0);
+}
+
+static char index_path[] = "/tmp/token_index_test_XXXXXX";
+
+void test_token_index_record_size() {
+    assert(sizeof(TokenIndexRecord) == 48);
+}
+
+void test_token_index_lookup_every_size() {
+    for (size_t count = 0; count <= MAX_RECORDS; count++) {
+        write_index(index_path, TOKEN_INDEX_MAGIC, TOKEN_INDEX_VERSION, count, count);
+
+        TokenIndex index;
+        assert(token_index_open(index_path, &index) == 0);
+        assert(index.count == count);
+
+        for (size_t i = 0; i < count; i++) {
+            Pubkey mint;
+            make_mint(&mint, (uint8_t) (2 * i + 2));
+            const TokenIndexRecord* record = token_index_lookup(&index, &mint);
+            assert(record != NULL);
+            assert_pubkey_equal(&record->mint_address, &mint);
+            assert(record->decimals == i);
+        }
+        // Below, between and above every present mint
+        for (size_t i = 0; i <= count; i++) {
+            Pubkey mint;
+            make_mint(&mint, (uint8_t) (2 * i + 1));
+            assert(token_index_lookup(&index, &mint) == NULL);
+        }
+
+        token_index_close(&index);
+        assert(index.records == NULL);
+    }
+}
+
+void test_token_index_rejects_bad_files() {
+    TokenIndex index;
+
+    write_index(index_path, "SOLTKIDY", TOKEN_INDEX_VERSION, 4, 4);
+    assert(token_index_open(index_path, &index) != 0);
+
+    write_index(index_path, TOKEN_INDEX_MAGIC, TOKEN_INDEX_VERSION + 1, 4, 4);
+    assert(token_index_open(index_path, &index) != 0);
+
+    // Declared count does not match the file size
+    write_index(index_path, TOKEN_INDEX_MAGIC, TOKEN_INDEX_VERSION, 5, 4);
+    assert(token_index_open(index_path, &index) != 0);
+
+    assert(token_index_open("/nonexistent/token_index", &index) != 0);
+}
+
+void test_get_token_symbol_uses_provider() {
+    write_index(index_path, TOKEN_INDEX_MAGIC, TOKEN_INDEX_VERSION, 3, 3);
+    TokenIndex index;
+    assert(token_index_open(index_path, &index) == 0);
+
+    Pubkey indexed;
+    make_mint(&indexed, 4);
+    Pubkey unknown = {{BYTES32_BS58_2}};
+    Pubkey registered = TOKEN_REGISTRY[0].mint_address;
+
+    assert_string_equal(get_token_symbol(&indexed), "???");
+
+    set_token_symbol_provider(token_index_get_symbol, &index);
+    assert_string_equal(get_token_symbol(&indexed), "TKN1");
+    assert_string_equal(get_token_symbol(&unknown), "???");
+    // The compiled-in registry still wins
+    assert_string_equal(get_token_symbol(&registered), TOKEN_REGISTRY[0].symbol);
+
+    set_token_symbol_provider(NULL, NULL);
+    assert_string_equal(get_token_symbol(&indexed), "???");
+    token_index_close(&index);
+}
+
+int main() {
+    const int fd = mkstemp(index_path);
+    assert(fd >= 0);
+    close(fd);
+
+    test_token_index_record_size();
+    test_token_index_lookup_every_size();
+    test_token_index_rejects_bad_files();
+    test_get_token_symbol_uses_provider();
+
+    unlink(index_path);
+    printf("passed\n");
+    return 0;
+}
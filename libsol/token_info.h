@@ -7,6 +7,10 @@ typedef struct TokenInfo {
     char symbol[10];
 } TokenInfo;
 
+// Ordered by perfect hash slot, see token_registry.txt
 extern TokenInfo const TOKEN_REGISTRY[];
+extern uint8_t const TOKEN_REGISTRY_DISPLACEMENTS[];
+// Slots of TOKEN_REGISTRY in the order of token_registry.txt
+extern uint8_t const TOKEN_REGISTRY_FILE_ORDER[];
 
 const char* get_token_symbol(const Pubkey* mint_address);
@@ -0,0 +1,71 @@
+#include "bench.h"
+#include "token_info.h"
+#include "token_registry.h"
+#include "util.h"
+#include <stdio.h>
+
+#define ITERATIONS 2000000
+
+// The lookup get_token_symbol() used before TOKEN_REGISTRY was generated as
+// a perfect hash, kept here as the baseline
+static const char* linear_get_token_symbol(const Pubkey* mint_address) {
+    for (size_t i = 0; i < TOKEN_REGISTRY_LENGTH; i++) {
+        const TokenInfo* info = &TOKEN_REGISTRY[i];
+
+        if (memcmp(&(info->mint_address), mint_address, PUBKEY_SIZE) == 0) {
+            return info->symbol;
+        }
+    }
+    return "???";
+}
+
+static uint64_t xorshift64(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+#define MISS_KEYS 256
+static Pubkey miss_keys[MISS_KEYS];
+
+static void init_miss_keys(void) {
+    uint64_t state = 0x2545f4914f6cdd1dull;
+    for (size_t i = 0; i < MISS_KEYS; i++) {
+        for (size_t j = 0; j < PUBKEY_SIZE; j += sizeof(uint64_t)) {
+            const uint64_t word = xorshift64(&state);
+            memcpy(&miss_keys[i].data[j], &word, sizeof(word));
+        }
+    }
+}
+
+typedef const char* (*lookup_fn)(const Pubkey*);
+
+static double bench_lookup(lookup_fn lookup, const Pubkey* keys, size_t stride, size_t count) {
+    const uint64_t start = bench_now_ns();
+    for (size_t i = 0; i < ITERATIONS; i++) {
+        const Pubkey* key = (const Pubkey*) ((const uint8_t*) keys + (i % count) * stride);
+        bench_do_not_optimize(lookup(key));
+    }
+    return (double) (bench_now_ns() - start) / ITERATIONS;
+}
+
+int main() {
+    init_miss_keys();
+
+    const Pubkey* hit_keys = &TOKEN_REGISTRY[0].mint_address;
+    const size_t hit_stride = sizeof(TokenInfo);
+
+    printf("%-8s %12s %12s\n", "lookup", "linear", "perfect");
+    printf("%-8s %9.1f ns %9.1f ns\n",
+           "hit",
+           bench_lookup(linear_get_token_symbol, hit_keys, hit_stride, TOKEN_REGISTRY_LENGTH),
+           bench_lookup(get_token_symbol, hit_keys, hit_stride, TOKEN_REGISTRY_LENGTH));
+    printf("%-8s %9.1f ns %9.1f ns\n",
+           "miss",
+           bench_lookup(linear_get_token_symbol, miss_keys, sizeof(Pubkey), MISS_KEYS),
+           bench_lookup(get_token_symbol, miss_keys, sizeof(Pubkey), MISS_KEYS));
+    return 0;
+}
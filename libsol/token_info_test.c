@@ -1,6 +1,7 @@
 #include "common_byte_strings.h"
 #include "util.h"
 #include "token_info.h"
+#include "token_registry.h"
 #include <assert.h>
 #include <stdio.h>
 
@@ -29,10 +30,31 @@ void test_get_token_symbol_SOL() {
     assert_string_equal(symbol, "SOL");
 }
 
+void test_get_token_symbol_every_registry_entry() {
+    for (size_t i = 0; i < TOKEN_REGISTRY_LENGTH; i++) {
+        const TokenInfo* info = &TOKEN_REGISTRY[i];
+        const char* symbol = get_token_symbol(&info->mint_address);
+
+        assert(symbol == info->symbol);
+    }
+}
+
+void test_get_token_symbol_shared_prefix_unknown() {
+    // Same 4-byte hash prefix as USDC, so it lands on the USDC slot
+    Pubkey pubkey = {{0xc6, 0xfa, 0x7a, 0xf3, 0xbe, 0xdb, 0xad, 0x3a, 0x3d, 0x65, 0xf3,
+                      0x6a, 0xab, 0xc9, 0x74, 0x31, 0xb1, 0xbb, 0xe4, 0xc2, 0xd2, 0xf6,
+                      0xe0, 0xe4, 0x7c, 0xa6, 0x02, 0x03, 0x45, 0x2f, 0x5d, 0x62}};
+    const char* symbol = get_token_symbol(&pubkey);
+
+    assert_string_equal(symbol, "???");
+}
+
 int main() {
     test_get_token_symbol_unknown();
     test_get_token_symbol_SOL();
     test_get_token_symbol_USDC();
+    test_get_token_symbol_every_registry_entry();
+    test_get_token_symbol_shared_prefix_unknown();
 
     printf("passed\n");
     return 0;
@@ -0,0 +1,8 @@
+// Generated by util/gen-token-registry.py from token_registry.txt, do not edit.
+#pragma once
+
+#define TOKEN_REGISTRY_LENGTH      96
+#define TOKEN_REGISTRY_BUCKET_BITS 5
+#define TOKEN_REGISTRY_HASH_M1     0x9e3779b1u
+#define TOKEN_REGISTRY_HASH_M2     0x85ebca6bu
+#define TOKEN_REGISTRY_HASH_D      0xc2b2ae35u
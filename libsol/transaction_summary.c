@@ -18,7 +18,22 @@ struct SummaryItem {
     };
 };
 
+// Set when a printer was refused an item, its transaction cannot be shown
+// whole so finalization fails
+static bool G_transaction_summary_overflow;
+
+static bool summary_item_is_available(const SummaryItem* item) {
+    if (item == NULL) {
+        G_transaction_summary_overflow = true;
+        return false;
+    }
+    return true;
+}
+
 void summary_item_set_amount(SummaryItem* item, const char* title, uint64_t value) {
+    if (!summary_item_is_available(item)) {
+        return;
+    }
     item->kind = SummaryItemAmount;
     item->title = title;
     item->u64 = value;
@@ -29,6 +44,9 @@ void summary_item_set_token_amount(SummaryItem* item,
                                    uint64_t value,
                                    const char* symbol,
                                    uint8_t decimals) {
+    if (!summary_item_is_available(item)) {
+        return;
+    }
     item->kind = SummaryItemTokenAmount;
     item->title = title;
     item->token_amount.value = value;
@@ -37,30 +55,45 @@ void summary_item_set_token_amount(SummaryItem* item,
 }
 
 void summary_item_set_i64(SummaryItem* item, const char* title, int64_t value) {
+    if (!summary_item_is_available(item)) {
+        return;
+    }
     item->kind = SummaryItemI64;
     item->title = title;
     item->i64 = value;
 }
 
 void summary_item_set_u64(SummaryItem* item, const char* title, uint64_t value) {
+    if (!summary_item_is_available(item)) {
+        return;
+    }
     item->kind = SummaryItemU64;
     item->title = title;
     item->u64 = value;
 }
 
 void summary_item_set_pubkey(SummaryItem* item, const char* title, const Pubkey* value) {
+    if (!summary_item_is_available(item)) {
+        return;
+    }
     item->kind = SummaryItemPubkey;
     item->title = title;
     item->pubkey = value;
 }
 
 void summary_item_set_hash(SummaryItem* item, const char* title, const Hash* value) {
+    if (!summary_item_is_available(item)) {
+        return;
+    }
     item->kind = SummaryItemHash;
     item->title = title;
     item->hash = value;
 }
 
 void summary_item_set_sized_string(SummaryItem* item, const char* title, const SizedString* value) {
+    if (!summary_item_is_available(item)) {
+        return;
+    }
     item->kind = SummaryItemSizedString;
     item->title = title;
     item->sized_string.length = value->length;
@@ -68,12 +101,18 @@ void summary_item_set_sized_string(SummaryItem* item, const char* title, const S
 }
 
 void summary_item_set_string(SummaryItem* item, const char* title, const char* value) {
+    if (!summary_item_is_available(item)) {
+        return;
+    }
     item->kind = SummaryItemString;
     item->title = title;
     item->string = value;
 }
 
 void summary_item_set_timestamp(SummaryItem* item, const char* title, int64_t value) {
+    if (!summary_item_is_available(item)) {
+        return;
+    }
     item->kind = SummaryItemTimestamp;
     item->title = title;
     item->i64 = value;
@@ -94,6 +133,7 @@ char G_transaction_summary_text[TEXT_BUFFER_LENGTH];
 
 void transaction_summary_reset() {
     explicit_bzero(&G_transaction_summary, sizeof(TransactionSummary));
+    G_transaction_summary_overflow = false;
     explicit_bzero(&G_transaction_summary_title, TITLE_SIZE);
     explicit_bzero(&G_transaction_summary_text, TEXT_BUFFER_LENGTH);
 }
@@ -149,6 +189,7 @@ int transaction_summary_set_fee_payer_pubkey(const Pubkey* pubkey) {
 
 static int transaction_summary_update_display_for_item(const SummaryItem* item,
                                                        enum DisplayFlags flags) {
+    LIBSOL_STATS_ADD(summary_item_renders, 1);
     switch (item->kind) {
         case SummaryItemNone:
             return 1;
@@ -269,7 +310,7 @@ int transaction_summary_finalize(enum SummaryItemKind* item_kinds, size_t* item_
     const TransactionSummary* summary = &G_transaction_summary;
     size_t index = 0;
 
-    if (summary->primary.kind == SummaryItemNone) {
+    if (summary->primary.kind == SummaryItemNone || G_transaction_summary_overflow) {
         return 1;
     }
 
@@ -1,4 +1,5 @@
 #include "common_byte_strings.h"
+#include "sol/message.h"
 #include "sol/transaction_summary.h"
 #include "transaction_summary.c"
 #include <assert.h>
@@ -330,6 +331,15 @@ void test_transaction_summary_finalize() {
     assert(transaction_summary_finalize(kinds, &num_kinds) == 0);
     assert(num_kinds == (2 + NUM_GENERAL_ITEMS + 2));
     assert_kinds_array(kinds, num_kinds);
+
+    // An item past the last general one fails, rather than being dropped
+    item = transaction_summary_general_item();
+    assert(item == NULL);
+    summary_item_set_u64(item, "item", 42);
+    assert(transaction_summary_finalize(kinds, &num_kinds) == 1);
+    transaction_summary_reset();
+    summary_item_set_u64(transaction_summary_primary_item(), "item", 42);
+    assert(transaction_summary_finalize(kinds, &num_kinds) == 0);
 }
 
 void test_repro_unrecognized_format_reverse_nav_hash_corruption_bug() {
@@ -374,6 +384,83 @@ void test_repro_unrecognized_format_reverse_nav_hash_corruption_bug() {
     assert_transaction_summary_display(primary_title, primary_text);
 }
 
+// A stake account created with a seed, with a lockup, then delegated, with a
+// compute unit price, has more items than the summary holds in expert mode.
+// The printer was handed a NULL item and wrote through it, now the
+// transaction is refused
+void test_repro_create_stake_with_seed_and_delegate_overflow_bug() {
+    // clang-format off
+    uint8_t message[] = {
+        2, 0, 8,
+        11,
+            226, 227, 159, 49, 174, 54, 249, 204, 163, 243, 214, 226, 72, 231, 254, 47, 54, 154, 232, 93, 76, 4, 41, 84, 228, 188, 210, 93, 163, 211, 181, 118,
+            147, 11, 169, 119, 49, 240, 218, 2, 64, 0, 238, 67, 133, 163, 239, 139, 225, 13, 87, 18, 112, 254, 144, 118, 171, 151, 140, 122, 64, 17, 230, 66,
+            160, 209, 181, 140, 74, 150, 96, 248, 38, 191, 49, 248, 172, 163, 99, 167, 79, 223, 32, 215, 58, 177, 147, 143, 129, 151, 59, 99, 20, 145, 156, 145,
+            6, 167, 213, 23, 25, 44, 92, 81, 33, 140, 201, 76, 61, 74, 241, 127, 88, 218, 238, 8, 155, 161, 253, 68, 227, 219, 217, 138, 0, 0, 0, 0,
+            5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+            6, 167, 213, 23, 24, 199, 116, 201, 40, 86, 99, 152, 105, 29, 94, 182, 139, 94, 184, 163, 155, 75, 109, 92, 115, 85, 91, 33, 0, 0, 0, 0,
+            6, 167, 213, 23, 25, 53, 132, 208, 254, 237, 155, 179, 67, 29, 19, 32, 107, 229, 68, 40, 27, 87, 184, 86, 108, 197, 55, 95, 244, 0, 0, 0,
+            6, 161, 216, 23, 165, 2, 5, 11, 104, 7, 145, 230, 206, 109, 184, 142, 30, 91, 113, 80, 246, 31, 198, 121, 10, 78, 180, 209, 0, 0, 0, 0,
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            6, 161, 216, 23, 145, 55, 84, 42, 152, 52, 55, 189, 254, 42, 122, 178, 85, 127, 83, 92, 138, 120, 114, 43, 104, 164, 157, 192, 0, 0, 0, 0,
+            3, 6, 70, 111, 229, 33, 23, 50, 255, 236, 173, 186, 114, 195, 155, 231, 188, 140, 229, 187, 197, 247, 18, 107, 44, 67, 155, 58, 64, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        4,
+            // compute budget unit price
+            10,
+            0,
+            9,
+                3, 16, 0, 0, 0, 0, 0, 0, 0,
+            // system create account with seed
+            8,
+            3,
+                1, 2, 1,
+            124,
+                3, 0, 0, 0,
+                147, 11, 169, 119, 49, 240, 218, 2, 64, 0, 238, 67, 133, 163, 239, 139, 225, 13, 87, 18, 112, 254, 144, 118, 171, 151, 140, 122, 64, 17, 230, 66,
+                32, 0, 0, 0, 0, 0, 0, 0,
+                    115, 101, 101, 100, 115, 101, 101, 100, 115, 101, 101, 100, 115, 101, 101, 100, 115, 101, 101, 100, 115, 101, 101, 100, 115, 101, 101, 100, 115, 101, 101, 100,
+                42, 0, 0, 0, 0, 0, 0, 0,
+                200, 0, 0, 0, 0, 0, 0, 0,
+                6, 161, 216, 23, 145, 55, 84, 42, 152, 52, 55, 189, 254, 42, 122, 178, 85, 127, 83, 92, 138, 120, 114, 43, 104, 164, 157, 192, 0, 0, 0, 0,
+            // stake initialize, with a lockup and custodian
+            9,
+            2,
+                2, 3,
+            116,
+                0, 0, 0, 0,
+                148, 11, 169, 119, 49, 240, 218, 2, 64, 0, 238, 67, 133, 163, 239, 139, 225, 13, 87, 18, 112, 254, 144, 118, 171, 151, 140, 122, 64, 17, 230, 66,
+                147, 11, 169, 119, 49, 240, 218, 2, 64, 0, 238, 67, 133, 163, 239, 139, 225, 13, 87, 18, 112, 254, 144, 118, 171, 151, 140, 122, 64, 17, 230, 66,
+                1, 0, 0, 0, 0, 0, 0, 0,
+                1, 0, 0, 0, 0, 0, 0, 0,
+                7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+            // stake delegate
+            9,
+            6,
+                2, 4, 5, 6, 7, 1,
+            4,
+                2, 0, 0, 0
+    };
+    // clang-format on
+    PrintConfig print_config = {.expert_mode = true};
+    Parser parser = {message, sizeof(message)};
+    assert(parse_message_header(&parser, &print_config.header) == 0);
+
+    transaction_summary_reset();
+    assert(process_message_body(parser.buffer, parser.buffer_length, &print_config) == 0);
+    transaction_summary_set_fee_payer_pubkey(&print_config.header.pubkeys[0]);
+    enum SummaryItemKind kinds[MAX_TRANSACTION_SUMMARY_ITEMS];
+    size_t num_kinds;
+    assert(transaction_summary_finalize(kinds, &num_kinds) == 1);
+
+    // Outside expert mode it fits
+    print_config.expert_mode = false;
+    transaction_summary_reset();
+    assert(process_message_body(parser.buffer, parser.buffer_length, &print_config) == 0);
+    transaction_summary_set_fee_payer_pubkey(&print_config.header.pubkeys[0]);
+    assert(transaction_summary_finalize(kinds, &num_kinds) == 0);
+}
+
 int main() {
     test_summary_item_setters();
     test_summary_item_as_unused();
@@ -385,6 +472,7 @@ int main() {
     test_transaction_summary_finalize();
 
     test_repro_unrecognized_format_reverse_nav_hash_corruption_bug();
+    test_repro_create_stake_with_seed_and_delegate_overflow_bug();
 
     printf("passed\n");
     return 0;
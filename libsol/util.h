@@ -1,11 +1,15 @@
 #pragma once
+#include "sol/stats.h"
 #include <string.h>
 
 #define ARRAY_LEN(a) (sizeof(a) / sizeof((a)[0]))
-#define BAIL_IF(x)           \
-    do {                     \
-        int err = x;         \
-        if (err) return err; \
+#define BAIL_IF(x)               \
+    do {                         \
+        int err = x;             \
+        if (err) {               \
+            LIBSOL_STATS_BAIL(); \
+            return err;          \
+        }                        \
     } while (0)
 #define MIN(a, b) ((a) < (b) ? (a) : (b));
 
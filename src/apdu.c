@@ -1,6 +1,111 @@
 #include "apdu.h"
 #include "utils.h"
 
+static bool is_sign_instruction(uint8_t instruction) {
+    return instruction == InsDeprecatedSignMessage || instruction == InsSignMessage ||
+           instruction == InsSignOffchainMessage || instruction == InsSignMessageBatch;
+}
+
+// Transactions may be sent with their well-known keys compressed
+static bool accepts_compression(uint8_t instruction) {
+    return instruction == InsSignMessage || instruction == InsSignMessageBatch;
+}
+
+// Header of chunks sent with P2_OFFSET: transfer id, then the offset of the
+// chunk data within the data of the transfer (u16 BE)
+#define OFFSET_CHUNK_HEADER_LENGTH 3
+
+/**
+ * Place a P2_OFFSET chunk within its transfer.
+ *
+ * A chunk of another transfer than the one in progress starts a new one if it
+ * is at offset 0, and is stale otherwise. Within the transfer in progress the
+ * bytes already committed are dropped from the chunk, so that a duplicate
+ * changes nothing, and a chunk past the committed length is dropped whole:
+ * the host resends from the acknowledged length. The transfer id and
+ * committed length are kept once the transfer completed, so that a repeated
+ * last chunk is told apart from a new transfer.
+ *
+ * @param[in,out] header
+ *   Header of the chunk, its data is trimmed to the bytes to commit.
+ * @param[in] apdu_command
+ *   Command in progress.
+ * @param[out] transfer_id
+ *   Transfer of the chunk.
+ * @param[out] first_data_chunk
+ *   Whether the chunk starts a new transfer.
+ *
+ * @return zero on success, ApduReplySuccess if the chunk is to be ignored,
+ *   either stale or of the transfer that completed, ApduReply error code
+ *   otherwise.
+ *
+ */
+static int seek_offset_chunk(ApduHeader* header,
+                             const ApduCommand* apdu_command,
+                             uint8_t* transfer_id,
+                             bool* first_data_chunk) {
+    if (header->deprecated_host || (header->p2 & P2_EXTEND)) {
+        return ApduReplySdkNotSupported;
+    }
+    if (header->data_length <= OFFSET_CHUNK_HEADER_LENGTH) {
+        return ApduReplySolanaInvalidMessageSize;
+    }
+    *transfer_id = header->data[0];
+    const size_t offset = U2BE(header->data, 1);
+    header->data += OFFSET_CHUNK_HEADER_LENGTH;
+    header->data_length -= OFFSET_CHUNK_HEADER_LENGTH;
+
+    const bool same_transfer = apdu_command->instruction == header->instruction &&
+                               (apdu_command->p2 & P2_OFFSET) &&
+                               apdu_command->transfer_id == *transfer_id;
+    if (same_transfer && apdu_command->state == ApduStatePayloadComplete) {
+        return ApduReplySuccess;
+    }
+    *first_data_chunk = !same_transfer || apdu_command->state != ApduStatePayloadInProgress;
+    if (*first_data_chunk) {
+        return offset == 0 ? 0 : ApduReplySuccess;
+    }
+
+    const size_t committed = apdu_command->transfer_committed;
+    if (offset > committed || offset + header->data_length <= committed) {
+        header->data = NULL;
+        header->data_length = 0;
+    } else {
+        header->data += committed - offset;
+        header->data_length -= committed - offset;
+    }
+    return 0;
+}
+
+/**
+ * Complete a command carried whole by a single APDU, its data left for the
+ * handler to interpret.
+ *
+ * @param[in] header
+ *   Header of the APDU.
+ * @param[out] apdu_command
+ *   Command to replace.
+ *
+ * @return zero on success, ApduReply error code otherwise.
+ *
+ */
+static int complete_single_apdu(const ApduHeader* header, ApduCommand* apdu_command) {
+    if (header->data_length > MAX_MESSAGE_LENGTH) {
+        return ApduReplySolanaInvalidMessageSize;
+    }
+    explicit_bzero(apdu_command, sizeof(ApduCommand));
+    if (header->data) {
+        memcpy(apdu_command->message, header->data, header->data_length);
+        apdu_command->message_length = header->data_length;
+    }
+    apdu_command->state = ApduStatePayloadComplete;
+    apdu_command->instruction = header->instruction;
+    apdu_command->non_confirm = (header->p1 == P1_NON_CONFIRM);
+    apdu_command->deprecated_host = header->deprecated_host;
+    apdu_command->p2 = header->p2;
+    return 0;
+}
+
 /**
  * Deserialize APDU into ApduCommand structure.
  *
@@ -11,7 +116,8 @@
  * @param[out] apdu_command
  *   Pointer to ApduCommand structure.
  *
- * @return zero on success, ApduReply error code otherwise.
+ * @return zero on success, ApduReplySuccess if the APDU is a chunk to ignore
+ *   and apdu_command was left unchanged, ApduReply error code otherwise.
  *
  */
 int apdu_handle_message(const uint8_t* apdu_message,
@@ -65,23 +171,39 @@ int apdu_handle_message(const uint8_t* apdu_message,
         case InsGetAppConfiguration:
         case InsGetPubkey:
         case InsSignMessage:
-        case InsSignOffchainMessage: {
+        case InsSignOffchainMessage:
+        case InsProvideTokenDescriptor:
+        case InsSignOffchainMessageStream:
+        case InsGetPubkeyBatch:
+        case InsSignMessageBatch:
+        case InsSetSigningPolicy: {
             // must at least hold a full modern header
             if (apdu_message_len < OFFSET_CDATA) {
                 return ApduReplySolanaInvalidMessageSize;
             }
-            // modern data may be up to 255B
-            if (apdu_message_len > UINT8_MAX + OFFSET_CDATA) {
-                return ApduReplySolanaInvalidMessageSize;
-            }
 
             header.data_length = apdu_message[OFFSET_LC];
-            if (apdu_message_len != header.data_length + OFFSET_CDATA) {
+            size_t data_offset = OFFSET_CDATA;
+            if (header.data_length == 0 && apdu_message_len > OFFSET_CDATA) {
+                // extended length, only for messages and where the buffer
+                // holds more than a short APDU
+                if (!EXTENDED_APDUS_SUPPORTED || !is_sign_instruction(header.instruction) ||
+                    apdu_message_len <= EXTENDED_OFFSET_CDATA) {
+                    return ApduReplySolanaInvalidMessageSize;
+                }
+                header.data_length = U2BE(apdu_message, OFFSET_LC + 1);
+                data_offset = EXTENDED_OFFSET_CDATA;
+            }
+            // modern data may be up to 255B, more with an extended length
+            if (header.data_length > MAX_APDU_DATA_LENGTH) {
+                return ApduReplySolanaInvalidMessageSize;
+            }
+            if (apdu_message_len != header.data_length + data_offset) {
                 return ApduReplySolanaInvalidMessageSize;
             }
 
             if (header.data_length > 0) {
-                header.data = apdu_message + OFFSET_CDATA;
+                header.data = apdu_message + data_offset;
             }
 
             header.deprecated_host = false;
@@ -96,37 +218,68 @@ int apdu_handle_message(const uint8_t* apdu_message,
     header.p2 = apdu_message[OFFSET_P2];
     // P2_EXTEND is set to signal that this APDU buffer extends, rather
     // than replaces, the current message buffer
-    const bool first_data_chunk = !(header.p2 & P2_EXTEND);
+    bool first_data_chunk = !(header.p2 & P2_EXTEND);
+    uint8_t transfer_id = 0;
 
     if (header.instruction == InsDeprecatedGetAppConfiguration ||
         header.instruction == InsGetAppConfiguration) {
         // return early if no data is expected for the command
-        explicit_bzero(apdu_command, sizeof(ApduCommand));
-        apdu_command->state = ApduStatePayloadComplete;
-        apdu_command->instruction = header.instruction;
-        apdu_command->non_confirm = (header.p1 == P1_NON_CONFIRM);
-        apdu_command->deprecated_host = header.deprecated_host;
-        return 0;
-    } else if (header.instruction == InsDeprecatedSignMessage ||
-               header.instruction == InsSignMessage ||
-               header.instruction == InsSignOffchainMessage) {
+        return complete_single_apdu(&header, apdu_command);
+    } else if (header.instruction == InsProvideTokenDescriptor ||
+               header.instruction == InsGetPubkeyBatch ||
+               header.instruction == InsSetSigningPolicy) {
+        // these fit in a single APDU and lay out their own derivation paths
+        if (!header.data || (header.p2 & (P2_EXTEND | P2_MORE))) {
+            return ApduReplySolanaInvalidMessageSize;
+        }
+        return complete_single_apdu(&header, apdu_command);
+    } else if (header.instruction == InsSignOffchainMessageStream) {
+        // streamed chunks are consumed as they arrive rather than accumulated,
+        // the handler tracks the stream across APDUs
+        if (!header.data) {
+            return ApduReplySolanaInvalidMessageSize;
+        }
+        return complete_single_apdu(&header, apdu_command);
+    } else if (is_sign_instruction(header.instruction)) {
+        if ((header.p2 & P2_COMPRESSED) && !accepts_compression(header.instruction)) {
+            return ApduReplySdkNotSupported;
+        }
+        if (header.p2 & P2_OFFSET) {
+            const int ret =
+                seek_offset_chunk(&header, apdu_command, &transfer_id, &first_data_chunk);
+            if (ret) {
+                return ret;
+            }
+        }
         if (!first_data_chunk) {
             // validate the command in progress
             if (apdu_command->state != ApduStatePayloadInProgress ||
                 apdu_command->instruction != header.instruction ||
                 apdu_command->non_confirm != (header.p1 == P1_NON_CONFIRM) ||
                 apdu_command->deprecated_host != header.deprecated_host ||
-                apdu_command->num_derivation_paths != 1) {
+                (apdu_command->p2 & (P2_SECOND_PASS | P2_COMPRESSED | P2_OFFSET)) !=
+                    (header.p2 & (P2_SECOND_PASS | P2_COMPRESSED | P2_OFFSET)) ||
+                apdu_command->num_derivation_paths == 0) {
                 return ApduReplySolanaInvalidMessage;
             }
+            // out of order or already committed, acknowledged as is
+            if ((header.p2 & P2_OFFSET) && !header.data) {
+                return 0;
+            }
         } else {
             explicit_bzero(apdu_command, sizeof(ApduCommand));
+            if (cx_sha256_init_no_throw(&apdu_command->message_hash_context) != CX_OK) {
+                return ApduReplySdkException;
+            }
         }
     } else {
         explicit_bzero(apdu_command, sizeof(ApduCommand));
     }
 
-    // read derivation path
+    // bytes of the transfer this chunk commits, derivation paths included
+    const size_t transfer_length = header.data_length;
+
+    // read derivation paths
     if (first_data_chunk) {
         if (!header.deprecated_host && header.instruction != InsGetPubkey) {
             if (!header.data_length) {
@@ -135,30 +288,35 @@ int apdu_handle_message(const uint8_t* apdu_message,
             apdu_command->num_derivation_paths = header.data[0];
             header.data++;
             header.data_length--;
-            // We only support one derivation path ATM
-            if (apdu_command->num_derivation_paths != 1) {
+            // Only transactions may have several signers, each signing once
+            const size_t max_derivation_paths =
+                header.instruction == InsSignMessage ? MAX_SIGNERS : 1;
+            if (apdu_command->num_derivation_paths < 1 ||
+                apdu_command->num_derivation_paths > max_derivation_paths) {
                 return ApduReplySolanaInvalidMessage;
             }
         } else {
             apdu_command->num_derivation_paths = 1;
         }
-        const int ret = read_derivation_path(header.data,
-                                             header.data_length,
-                                             apdu_command->derivation_path,
-                                             &apdu_command->derivation_path_length);
-        if (ret) {
-            return ret;
+        for (size_t i = 0; i < apdu_command->num_derivation_paths; i++) {
+            const int ret = read_derivation_path(header.data,
+                                                 header.data_length,
+                                                 apdu_command->derivation_paths[i],
+                                                 &apdu_command->derivation_path_lengths[i]);
+            if (ret) {
+                return ret;
+            }
+            header.data += 1 + apdu_command->derivation_path_lengths[i] * 4;
+            header.data_length -= 1 + apdu_command->derivation_path_lengths[i] * 4;
         }
-        header.data += 1 + apdu_command->derivation_path_length * 4;
-        header.data_length -= 1 + apdu_command->derivation_path_length * 4;
     }
 
     apdu_command->state = ApduStatePayloadInProgress;
     apdu_command->instruction = header.instruction;
     apdu_command->non_confirm = (header.p1 == P1_NON_CONFIRM);
     apdu_command->deprecated_host = header.deprecated_host;
-
-    // copy data to the buffer
+    apdu_command->p2 = header.p2;
+    apdu_command->transfer_id = transfer_id;
     if (header.instruction == InsDeprecatedSignMessage) {
         // deprecated signmessage had a u16 data length prefix... deal with that
         if (header.data_length < 2) {
@@ -173,14 +331,39 @@ int apdu_handle_message(const uint8_t* apdu_message,
     }
 
     if (header.data) {
-        if (apdu_command->message_length + header.data_length > MAX_MESSAGE_LENGTH) {
-            return ApduReplySolanaInvalidMessageSize;
+        uint8_t* chunk = apdu_command->message + apdu_command->message_length;
+        size_t chunk_length = header.data_length;
+        if (header.p2 & P2_COMPRESSED) {
+            // expanded as it arrives, the original message is what gets hashed
+            if (message_expander_update(&apdu_command->message_expander,
+                                        header.data,
+                                        header.data_length,
+                                        chunk,
+                                        MAX_MESSAGE_LENGTH - apdu_command->message_length,
+                                        &chunk_length) != 0) {
+                return ApduReplySolanaInvalidMessage;
+            }
+        } else {
+            if (apdu_command->message_length + header.data_length > MAX_MESSAGE_LENGTH) {
+                return ApduReplySolanaInvalidMessageSize;
+            }
+            memcpy(chunk, header.data, header.data_length);
+        }
+        apdu_command->message_length += chunk_length;
+        if (header.p2 & P2_OFFSET) {
+            apdu_command->transfer_committed += transfer_length;
         }
 
-        memcpy(apdu_command->message + apdu_command->message_length,
-               header.data,
-               header.data_length);
-        apdu_command->message_length += header.data_length;
+        // hash while the chunk is hot rather than in one pass once complete
+        if (is_sign_instruction(header.instruction) &&
+            cx_hash_no_throw(&apdu_command->message_hash_context.header,
+                             0,
+                             chunk,
+                             chunk_length,
+                             NULL,
+                             0) != CX_OK) {
+            return ApduReplySdkException;
+        }
     } else if (header.instruction != InsDeprecatedGetPubkey && header.instruction != InsGetPubkey) {
         return ApduReplySolanaInvalidMessageSize;
     }
@@ -190,6 +373,21 @@ int apdu_handle_message(const uint8_t* apdu_message,
         return 0;
     }
 
+    if ((header.p2 & P2_COMPRESSED) &&
+        message_expander_finish(&apdu_command->message_expander) != 0) {
+        return ApduReplySolanaInvalidMessage;
+    }
+
+    if (is_sign_instruction(header.instruction) &&
+        cx_hash_no_throw(&apdu_command->message_hash_context.header,
+                         CX_LAST,
+                         NULL,
+                         0,
+                         apdu_command->message_hash.data,
+                         HASH_LENGTH) != CX_OK) {
+        return ApduReplySdkException;
+    }
+
     apdu_command->state = ApduStatePayloadComplete;
 
     return 0;
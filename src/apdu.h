@@ -3,8 +3,10 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "cx.h"
 #include "globals.h"
 #include "sol/parser.h"
+#include "sol/pubkey_dictionary.h"
 
 typedef enum ApduState {
     ApduStateUninitialized = 0,
@@ -44,6 +46,7 @@ typedef enum ApduReply {
     ApduReplySolanaInvalidMessageHeader = 0x6a81,
     ApduReplySolanaInvalidMessageFormat = 0x6a82,
     ApduReplySolanaInvalidMessageSize = 0x6a83,
+    ApduReplySolanaInvalidSignature = 0x6a84,
     ApduReplySolanaSummaryFinalizeFailed = 0x6f00,
     ApduReplySolanaSummaryUpdateFailed = 0x6f01,
 
@@ -67,12 +70,27 @@ typedef struct ApduCommand {
     ApduState state;
     InstructionCode instruction;
     uint8_t num_derivation_paths;
-    uint32_t derivation_path[MAX_BIP32_PATH_LENGTH];
-    uint32_t derivation_path_length;
+    uint32_t derivation_paths[MAX_SIGNERS][MAX_BIP32_PATH_LENGTH];
+    uint32_t derivation_path_lengths[MAX_SIGNERS];
+    // Keys of the signers of a transaction, derived as soon as the paths are
+    // known rather than once the whole message arrived, see app_main()
+    Pubkey signer_pubkeys[MAX_SIGNERS];
+    bool signer_pubkeys_derived;
     bool non_confirm;
     bool deprecated_host;
+    // Raw P2 of the latest APDU, for instructions that interpret it themselves
+    uint8_t p2;
     uint8_t message[MAX_MESSAGE_LENGTH];
     int message_length;
+    // Expansion of a message sent with P2_COMPRESSED, see sol/pubkey_dictionary.h
+    MessageExpander message_expander;
+    // Transfer of chunks sent with P2_OFFSET, and bytes of its data committed
+    // so far, acknowledged to the host after every chunk
+    uint8_t transfer_id;
+    uint16_t transfer_committed;
+    // Running SHA-256 of message, updated as each chunk arrives so that
+    // message_hash is final once the payload is complete (sign instructions)
+    cx_sha256_t message_hash_context;
     Hash message_hash;
 } ApduCommand;
 
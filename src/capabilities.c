@@ -0,0 +1,92 @@
+#include "cx.h"
+#include "globals.h"
+#include "capabilities.h"
+#include "sol/message.h"
+#include "sol/pubkey_dictionary.h"
+#include "sol/transaction_summary.h"
+
+typedef struct CapabilityWriter {
+    uint8_t *buffer;
+    size_t buffer_size;
+    size_t length;
+    bool overflow;
+} CapabilityWriter;
+
+static void write_capability(CapabilityWriter *writer,
+                             CapabilityTag tag,
+                             uint32_t value,
+                             uint8_t value_length) {
+    if (writer->overflow || writer->buffer_size - writer->length < 2u + value_length) {
+        writer->overflow = true;
+        return;
+    }
+    uint8_t *entry = writer->buffer + writer->length;
+    entry[0] = tag;
+    entry[1] = value_length;
+    for (uint8_t i = 0; i < value_length; i++) {
+        entry[2 + i] = value >> (8 * (value_length - 1 - i));
+    }
+    writer->length += 2u + value_length;
+}
+
+static uint16_t supported_features(void) {
+    uint16_t features = CapabilityFeatureCompressedMessages | CapabilityFeatureOffsetChunks |
+                        CapabilityFeaturePubkeyBatch | CapabilityFeatureSignMessageBatch |
+                        CapabilityFeatureSigningPolicy | CapabilityFeatureOffchainMessageStream;
+    if (EXTENDED_APDUS_SUPPORTED) {
+        features |= CapabilityFeatureExtendedApdus;
+    }
+#ifdef HAVE_TOKEN_DESCRIPTOR_TEST_KEY
+    features |= CapabilityFeatureTokenDescriptors;
+#endif
+    return features;
+}
+
+// First four bytes of the SHA-256 of the dictionary keys, in dictionary order,
+// so that hosts can tell whether their copy of the dictionary is this one
+static uint32_t key_dictionary_digest(void) {
+    cx_sha256_t context;
+    uint8_t digest[CX_SHA256_SIZE] = {0};
+    cx_err_t cx_err = cx_sha256_init_no_throw(&context);
+    const size_t size = pubkey_dictionary_size();
+    for (size_t i = 0; cx_err == CX_OK && i < size; i++) {
+        cx_err = cx_hash_no_throw(&context.header,
+                                  0,
+                                  pubkey_dictionary_get(i)->data,
+                                  PUBKEY_SIZE,
+                                  NULL,
+                                  0);
+    }
+    if (cx_err == CX_OK) {
+        cx_err = cx_hash_no_throw(&context.header, CX_LAST, NULL, 0, digest, sizeof(digest));
+    }
+    return (uint32_t) digest[0] << 24 | (uint32_t) digest[1] << 16 |
+           (uint32_t) digest[2] << 8 | digest[3];
+}
+
+size_t write_capabilities(uint8_t *buffer, size_t buffer_size) {
+    // version and length come first
+    if (buffer_size < 2) {
+        return 0;
+    }
+    CapabilityWriter writer = {buffer, buffer_size, 2, false};
+    write_capability(&writer, CapabilityFeatures, supported_features(), 2);
+    write_capability(&writer, CapabilityMaxMessageLength, MAX_MESSAGE_LENGTH, 2);
+    write_capability(&writer, CapabilityMaxApduDataLength, MAX_APDU_DATA_LENGTH, 2);
+    write_capability(&writer, CapabilityMaxSigners, MAX_SIGNERS, 1);
+    write_capability(&writer, CapabilityMaxInstructions, MAX_INSTRUCTIONS, 1);
+    write_capability(&writer, CapabilityMaxSummaryItems, MAX_TRANSACTION_SUMMARY_ITEMS, 1);
+    write_capability(&writer, CapabilityMaxBatchTransactions, MAX_BATCH_TRANSACTIONS, 1);
+    write_capability(&writer, CapabilityKeyDictionarySize, pubkey_dictionary_size(), 2);
+    write_capability(&writer,
+                     CapabilityMaxOffchainMessageLength,
+                     MAX_OFFCHAIN_MESSAGE_LENGTH,
+                     2);
+    write_capability(&writer, CapabilityKeyDictionaryDigest, key_dictionary_digest(), 4);
+    if (writer.overflow || writer.length - 2 > UINT8_MAX) {
+        return 0;
+    }
+    buffer[0] = CAPABILITIES_VERSION;
+    buffer[1] = writer.length - 2;
+    return writer.length;
+}
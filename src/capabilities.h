@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Capability block appended to the GET APP CONFIGURATION response, see
+// doc/api.md. It starts with its version and the length of what follows,
+// then one tag, length, value entry per capability, values big endian.
+// Hosts skip the tags they do not know, so new ones are only ever added.
+
+#define CAPABILITIES_VERSION 1
+
+typedef enum CapabilityTag {
+    CapabilityFeatures = 0x01,
+    CapabilityMaxMessageLength = 0x02,
+    CapabilityMaxApduDataLength = 0x03,
+    CapabilityMaxSigners = 0x04,
+    CapabilityMaxInstructions = 0x05,
+    CapabilityMaxSummaryItems = 0x06,
+    CapabilityMaxBatchTransactions = 0x07,
+    CapabilityKeyDictionarySize = 0x08,
+    CapabilityMaxOffchainMessageLength = 0x09,
+    CapabilityKeyDictionaryDigest = 0x0a,
+} CapabilityTag;
+
+// Bits of CapabilityFeatures
+typedef enum CapabilityFeature {
+    CapabilityFeatureCompressedMessages = 1 << 0,
+    CapabilityFeatureExtendedApdus = 1 << 1,
+    CapabilityFeatureOffsetChunks = 1 << 2,
+    CapabilityFeaturePubkeyBatch = 1 << 3,
+    CapabilityFeatureSignMessageBatch = 1 << 4,
+    CapabilityFeatureSigningPolicy = 1 << 5,
+    CapabilityFeatureOffchainMessageStream = 1 << 6,
+    CapabilityFeatureTokenDescriptors = 1 << 7,
+} CapabilityFeature;
+
+// Write the capability block to buffer, returns its length or 0 if it does
+// not fit
+size_t write_capabilities(uint8_t *buffer, size_t buffer_size);
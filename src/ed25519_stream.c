@@ -0,0 +1,211 @@
+#include "ed25519_stream.h"
+
+#define ED25519_POINT_LENGTH 65
+
+// Order of the Ed25519 base point, big endian
+static const uint8_t ED25519_ORDER[ED25519_SCALAR_LENGTH] = {
+    0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x14, 0xde, 0xf9, 0xde, 0xa2, 0xf7,
+    0x9c, 0xd6, 0x58, 0x12, 0x63, 0x1a, 0x5c, 0xf5, 0xd3, 0xed};
+
+// Ed25519 base point, uncompressed big endian coordinates
+static const uint8_t ED25519_BASE_POINT[ED25519_POINT_LENGTH] = {
+    0x04, 0x21, 0x69, 0x36, 0xd3, 0xcd, 0x6e, 0x53, 0xfe, 0xc0, 0xa4, 0xe2, 0x31,
+    0xfd, 0xd6, 0xdc, 0x5c, 0x69, 0x2c, 0xc7, 0x60, 0x95, 0x25, 0xa7, 0xb2, 0xc9,
+    0x56, 0x2d, 0x60, 0x8f, 0x25, 0xd5, 0x1a, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x58};
+
+// The SDK works on big endian integers, Ed25519 encodes little endian ones
+static void reverse_bytes(uint8_t *out, const uint8_t *in, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        out[i] = in[length - 1 - i];
+    }
+}
+
+// SHA-512(seed): the clamped scalar a, big endian, then the prefix
+static cx_err_t expand_private_key(const cx_ecfp_private_key_t *private_key,
+                                   uint8_t scalar[static ED25519_SCALAR_LENGTH],
+                                   uint8_t prefix[static ED25519_SCALAR_LENGTH]) {
+    uint8_t expanded[CX_SHA512_SIZE] = {0};
+    cx_sha512_t context;
+    cx_err_t cx_err = cx_sha512_init_no_throw(&context);
+    if (cx_err == CX_OK) {
+        cx_err = cx_hash_no_throw(&context.header,
+                                  CX_LAST,
+                                  private_key->d,
+                                  ED25519_SCALAR_LENGTH,
+                                  expanded,
+                                  sizeof(expanded));
+    }
+    expanded[0] &= 0xf8;
+    expanded[ED25519_SCALAR_LENGTH - 1] &= 0x7f;
+    expanded[ED25519_SCALAR_LENGTH - 1] |= 0x40;
+    reverse_bytes(scalar, expanded, ED25519_SCALAR_LENGTH);
+    memcpy(prefix, expanded + ED25519_SCALAR_LENGTH, ED25519_SCALAR_LENGTH);
+    explicit_bzero(expanded, sizeof(expanded));
+    explicit_bzero(&context, sizeof(context));
+    return cx_err;
+}
+
+// Finish a SHA-512 and reduce the little endian digest modulo the group
+// order, big endian
+static cx_err_t finish_reduced(cx_sha512_t *context, uint8_t scalar[static ED25519_SCALAR_LENGTH]) {
+    uint8_t digest[CX_SHA512_SIZE];
+    uint8_t wide[CX_SHA512_SIZE] = {0};
+    cx_err_t cx_err = cx_hash_no_throw(&context->header, CX_LAST, NULL, 0, digest, sizeof(digest));
+    if (cx_err == CX_OK) {
+        reverse_bytes(wide, digest, sizeof(wide));
+        cx_err = cx_math_modm_no_throw(wide, sizeof(wide), ED25519_ORDER, sizeof(ED25519_ORDER));
+    }
+    memcpy(scalar, wide + sizeof(wide) - ED25519_SCALAR_LENGTH, ED25519_SCALAR_LENGTH);
+    explicit_bzero(digest, sizeof(digest));
+    explicit_bzero(wide, sizeof(wide));
+    return cx_err;
+}
+
+// Encoded sB, s big endian: y little endian, the parity of x in the top bit
+static cx_err_t encode_base_multiple(uint8_t encoded[static ED25519_SCALAR_LENGTH],
+                                     const uint8_t scalar[static ED25519_SCALAR_LENGTH]) {
+    uint8_t point[ED25519_POINT_LENGTH];
+    memcpy(point, ED25519_BASE_POINT, sizeof(point));
+    const cx_err_t cx_err =
+        cx_ecfp_scalar_mult_no_throw(CX_CURVE_Ed25519, point, scalar, ED25519_SCALAR_LENGTH);
+    reverse_bytes(encoded, point + 1 + ED25519_SCALAR_LENGTH, ED25519_SCALAR_LENGTH);
+    if ((point[ED25519_SCALAR_LENGTH] & 1) != 0) {
+        encoded[ED25519_SCALAR_LENGTH - 1] |= 0x80;
+    }
+    explicit_bzero(point, sizeof(point));
+    return cx_err;
+}
+
+// Restart SHA-512(prefix || M)
+static cx_err_t start_nonce(Ed25519Stream *stream, const cx_ecfp_private_key_t *private_key) {
+    uint8_t scalar[ED25519_SCALAR_LENGTH];
+    uint8_t prefix[ED25519_SCALAR_LENGTH];
+    cx_err_t cx_err = expand_private_key(private_key, scalar, prefix);
+    if (cx_err == CX_OK) {
+        cx_err = cx_sha512_init_no_throw(&stream->nonce_context);
+    }
+    if (cx_err == CX_OK) {
+        cx_err =
+            cx_hash_no_throw(&stream->nonce_context.header, 0, prefix, sizeof(prefix), NULL, 0);
+    }
+    explicit_bzero(scalar, sizeof(scalar));
+    explicit_bzero(prefix, sizeof(prefix));
+    return cx_err;
+}
+
+cx_err_t ed25519_stream_init(Ed25519Stream *stream, const cx_ecfp_private_key_t *private_key) {
+    explicit_bzero(stream, sizeof(*stream));
+    return start_nonce(stream, private_key);
+}
+
+cx_err_t ed25519_stream_update(Ed25519Stream *stream, const uint8_t *data, size_t length) {
+    cx_err_t cx_err = cx_hash_no_throw(&stream->nonce_context.header, 0, data, length, NULL, 0);
+    if (cx_err == CX_OK && stream->second_pass) {
+        cx_err = cx_hash_no_throw(&stream->challenge_context.header, 0, data, length, NULL, 0);
+    }
+    return cx_err;
+}
+
+cx_err_t ed25519_stream_finish_first_pass(Ed25519Stream *stream,
+                                          const cx_ecfp_private_key_t *private_key) {
+    if (stream->second_pass) {
+        return CX_INVALID_PARAMETER;
+    }
+    uint8_t nonce[ED25519_SCALAR_LENGTH];
+    uint8_t scalar[ED25519_SCALAR_LENGTH];
+    uint8_t prefix[ED25519_SCALAR_LENGTH];
+    cx_err_t cx_err = finish_reduced(&stream->nonce_context, nonce);
+    if (cx_err == CX_OK) {
+        cx_err = encode_base_multiple(stream->nonce_point, nonce);
+    }
+    explicit_bzero(nonce, sizeof(nonce));
+    if (cx_err == CX_OK) {
+        cx_err = expand_private_key(private_key, scalar, prefix);
+    }
+    if (cx_err == CX_OK) {
+        cx_err = encode_base_multiple(stream->public_key, scalar);
+    }
+    explicit_bzero(scalar, sizeof(scalar));
+    explicit_bzero(prefix, sizeof(prefix));
+
+    if (cx_err == CX_OK) {
+        cx_err = start_nonce(stream, private_key);
+    }
+    if (cx_err == CX_OK) {
+        cx_err = cx_sha512_init_no_throw(&stream->challenge_context);
+    }
+    if (cx_err == CX_OK) {
+        cx_err = cx_hash_no_throw(&stream->challenge_context.header,
+                                  0,
+                                  stream->nonce_point,
+                                  sizeof(stream->nonce_point),
+                                  NULL,
+                                  0);
+    }
+    if (cx_err == CX_OK) {
+        cx_err = cx_hash_no_throw(&stream->challenge_context.header,
+                                  0,
+                                  stream->public_key,
+                                  sizeof(stream->public_key),
+                                  NULL,
+                                  0);
+    }
+    stream->second_pass = true;
+    return cx_err;
+}
+
+cx_err_t ed25519_stream_finish_second_pass(Ed25519Stream *stream,
+                                           const cx_ecfp_private_key_t *private_key,
+                                           uint8_t signature[static ED25519_SIGNATURE_LENGTH]) {
+    uint8_t nonce[ED25519_SCALAR_LENGTH];
+    uint8_t challenge[ED25519_SCALAR_LENGTH];
+    uint8_t scalar[ED25519_SCALAR_LENGTH];
+    uint8_t prefix[ED25519_SCALAR_LENGTH];
+    cx_err_t cx_err = stream->second_pass ? CX_OK : CX_INVALID_PARAMETER;
+
+    if (cx_err == CX_OK) {
+        cx_err = finish_reduced(&stream->nonce_context, nonce);
+    }
+    // the r of this pass must be the one R was computed from, or both
+    // passes did not carry the same message
+    if (cx_err == CX_OK) {
+        cx_err = encode_base_multiple(signature, nonce);
+    }
+    if (cx_err == CX_OK &&
+        memcmp(signature, stream->nonce_point, sizeof(stream->nonce_point)) != 0) {
+        cx_err = CX_INVALID_PARAMETER;
+    }
+    if (cx_err == CX_OK) {
+        cx_err = finish_reduced(&stream->challenge_context, challenge);
+    }
+    if (cx_err == CX_OK) {
+        cx_err = expand_private_key(private_key, scalar, prefix);
+    }
+
+    // S = (r + k * a) mod L
+    if (cx_err == CX_OK) {
+        cx_err =
+            cx_math_modm_no_throw(scalar, sizeof(scalar), ED25519_ORDER, sizeof(ED25519_ORDER));
+    }
+    if (cx_err == CX_OK) {
+        cx_err = cx_math_multm_no_throw(scalar, challenge, scalar, ED25519_ORDER, sizeof(scalar));
+    }
+    if (cx_err == CX_OK) {
+        cx_err = cx_math_addm_no_throw(scalar, scalar, nonce, ED25519_ORDER, sizeof(scalar));
+    }
+    if (cx_err == CX_OK) {
+        reverse_bytes(signature + ED25519_SCALAR_LENGTH, scalar, sizeof(scalar));
+    } else {
+        explicit_bzero(signature, ED25519_SIGNATURE_LENGTH);
+    }
+
+    explicit_bzero(nonce, sizeof(nonce));
+    explicit_bzero(challenge, sizeof(challenge));
+    explicit_bzero(scalar, sizeof(scalar));
+    explicit_bzero(prefix, sizeof(prefix));
+    explicit_bzero(stream, sizeof(*stream));
+    return cx_err;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdbool.h>
+
+#include "os.h"
+#include "cx.h"
+
+#define ED25519_SCALAR_LENGTH    32
+#define ED25519_SIGNATURE_LENGTH 64
+
+/**
+ * Ed25519 signature (RFC 8032) of a message too large to be held, computed
+ * over two passes of the same bytes:
+ *
+ *   first pass   r = SHA-512(prefix || M), R = rB
+ *   second pass  r again and k = SHA-512(R || A || M), then S = r + k * a
+ *
+ * Only running hashes and the public points R and A are kept between the
+ * passes, the nonce r is recomputed rather than held. A second pass over
+ * other bytes recomputes another r, which no longer matches R: it is refused
+ * before anything is signed.
+ */
+typedef struct Ed25519Stream {
+    // SHA-512(prefix || M), restarted for each pass
+    cx_sha512_t nonce_context;
+    // SHA-512(R || A || M), second pass only
+    cx_sha512_t challenge_context;
+    bool second_pass;
+    uint8_t public_key[ED25519_SCALAR_LENGTH];
+    uint8_t nonce_point[ED25519_SCALAR_LENGTH];
+} Ed25519Stream;
+
+cx_err_t ed25519_stream_init(Ed25519Stream *stream, const cx_ecfp_private_key_t *private_key);
+
+cx_err_t ed25519_stream_update(Ed25519Stream *stream, const uint8_t *data, size_t length);
+
+// Compute R and A, then start the second pass
+cx_err_t ed25519_stream_finish_first_pass(Ed25519Stream *stream,
+                                          const cx_ecfp_private_key_t *private_key);
+
+// Write R || S, the stream is wiped whatever the outcome
+cx_err_t ed25519_stream_finish_second_pass(Ed25519Stream *stream,
+                                           const cx_ecfp_private_key_t *private_key,
+                                           uint8_t signature[static ED25519_SIGNATURE_LENGTH]);
@@ -1,6 +1,7 @@
 #include "os.h"
 #include "ux.h"
 #include "os_io_seproxyhal.h"
+#include "sol/signing_policy.h"
 
 #ifndef _GLOBALS_H_
 #define _GLOBALS_H_
@@ -15,12 +16,25 @@
 #define OFFSET_LC               4
 #define OFFSET_CDATA            5
 #define DEPRECATED_OFFSET_CDATA 6
+// Extended length APDUs: Lc is 00 then the data length (u16 BE)
+#define EXTENDED_OFFSET_CDATA 7
+
+// Short APDUs carry up to 255 bytes of data. Longer ones need a larger APDU
+// buffer, see CUSTOM_IO_APDU_BUFFER_SIZE in the Makefile
+#define SHORT_APDU_BUFFER_SIZE    (OFFSET_CDATA + UINT8_MAX)
+#define EXTENDED_APDUS_SUPPORTED  (IO_APDU_BUFFER_SIZE > SHORT_APDU_BUFFER_SIZE)
+#define MAX_APDU_DATA_LENGTH                                             \
+    (EXTENDED_APDUS_SUPPORTED ? IO_APDU_BUFFER_SIZE - EXTENDED_OFFSET_CDATA \
+                              : UINT8_MAX)
 
 #define P1_CONFIRM     0x01
 #define P1_NON_CONFIRM 0x00
 
-#define P2_EXTEND 0x01
-#define P2_MORE   0x02
+#define P2_EXTEND      0x01
+#define P2_MORE        0x02
+#define P2_SECOND_PASS 0x04
+#define P2_COMPRESSED  0x08
+#define P2_OFFSET      0x10
 
 #define ROUND_TO_NEXT(x, next) (((x) == 0) ? 0 : ((((x - 1) / (next)) + 1) * (next)))
 
@@ -28,6 +42,21 @@
 #define PACKET_DATA_SIZE (1280 - 40 - 8)
 
 #define MAX_BIP32_PATH_LENGTH             5
+// Signers of a single SIGN MESSAGE, their signatures must fit a short APDU
+// response (3 * 64 bytes)
+#if defined(TARGET_NANOS)
+#define MAX_SIGNERS 2
+#else
+#define MAX_SIGNERS 3
+#endif
+// Transactions queued by a SIGN MESSAGE BATCH and review pages kept for them
+#if defined(TARGET_NANOS)
+#define MAX_BATCH_TRANSACTIONS 2
+#define MAX_BATCH_PAGES        8
+#else
+#define MAX_BATCH_TRANSACTIONS 8
+#define MAX_BATCH_PAGES        48
+#endif
 #define MAX_DERIVATION_PATH_BUFFER_LENGTH (1 + MAX_BIP32_PATH_LENGTH * 4)
 #define TOTAL_SIGN_MESSAGE_BUFFER_LENGTH  (PACKET_DATA_SIZE + MAX_DERIVATION_PATH_BUFFER_LENGTH)
 
@@ -49,7 +78,12 @@ typedef enum InstructionCode {
     InsGetAppConfiguration = 0x04,
     InsGetPubkey = 0x05,
     InsSignMessage = 0x06,
-    InsSignOffchainMessage = 0x07
+    InsSignOffchainMessage = 0x07,
+    InsProvideTokenDescriptor = 0x08,
+    InsSignOffchainMessageStream = 0x09,
+    InsGetPubkeyBatch = 0x0A,
+    InsSignMessageBatch = 0x0B,
+    InsSetSigningPolicy = 0x0C
 } InstructionCode;
 
 extern volatile bool G_called_from_swap;
@@ -82,6 +116,8 @@ typedef struct AppSettings {
 
 typedef struct internalStorage_t {
     AppSettings settings;
+    // Transactions the user allowed to be signed without review
+    SigningPolicy policy;
     uint8_t initialized;
 } internalStorage_t;
 
@@ -4,6 +4,16 @@
 #include "sol/printer.h"
 #include "ui_api.h"
 
+// GET PUBKEY BATCH request layouts, see doc/api.md
+#define PUBKEY_BATCH_RANGE 0x00
+#define PUBKEY_BATCH_LIST  0x01
+
+// Key count and cursor precede the keys, the status word follows them. The
+// response stays short even where the APDU buffer is larger
+#define PUBKEY_BATCH_HEADER_LENGTH 5
+#define PUBKEY_BATCH_MAX_KEYS \
+    ((SHORT_APDU_BUFFER_SIZE - PUBKEY_BATCH_HEADER_LENGTH - 2) / PUBKEY_LENGTH)
+
 static uint8_t G_publicKey[PUBKEY_LENGTH];
 char G_publicKeyStr[BASE58_PUBKEY_LENGTH];
 
@@ -27,7 +37,9 @@ void handle_get_pubkey(volatile unsigned int *flags, volatile unsigned int *tx)
         THROW(ApduReplySdkInvalidParameter);
     }
 
-    get_public_key(G_publicKey, G_command.derivation_path, G_command.derivation_path_length);
+    get_public_key(G_publicKey,
+                   G_command.derivation_paths[0],
+                   G_command.derivation_path_lengths[0]);
     encode_base58(G_publicKey, PUBKEY_LENGTH, G_publicKeyStr, BASE58_PUBKEY_LENGTH);
 
     if (G_command.non_confirm) {
@@ -38,3 +50,89 @@ void handle_get_pubkey(volatile unsigned int *flags, volatile unsigned int *tx)
         *flags |= IO_ASYNCH_REPLY;
     }
 }
+
+// Derive the keys of a range of children of a base path, or of a list of
+// paths, as many as fit in one response. The cursor returned with them
+// tells the host where to resume: the next child index for a range, the
+// index of the first path left out for a list.
+void handle_get_pubkey_batch(volatile unsigned int *tx) {
+    if (!tx || G_command.instruction != InsGetPubkeyBatch ||
+        G_command.state != ApduStatePayloadComplete) {
+        THROW(ApduReplySdkInvalidParameter);
+    }
+    // Keys are only exported, use GET PUBKEY to have one confirmed
+    if (!G_command.non_confirm) {
+        THROW(ApduReplySdkNotSupported);
+    }
+
+    const uint8_t *data = G_command.message;
+    size_t data_length = G_command.message_length;
+    uint8_t *keys = G_io_apdu_buffer + PUBKEY_BATCH_HEADER_LENGTH;
+    uint32_t path[MAX_BIP32_PATH_LENGTH];
+    uint32_t path_length;
+    size_t num_keys = 0;
+    uint32_t cursor = 0;
+
+    if (data_length < 2) {
+        THROW(ApduReplySolanaInvalidMessageSize);
+    }
+    const uint8_t layout = data[0];
+    data++;
+    data_length--;
+
+    if (layout == PUBKEY_BATCH_RANGE) {
+        // base path | first child index (u32 BE) | child count (u32 BE)
+        const int ret = read_derivation_path(data, data_length, path, &path_length);
+        if (ret) {
+            THROW(ret);
+        }
+        data += 1 + path_length * 4;
+        data_length -= 1 + path_length * 4;
+        if (data_length != 8) {
+            THROW(ApduReplySolanaInvalidMessageSize);
+        }
+        const uint32_t first = U4BE(data, 0);
+        const uint32_t count = U4BE(data, 4);
+        const uint32_t last = first + count - 1;
+        // the children must not wrap around nor straddle the hardened range
+        if (path_length == MAX_BIP32_PATH_LENGTH || count == 0 || last < first ||
+            ((first ^ last) & 0x80000000u)) {
+            THROW(ApduReplySolanaInvalidMessage);
+        }
+        cursor = first;
+        while (num_keys < PUBKEY_BATCH_MAX_KEYS && num_keys < count) {
+            path[path_length] = cursor++;
+            get_public_key(keys + num_keys * PUBKEY_LENGTH, path, path_length + 1);
+            num_keys++;
+        }
+    } else if (layout == PUBKEY_BATCH_LIST) {
+        // path count | paths
+        const size_t num_paths = data[0];
+        data++;
+        data_length--;
+        if (num_paths == 0) {
+            THROW(ApduReplySolanaInvalidMessage);
+        }
+        while (num_keys < PUBKEY_BATCH_MAX_KEYS && num_keys < num_paths) {
+            const int ret = read_derivation_path(data, data_length, path, &path_length);
+            if (ret) {
+                THROW(ret);
+            }
+            data += 1 + path_length * 4;
+            data_length -= 1 + path_length * 4;
+            get_public_key(keys + num_keys * PUBKEY_LENGTH, path, path_length);
+            num_keys++;
+        }
+        cursor = num_keys;
+    } else {
+        THROW(ApduReplySolanaInvalidMessage);
+    }
+
+    G_io_apdu_buffer[0] = num_keys;
+    G_io_apdu_buffer[1] = cursor >> 24;
+    G_io_apdu_buffer[2] = cursor >> 16;
+    G_io_apdu_buffer[3] = cursor >> 8;
+    G_io_apdu_buffer[4] = cursor;
+    *tx = PUBKEY_BATCH_HEADER_LENGTH + num_keys * PUBKEY_LENGTH;
+    THROW(ApduReplySuccess);
+}
@@ -12,3 +12,5 @@ void reset_getpubkey_globals(void);
 void handle_get_pubkey(volatile unsigned int *flags, volatile unsigned int *tx);
 
 uint8_t set_result_get_pubkey(void);
+
+void handle_get_pubkey_batch(volatile unsigned int *tx);
@@ -0,0 +1,91 @@
+#include "io.h"
+#include "os.h"
+#include "cx.h"
+#include "utils.h"
+#include "globals.h"
+#include "apdu.h"
+#include "sol/token_cache.h"
+#include "handle_provide_token_descriptor.h"
+
+// mint(32) | symbol_length(1) | symbol | DER signature. No decimals: amounts
+// are only displayed from *Checked instructions, which carry their own.
+#define DESCRIPTOR_HEADER_LENGTH (PUBKEY_LENGTH + 1)
+#define DESCRIPTOR_MIN_SIGNATURE_LENGTH 8
+#define DESCRIPTOR_MAX_SIGNATURE_LENGTH 72
+
+#ifdef HAVE_TOKEN_DESCRIPTOR_TEST_KEY
+// secp256k1 test key, see doc/api.md. Descriptors signed with it must never
+// be trusted by a release build.
+static const uint8_t TOKEN_DESCRIPTOR_PUBLIC_KEY[] = {
+    0x04, 0x84, 0xe5, 0xd6, 0x13, 0x3c, 0x3a, 0x4b, 0x1a, 0x15, 0x3e, 0x80, 0xa7,
+    0xbe, 0x7f, 0xfc, 0x30, 0x17, 0xf8, 0x46, 0xa8, 0x9e, 0x54, 0xb8, 0x92, 0xe4,
+    0x53, 0xfd, 0x68, 0xc3, 0x72, 0x73, 0x6c, 0xda, 0x68, 0xa7, 0xbd, 0x28, 0x89,
+    0x45, 0xb1, 0x80, 0x6d, 0x4d, 0x8d, 0xb4, 0x53, 0x60, 0x45, 0xda, 0xa4, 0x5c,
+    0x3e, 0x32, 0x57, 0x0a, 0x27, 0xf1, 0x32, 0xb7, 0xb1, 0x3e, 0xf2, 0x5d, 0x86};
+
+static bool verify_descriptor_signature(const uint8_t *body,
+                                        size_t body_length,
+                                        const uint8_t *signature,
+                                        size_t signature_length) {
+    uint8_t hash[CX_SHA256_SIZE];
+    cx_ecfp_public_key_t public_key;
+
+    cx_hash_sha256(body, body_length, hash, sizeof(hash));
+    if (cx_ecfp_init_public_key_no_throw(CX_CURVE_256K1,
+                                         TOKEN_DESCRIPTOR_PUBLIC_KEY,
+                                         sizeof(TOKEN_DESCRIPTOR_PUBLIC_KEY),
+                                         &public_key) != CX_OK) {
+        return false;
+    }
+    return cx_ecdsa_verify_no_throw(&public_key,
+                                    hash,
+                                    sizeof(hash),
+                                    signature,
+                                    signature_length);
+}
+#endif
+
+void handle_provide_token_descriptor(volatile unsigned int *tx) {
+    if (!tx || G_command.instruction != InsProvideTokenDescriptor ||
+        G_command.state != ApduStatePayloadComplete) {
+        THROW(ApduReplySdkInvalidParameter);
+    }
+
+#ifndef HAVE_TOKEN_DESCRIPTOR_TEST_KEY
+    // No trusted descriptor key is provisioned in this build
+    THROW(ApduReplySdkNotSupported);
+#else
+    const uint8_t *descriptor = G_command.message;
+    const size_t descriptor_length = G_command.message_length;
+
+    if (descriptor_length < DESCRIPTOR_HEADER_LENGTH) {
+        THROW(ApduReplySolanaInvalidMessageSize);
+    }
+    const size_t symbol_length = descriptor[PUBKEY_LENGTH];
+    const size_t body_length = DESCRIPTOR_HEADER_LENGTH + symbol_length;
+    if (body_length > descriptor_length) {
+        THROW(ApduReplySolanaInvalidMessageSize);
+    }
+    const size_t signature_length = descriptor_length - body_length;
+    if (signature_length < DESCRIPTOR_MIN_SIGNATURE_LENGTH ||
+        signature_length > DESCRIPTOR_MAX_SIGNATURE_LENGTH) {
+        THROW(ApduReplySolanaInvalidMessageSize);
+    }
+
+    if (!verify_descriptor_signature(descriptor,
+                                     body_length,
+                                     descriptor + body_length,
+                                     signature_length)) {
+        THROW(ApduReplySolanaInvalidSignature);
+    }
+
+    if (token_cache_insert((const Pubkey *) descriptor,
+                           (const char *) descriptor + DESCRIPTOR_HEADER_LENGTH,
+                           symbol_length) != 0) {
+        THROW(ApduReplySolanaInvalidMessage);
+    }
+
+    *tx = 0;
+    THROW(ApduReplySuccess);
+#endif
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void handle_provide_token_descriptor(volatile unsigned int *tx);
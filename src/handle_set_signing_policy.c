@@ -0,0 +1,135 @@
+#include "io.h"
+#include "os.h"
+#include "utils.h"
+#include "globals.h"
+#include "apdu.h"
+#include "sol/parser.h"
+#include "sol/signing_policy.h"
+#include "sol/transaction_summary.h"
+#include "handle_set_signing_policy.h"
+#include "ui_api.h"
+
+// pattern(1) | derivation path | account(32) | destination(32) | max amount(8, BE)
+#define POLICY_FIELDS_LENGTH (2 * PUBKEY_LENGTH + sizeof(uint64_t))
+
+// Policy under review, installed once approved
+static SigningPolicy G_pending_policy;
+
+uint8_t set_result_set_signing_policy(void) {
+    if (signing_policy_validate(&G_pending_policy) != 0) {
+        THROW(ApduReplySdkInvalidState);
+    }
+    nvm_write((void *) &N_storage.policy, &G_pending_policy, sizeof(G_pending_policy));
+    explicit_bzero(&G_pending_policy, sizeof(G_pending_policy));
+    return 0;
+}
+
+static void review_pending_policy(void) {
+    transaction_summary_reset();
+    SummaryItem *item = transaction_summary_primary_item();
+    if (G_pending_policy.pattern == SigningPolicyVoteWithdraw) {
+        summary_item_set_string(item, "Allow unattended", "Vote withdraw");
+    } else {
+        summary_item_set_string(item, "Allow unattended", "Vote commission");
+    }
+
+    summary_item_set_pubkey(transaction_summary_general_item(),
+                            "Signer",
+                            &G_pending_policy.signer);
+    summary_item_set_pubkey(transaction_summary_general_item(),
+                            "Vote account",
+                            &G_pending_policy.account);
+    if (G_pending_policy.pattern == SigningPolicyVoteWithdraw) {
+        summary_item_set_pubkey(transaction_summary_general_item(),
+                                "To",
+                                &G_pending_policy.destination);
+        // Each transaction is capped, not their sum
+        summary_item_set_amount(transaction_summary_general_item(),
+                                "Max per tx",
+                                G_pending_policy.max_amount);
+    } else {
+        summary_item_set_u64(transaction_summary_general_item(),
+                             "Max commission",
+                             G_pending_policy.max_amount);
+    }
+
+    enum SummaryItemKind summary_step_kinds[MAX_TRANSACTION_SUMMARY_ITEMS];
+    size_t num_summary_steps = 0;
+    if (transaction_summary_finalize(summary_step_kinds, &num_summary_steps)) {
+        THROW(ApduReplySolanaSummaryFinalizeFailed);
+    }
+
+    start_set_signing_policy_ui(num_summary_steps);
+}
+
+void handle_set_signing_policy(volatile unsigned int *flags, volatile unsigned int *tx) {
+    if (!tx || G_command.instruction != InsSetSigningPolicy ||
+        G_command.state != ApduStatePayloadComplete) {
+        THROW(ApduReplySdkInvalidParameter);
+    }
+
+    const uint8_t *data = G_command.message;
+    size_t length = G_command.message_length;
+    explicit_bzero(&G_pending_policy, sizeof(G_pending_policy));
+
+    // Clearing the policy never needs a review
+    if (data[0] == SigningPolicyNone) {
+        if (length != 1) {
+            THROW(ApduReplySolanaInvalidMessageSize);
+        }
+        nvm_write((void *) &N_storage.policy, &G_pending_policy, sizeof(G_pending_policy));
+        THROW(ApduReplySuccess);
+    }
+    // Installing one always does
+    if (G_command.non_confirm) {
+        THROW(ApduReplySdkNotSupported);
+    }
+
+    G_pending_policy.pattern = data[0];
+    data++;
+    length--;
+
+    uint32_t derivation_path[MAX_BIP32_PATH_LENGTH];
+    uint32_t derivation_path_length = 0;
+    const int ret = read_derivation_path(data, length, derivation_path, &derivation_path_length);
+    if (ret) {
+        THROW(ret);
+    }
+    data += 1 + derivation_path_length * 4;
+    length -= 1 + derivation_path_length * 4;
+    if (length != POLICY_FIELDS_LENGTH) {
+        THROW(ApduReplySolanaInvalidMessageSize);
+    }
+
+    get_public_key(G_pending_policy.signer.data, derivation_path, derivation_path_length);
+    memcpy(G_pending_policy.account.data, data, PUBKEY_LENGTH);
+    memcpy(G_pending_policy.destination.data, data + PUBKEY_LENGTH, PUBKEY_LENGTH);
+    G_pending_policy.max_amount = ((uint64_t) U4BE(data, 2 * PUBKEY_LENGTH) << 32) |
+                                  U4BE(data, 2 * PUBKEY_LENGTH + 4);
+    if (signing_policy_validate(&G_pending_policy) != 0) {
+        THROW(ApduReplySolanaInvalidMessage);
+    }
+
+    review_pending_policy();
+
+    *flags |= IO_ASYNCH_REPLY;
+}
+
+bool signing_policy_allows_command(void) {
+    if (G_command.num_derivation_paths != 1) {
+        return false;
+    }
+
+    SigningPolicy policy;
+    memcpy(&policy, (const void *) &N_storage.policy, sizeof(policy));
+    if (!pubkeys_equal(&G_command.signer_pubkeys[0], &policy.signer)) {
+        return false;
+    }
+
+    Parser parser = {G_command.message, G_command.message_length};
+    MessageHeader header;
+    if (parse_message_header(&parser, &header) != 0) {
+        return false;
+    }
+    return signing_policy_match(&policy, &header, parser.buffer, parser.buffer_length) == 0;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+// Install the signing policy in G_command once the user approved it, or
+// clear the installed one, see doc/api.md
+void handle_set_signing_policy(volatile unsigned int *flags, volatile unsigned int *tx);
+
+// Store the reviewed policy
+uint8_t set_result_set_signing_policy(void);
+
+// Whether the complete transaction in G_command may be signed without review
+bool signing_policy_allows_command(void);
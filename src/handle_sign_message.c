@@ -9,14 +9,47 @@
 #include "sol/transaction_summary.h"
 
 #include "handle_sign_message.h"
+#include "handle_set_signing_policy.h"
 #include "ui_api.h"
 
-static int scan_header_for_signer(const uint32_t *derivation_path,
-                                  uint32_t derivation_path_length,
+// Signer keys of the current request, pointed to by the print config
+static Pubkey G_signer_pubkeys[MAX_SIGNERS];
+
+// What the transaction summary was last built from. Summary items point into
+// G_command.message, so an identical message re-sent without any other
+// command in between lands at the same place and can reuse it as is.
+typedef struct SummarizedMessage {
+    bool valid;
+    Hash message_hash;
+    int message_length;
+    Pubkey signer_pubkeys[MAX_SIGNERS];
+    uint8_t num_signers;
+    uint8_t display_mode;
+    uint8_t allow_blind_sign;
+} SummarizedMessage;
+
+static SummarizedMessage G_summarized_message;
+
+void sign_message_forget_summary(void) {
+    explicit_bzero(&G_summarized_message, sizeof(G_summarized_message));
+}
+
+static void describe_summarized_message(SummarizedMessage *description) {
+    explicit_bzero(description, sizeof(*description));
+    description->valid = true;
+    memcpy(&description->message_hash, &G_command.message_hash, sizeof(Hash));
+    description->message_length = G_command.message_length;
+    memcpy(description->signer_pubkeys,
+           G_command.signer_pubkeys,
+           G_command.num_derivation_paths * sizeof(Pubkey));
+    description->num_signers = G_command.num_derivation_paths;
+    description->display_mode = N_storage.settings.display_mode;
+    description->allow_blind_sign = N_storage.settings.allow_blind_sign;
+}
+
+static int scan_header_for_signer(const Pubkey *signer_pubkey,
                                   size_t *signer_index,
                                   const MessageHeader *header) {
-    uint8_t signer_pubkey[PUBKEY_SIZE];
-    get_public_key(signer_pubkey, derivation_path, derivation_path_length);
     for (size_t i = 0; i < header->pubkeys_header.num_required_signatures; ++i) {
         const Pubkey *current_pubkey = &(header->pubkeys[i]);
         if (memcmp(current_pubkey, signer_pubkey, PUBKEY_SIZE) == 0) {
@@ -27,42 +60,41 @@ static int scan_header_for_signer(const uint32_t *derivation_path,
     return -1;
 }
 
-void handle_sign_message_parse_message(volatile unsigned int *tx) {
-    if (!tx ||
-        (G_command.instruction != InsDeprecatedSignMessage &&
-         G_command.instruction != InsSignMessage) ||
-        G_command.state != ApduStatePayloadComplete) {
-        THROW(ApduReplySdkInvalidParameter);
+void sign_message_summarize(void) {
+    // Multi-chunk messages had their signer keys derived while the host
+    // was sending the following chunks
+    if (!G_command.signer_pubkeys_derived && !derive_signer_pubkeys(&G_command)) {
+        THROW(ApduReplySdkException);
     }
-    // Handle the transaction message signing
+
     Parser parser = {G_command.message, G_command.message_length};
     PrintConfig print_config;
     print_config.expert_mode = (N_storage.settings.display_mode == DisplayModeExpert);
-    print_config.signer_pubkey = NULL;
+    print_config.signer_pubkeys = NULL;
+    print_config.num_signer_pubkeys = 0;
     MessageHeader *header = &print_config.header;
-    size_t signer_index;
 
     if (parse_message_header(&parser, header) != 0) {
         // This is not a valid Solana message
         THROW(ApduReplySolanaInvalidMessage);
     }
 
-    // Ensure the requested signer is present in the header
-    if (scan_header_for_signer(G_command.derivation_path,
-                               G_command.derivation_path_length,
-                               &signer_index,
-                               header) != 0) {
-        THROW(ApduReplySolanaInvalidMessageHeader);
-    }
-    print_config.signer_pubkey = &header->pubkeys[signer_index];
-
-    if (G_command.non_confirm) {
-        // Uncomment this to allow unattended signing.
-        //*tx = set_result_sign_message();
-        // THROW(ApduReplySuccess);
-        UNUSED(tx);
-        THROW(ApduReplySdkNotSupported);
+    // Ensure every requested signer is present in the header, once
+    size_t signer_indexes[MAX_SIGNERS];
+    for (size_t i = 0; i < G_command.num_derivation_paths; i++) {
+        if (scan_header_for_signer(&G_command.signer_pubkeys[i], &signer_indexes[i], header) !=
+            0) {
+            THROW(ApduReplySolanaInvalidMessageHeader);
+        }
+        for (size_t j = 0; j < i; j++) {
+            if (signer_indexes[j] == signer_indexes[i]) {
+                THROW(ApduReplySolanaInvalidMessageHeader);
+            }
+        }
+        G_signer_pubkeys[i] = header->pubkeys[signer_indexes[i]];
     }
+    print_config.signer_pubkeys = G_signer_pubkeys;
+    print_config.num_signer_pubkeys = G_command.num_derivation_paths;
 
     // Set the transaction summary
     transaction_summary_reset();
@@ -72,11 +104,6 @@ void handle_sign_message_parse_message(volatile unsigned int *tx) {
             SummaryItem *item = transaction_summary_primary_item();
             summary_item_set_string(item, "Unrecognized", "format");
 
-            cx_hash_sha256(G_command.message,
-                           G_command.message_length,
-                           (uint8_t *) &G_command.message_hash,
-                           HASH_LENGTH);
-
             item = transaction_summary_general_item();
             summary_item_set_hash(item, "Message Hash", &G_command.message_hash);
         } else {
@@ -91,6 +118,42 @@ void handle_sign_message_parse_message(volatile unsigned int *tx) {
     }
 }
 
+void handle_sign_message_parse_message(volatile unsigned int *tx) {
+    if (!tx ||
+        (G_command.instruction != InsDeprecatedSignMessage &&
+         G_command.instruction != InsSignMessage) ||
+        G_command.state != ApduStatePayloadComplete) {
+        THROW(ApduReplySdkInvalidParameter);
+    }
+
+    // Multi-chunk messages had their signer keys derived while the host
+    // was sending the following chunks
+    if (!G_command.signer_pubkeys_derived && !derive_signer_pubkeys(&G_command)) {
+        THROW(ApduReplySdkException);
+    }
+
+    // Same message, signers and settings as the summary on hand: it was
+    // checked and summarized already
+    SummarizedMessage description;
+    describe_summarized_message(&description);
+    if (memcmp(&description, &G_summarized_message, sizeof(description)) != 0) {
+        sign_message_forget_summary();
+        sign_message_summarize();
+    }
+
+    if (G_command.non_confirm) {
+        // Unattended signing only for what the user allowed ahead of time
+        if (G_command.instruction == InsSignMessage && !G_called_from_swap &&
+            signing_policy_allows_command()) {
+            *tx = set_result_sign_message();
+            THROW(ApduReplySuccess);
+        }
+        THROW(ApduReplySdkNotSupported);
+    }
+
+    memcpy(&G_summarized_message, &description, sizeof(description));
+}
+
 static bool check_swap_validity(const SummaryItemKind_t kinds[MAX_TRANSACTION_SUMMARY_ITEMS],
                                 size_t num_summary_steps) {
     bool amount_ok = false;
@@ -146,6 +209,7 @@ void handle_sign_message_ui(volatile unsigned int *flags) {
             }
         } else {
             start_sign_tx_ui(num_summary_steps);
+            stage_signer_keys_later();
         }
     } else {
         THROW(ApduReplySolanaSummaryFinalizeFailed);
@@ -2,4 +2,11 @@
 
 void handle_sign_message_parse_message(volatile unsigned int *tx);
 
+// Check the signers of the complete message in G_command and build its
+// transaction summary, throws if it cannot be reviewed
+void sign_message_summarize(void);
+
 void handle_sign_message_ui(volatile unsigned int *flags);
+
+// Drop the summary kept for a message re-sent identically
+void sign_message_forget_summary(void);
@@ -0,0 +1,203 @@
+#include "io.h"
+#include "os.h"
+#include "utils.h"
+#include "sol/printer.h"
+#include "sol/transaction_summary.h"
+#include "globals.h"
+#include "apdu.h"
+#include "handle_sign_message.h"
+#include "handle_sign_message_batch.h"
+#include "ui_api.h"
+
+typedef enum BatchState {
+    BatchStateIdle = 0,
+    BatchStateQueueing,
+    BatchStateReviewing,
+    BatchStateApproved,
+} BatchState;
+
+typedef struct BatchTransaction {
+    uint32_t derivation_path[MAX_BIP32_PATH_LENGTH];
+    uint32_t derivation_path_length;
+    Hash message_hash;
+} BatchTransaction;
+
+// One summary item of a queued transaction, as it will be displayed
+typedef struct BatchPage {
+    uint8_t transaction;
+    char title[TITLE_SIZE];
+    char text[TEXT_BUFFER_LENGTH];
+} BatchPage;
+
+typedef struct SignMessageBatch {
+    BatchState state;
+    BatchTransaction transactions[MAX_BATCH_TRANSACTIONS];
+    size_t num_transactions;
+    // Transactions signed so far, in queue order
+    size_t num_signed;
+    BatchPage pages[MAX_BATCH_PAGES];
+    size_t num_pages;
+} SignMessageBatch;
+
+static SignMessageBatch G_batch;
+
+void sign_message_batch_reset(void) {
+    explicit_bzero(&G_batch, sizeof(G_batch));
+}
+
+static void fail(int error) {
+    sign_message_batch_reset();
+    THROW(error);
+}
+
+// Append in to the NUL terminated string out, throws if it does not fit
+static void append_string(char *out, size_t out_size, const char *in) {
+    const size_t used = strlen(out);
+    if (print_string(in, out + used, out_size - used) != 0) {
+        THROW(ApduReplySolanaSummaryUpdateFailed);
+    }
+}
+
+static void append_u64(char *out, size_t out_size, uint64_t value) {
+    const size_t used = strlen(out);
+    if (print_u64(value, out + used, out_size - used) != 0) {
+        THROW(ApduReplySolanaSummaryUpdateFailed);
+    }
+}
+
+size_t get_sign_message_batch_page_count(void) {
+    // overview, then transaction pages
+    return 1 + G_batch.num_pages;
+}
+
+void get_sign_message_batch_page(size_t index,
+                                 char *title,
+                                 size_t title_size,
+                                 char *text,
+                                 size_t text_size) {
+    if (title_size == 0 || text_size == 0 || index >= get_sign_message_batch_page_count()) {
+        THROW(ApduReplySolanaSummaryUpdateFailed);
+    }
+    title[0] = '\0';
+    text[0] = '\0';
+
+    if (index == 0) {
+        append_string(title, title_size, "Sign batch");
+        append_u64(text, text_size, G_batch.num_transactions);
+        append_string(text, text_size, " transactions");
+    } else {
+        // "Tx i/n: " then the item title, truncated if need be
+        const BatchPage *page = &G_batch.pages[index - 1];
+        append_string(title, title_size, "Tx ");
+        append_u64(title, title_size, page->transaction + 1);
+        append_string(title, title_size, "/");
+        append_u64(title, title_size, G_batch.num_transactions);
+        append_string(title, title_size, ": ");
+        const size_t used = strlen(title);
+        print_string(page->title, title + used, title_size - used);
+        append_string(text, text_size, page->text);
+    }
+}
+
+// Summarize the transaction in G_command and keep its rendered pages
+static void queue_transaction(void) {
+    if (G_batch.state != BatchStateQueueing) {
+        // Queueing after a review, approved or not, starts a new batch
+        sign_message_batch_reset();
+    }
+    if (G_batch.num_transactions == MAX_BATCH_TRANSACTIONS) {
+        fail(ApduReplySdkNotEnoughSpace);
+    }
+
+    // A transaction that cannot be reviewed drops the whole batch
+    G_batch.state = BatchStateIdle;
+    sign_message_summarize();
+    G_batch.state = BatchStateQueueing;
+
+    enum SummaryItemKind summary_step_kinds[MAX_TRANSACTION_SUMMARY_ITEMS];
+    size_t num_summary_steps = 0;
+    if (transaction_summary_finalize(summary_step_kinds, &num_summary_steps)) {
+        fail(ApduReplySolanaSummaryFinalizeFailed);
+    }
+    if (G_batch.num_pages + num_summary_steps > MAX_BATCH_PAGES) {
+        fail(ApduReplySdkNotEnoughSpace);
+    }
+
+    // Rendered now, the transaction is gone once the next one arrives
+    enum DisplayFlags flags = DisplayFlagNone;
+    if (N_storage.settings.pubkey_display == PubkeyDisplayLong) {
+        flags |= DisplayFlagLongPubkeys;
+    }
+    for (size_t i = 0; i < num_summary_steps; i++) {
+        if (transaction_summary_display_item(i, flags)) {
+            fail(ApduReplySolanaSummaryUpdateFailed);
+        }
+        BatchPage *page = &G_batch.pages[G_batch.num_pages++];
+        page->transaction = G_batch.num_transactions;
+        memcpy(page->title, G_transaction_summary_title, sizeof(page->title));
+        memcpy(page->text, G_transaction_summary_text, sizeof(page->text));
+    }
+    transaction_summary_reset();
+
+    BatchTransaction *transaction = &G_batch.transactions[G_batch.num_transactions++];
+    memcpy(transaction->derivation_path,
+           G_command.derivation_paths[0],
+           sizeof(transaction->derivation_path));
+    transaction->derivation_path_length = G_command.derivation_path_lengths[0];
+    memcpy(&transaction->message_hash, &G_command.message_hash, sizeof(Hash));
+}
+
+// Sign the transaction in G_command if it is the next one reviewed
+static void sign_transaction(volatile unsigned int *tx) {
+    if (G_batch.state != BatchStateApproved) {
+        fail(ApduReplySdkInvalidState);
+    }
+    const BatchTransaction *transaction = &G_batch.transactions[G_batch.num_signed];
+    if (G_command.derivation_path_lengths[0] != transaction->derivation_path_length ||
+        memcmp(G_command.derivation_paths[0],
+               transaction->derivation_path,
+               transaction->derivation_path_length * sizeof(uint32_t)) != 0 ||
+        memcmp(&G_command.message_hash, &transaction->message_hash, sizeof(Hash)) != 0) {
+        fail(ApduReplySolanaInvalidMessage);
+    }
+
+    *tx = set_result_sign_message();
+    if (++G_batch.num_signed == G_batch.num_transactions) {
+        sign_message_batch_reset();
+    }
+    THROW(ApduReplySuccess);
+}
+
+uint8_t set_result_sign_message_batch(void) {
+    if (G_batch.state != BatchStateReviewing) {
+        fail(ApduReplySdkInvalidState);
+    }
+    G_batch.state = BatchStateApproved;
+    return 0;
+}
+
+void handle_sign_message_batch(volatile unsigned int *flags, volatile unsigned int *tx) {
+    if (!tx || G_command.instruction != InsSignMessageBatch ||
+        G_command.state != ApduStatePayloadComplete) {
+        THROW(ApduReplySdkInvalidParameter);
+    }
+    // a swap signs exactly one transaction
+    if (G_called_from_swap) {
+        fail(ApduReplySdkNotSupported);
+    }
+
+    if (G_command.p2 & P2_SECOND_PASS) {
+        sign_transaction(tx);
+    }
+
+    queue_transaction();
+    // P1_NON_CONFIRM: more transactions follow, P1_CONFIRM: review them all
+    if (G_command.non_confirm) {
+        THROW(ApduReplySuccess);
+    }
+
+    G_batch.state = BatchStateReviewing;
+    start_sign_batch_ui(get_sign_message_batch_page_count());
+
+    *flags |= IO_ASYNCH_REPLY;
+}
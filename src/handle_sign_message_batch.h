@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stddef.h>
+
+// Up to MAX_BATCH_TRANSACTIONS transactions are queued, reviewed at once and
+// then sent again to be signed, see doc/api.md. Only their hashes and
+// rendered review pages are kept, never the transactions themselves.
+
+void handle_sign_message_batch(volatile unsigned int *flags, volatile unsigned int *tx);
+
+// Review pages of the queued batch: an overview, then the pages of every
+// transaction
+size_t get_sign_message_batch_page_count(void);
+void get_sign_message_batch_page(size_t index,
+                                 char *title,
+                                 size_t title_size,
+                                 char *text,
+                                 size_t text_size);
+
+// The user approved the batch, its transactions may now be signed
+uint8_t set_result_sign_message_batch(void);
+
+// Forget the queued batch, whatever its state
+void sign_message_batch_reset(void);
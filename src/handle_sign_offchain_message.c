@@ -8,6 +8,7 @@
 #include "sol/print_config.h"
 #include "sol/message.h"
 #include "sol/transaction_summary.h"
+#include "sol/text.h"
 #include "globals.h"
 #include "apdu.h"
 #include "handle_sign_offchain_message.h"
@@ -16,68 +17,40 @@
 // Store locally the derived public key content
 static Pubkey G_publicKey;
 
-/**
- * Checks if data is in UTF-8 format.
- * Adapted from: https://www.cl.cam.ac.uk/~mgk25/ucs/utf8_check.c
- */
-static bool is_data_utf8(const uint8_t *data, size_t length) {
-    if (!data) {
-        return false;
-    }
-    size_t i = 0;
-    while (i < length) {
-        if (data[i] < 0x80) {
-            /* 0xxxxxxx */
-            ++i;
-        } else if ((data[i] & 0xe0) == 0xc0) {
-            /* 110XXXXx 10xxxxxx */
-            if (i + 1 >= length || (data[i + 1] & 0xc0) != 0x80 ||
-                (data[i] & 0xfe) == 0xc0) /* overlong? */ {
-                return false;
-            } else {
-                i += 2;
-            }
-        } else if ((data[i] & 0xf0) == 0xe0) {
-            /* 1110XXXX 10Xxxxxx 10xxxxxx */
-            if (i + 2 >= length || (data[i + 1] & 0xc0) != 0x80 || (data[i + 2] & 0xc0) != 0x80 ||
-                (data[i] == 0xe0 && (data[i + 1] & 0xe0) == 0x80) || /* overlong? */
-                (data[i] == 0xed && (data[i + 1] & 0xe0) == 0xa0) || /* surrogate? */
-                (data[i] == 0xef && data[i + 1] == 0xbf &&
-                 (data[i + 2] & 0xfe) == 0xbe)) /* U+FFFE or U+FFFF? */ {
-                return false;
-            } else {
-                i += 3;
-            }
-        } else if ((data[i] & 0xf8) == 0xf0) {
-            /* 11110XXX 10XXxxxx 10xxxxxx 10xxxxxx */
-            if (i + 3 >= length || (data[i + 1] & 0xc0) != 0x80 || (data[i + 2] & 0xc0) != 0x80 ||
-                (data[i + 3] & 0xc0) != 0x80 ||
-                (data[i] == 0xf0 && (data[i + 1] & 0xf0) == 0x80) || /* overlong? */
-                (data[i] == 0xf4 && data[i + 1] > 0x8f) || data[i] > 0xf4) /* > U+10FFFF? */ {
-                return false;
-            } else {
-                i += 4;
-            }
-        } else {
-            return false;
-        }
-    }
-    return true;
-}
+MessagePager G_offchain_message_pager;
 
-/*
- * Checks if data is in ASCII format
- */
-static bool is_data_ascii(const uint8_t *data, size_t length) {
-    if (!data) {
-        return false;
+void get_offchain_message_page(size_t index,
+                               char *title,
+                               size_t title_size,
+                               char *text,
+                               size_t text_size) {
+    const uint8_t *page = NULL;
+    const size_t page_length = message_pager_get_page(&G_offchain_message_pager, index, &page);
+    if (page_length == 0 || page_length >= text_size) {
+        THROW(ApduReplySolanaSummaryUpdateFailed);
     }
-    for (size_t i = 0; i < length; ++i) {
-        if (data[i] < 0x20 || data[i] > 0x7e) {
-            return false;
+    memcpy(text, page, page_length);
+    text[page_length] = '\0';
+
+    strlcpy(title, "Message", title_size);
+    if (G_offchain_message_pager.page_count > 1) {
+        size_t used = strlen(title);
+        if (used + 1 >= title_size) {
+            THROW(ApduReplySolanaSummaryUpdateFailed);
+        }
+        title[used++] = ' ';
+        if (print_u64(index + 1, title + used, title_size - used) != 0) {
+            THROW(ApduReplySolanaSummaryUpdateFailed);
+        }
+        used = strlen(title);
+        if (used + 1 >= title_size) {
+            THROW(ApduReplySolanaSummaryUpdateFailed);
+        }
+        title[used++] = '/';
+        if (print_u64(G_offchain_message_pager.page_count, title + used, title_size - used) != 0) {
+            THROW(ApduReplySolanaSummaryUpdateFailed);
         }
     }
-    return true;
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -119,12 +92,14 @@ void handle_sign_offchain_message(volatile unsigned int *flags, volatile unsigne
         THROW(ApduReplySdkNotSupported);
     }
 
-    // compute message hash if needed
-    if (!is_ascii || N_storage.settings.display_mode == DisplayModeExpert) {
-        cx_hash_sha256(G_command.message,
-                       G_command.message_length,
-                       (uint8_t *) &G_command.message_hash,
-                       HASH_LENGTH);
+    // G_command.message_hash was computed by apdu_handle_message() during reception
+
+    // split the text for review once, pages are then fetched in O(1)
+    if (is_ascii && message_pager_init(&G_offchain_message_pager,
+                                       G_command.message + OFFCHAIN_MESSAGE_HEADER_LENGTH,
+                                       header.length,
+                                       OFFCHAIN_MESSAGE_PAGE_LENGTH) != 0) {
+        THROW(ApduReplySolanaInvalidMessageSize);
     }
 
     // fill out UX steps
@@ -139,8 +114,8 @@ void handle_sign_offchain_message(volatile unsigned int *flags, volatile unsigne
         summary_item_set_hash(transaction_summary_general_item(), "Hash", &G_command.message_hash);
 
         get_public_key(G_publicKey.data,
-                       G_command.derivation_path,
-                       G_command.derivation_path_length);
+                       G_command.derivation_paths[0],
+                       G_command.derivation_path_lengths[0]);
         summary_item_set_pubkey(transaction_summary_general_item(), "Signer", &G_publicKey);
     } else if (!is_ascii) {
         summary_item_set_hash(transaction_summary_general_item(), "Hash", &G_command.message_hash);
@@ -153,6 +128,7 @@ void handle_sign_offchain_message(volatile unsigned int *flags, volatile unsigne
     }
 
     start_sign_offchain_message_ui(is_ascii, num_summary_steps);
+    stage_signer_keys_later();
 
     *flags |= IO_ASYNCH_REPLY;
 }
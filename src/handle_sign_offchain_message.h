@@ -3,5 +3,30 @@
 #include "os.h"
 #include "cx.h"
 #include "globals.h"
+#include "sol/message_pager.h"
+
+// ASCII messages are reviewed one page at a time, a page being sized to fit
+// a review pair (NBGL) or a paging step (BAGL)
+#ifdef HAVE_NBGL
+#define OFFCHAIN_MESSAGE_PAGE_LENGTH 128
+#else
+#define OFFCHAIN_MESSAGE_PAGE_LENGTH 64
+#endif
+// Every page but the last is at least 3/4 full, see sol/message_pager.h
+#define OFFCHAIN_MESSAGE_MIN_PAGE_LENGTH \
+    (OFFCHAIN_MESSAGE_PAGE_LENGTH - OFFCHAIN_MESSAGE_PAGE_LENGTH / 4)
+#define OFFCHAIN_MESSAGE_MAX_PAGES                                                 \
+    ((MAX_OFFCHAIN_MESSAGE_LENGTH + OFFCHAIN_MESSAGE_MIN_PAGE_LENGTH - 1) /        \
+     OFFCHAIN_MESSAGE_MIN_PAGE_LENGTH)
+
+// Page breaks of the ASCII message under review
+extern MessagePager G_offchain_message_pager;
 
 void handle_sign_offchain_message(volatile unsigned int *flags, volatile unsigned int *tx);
+
+// Render page index of the message under review and its "Message i/n" title
+void get_offchain_message_page(size_t index,
+                               char *title,
+                               size_t title_size,
+                               char *text,
+                               size_t text_size);
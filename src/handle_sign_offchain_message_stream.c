@@ -0,0 +1,255 @@
+#include "io.h"
+#include "os.h"
+#include "ux.h"
+#include "cx.h"
+#include "lib_standard_app/crypto_helpers.h"
+#include "utils.h"
+#include "sol/parser.h"
+#include "sol/printer.h"
+#include "sol/print_config.h"
+#include "sol/transaction_summary.h"
+#include "globals.h"
+#include "apdu.h"
+#include "ed25519_stream.h"
+#include "handle_sign_offchain_message_stream.h"
+#include "ui_api.h"
+
+typedef enum StreamState {
+    StreamStateIdle = 0,
+    StreamStateFirstPass,
+    StreamStateFirstPassComplete,
+    StreamStateSecondPass,
+    StreamStateReadyToSign,
+} StreamState;
+
+typedef struct OffchainMessageStream {
+    StreamState state;
+    uint32_t derivation_path[MAX_BIP32_PATH_LENGTH];
+    uint32_t derivation_path_length;
+    OffchainMessageHeader header;
+    // Header included, as signed
+    size_t message_length;
+    size_t received_length;
+    Ed25519Stream signer;
+    // SHA-256 of each pass, the second must match the first before signing
+    cx_sha256_t message_hash_context;
+    Hash message_hash;
+    Pubkey public_key;
+    // Computed once the second pass is complete, sent if the review approves
+    uint8_t signature[SIGNATURE_LENGTH];
+} OffchainMessageStream;
+
+static OffchainMessageStream G_stream;
+
+void sign_offchain_message_stream_reset(void) {
+    explicit_bzero(&G_stream, sizeof(G_stream));
+}
+
+const uint8_t *sign_offchain_message_stream_signature(void) {
+    return G_stream.signature;
+}
+
+static void fail(int error) {
+    sign_offchain_message_stream_reset();
+    THROW(error);
+}
+
+static void check(cx_err_t cx_err) {
+    if (cx_err != CX_OK) {
+        fail(ApduReplySdkException);
+    }
+}
+
+static cx_err_t derive_private_key(cx_ecfp_private_key_t *private_key) {
+    return bip32_derive_with_seed_init_privkey_256(HDW_ED25519_SLIP10,
+                                                   CX_CURVE_Ed25519,
+                                                   G_stream.derivation_path,
+                                                   G_stream.derivation_path_length,
+                                                   private_key,
+                                                   NULL,
+                                                   NULL,
+                                                   0);
+}
+
+static void update_hashes(const uint8_t *data, size_t length) {
+    if (G_stream.received_length + length > G_stream.message_length) {
+        fail(ApduReplySolanaInvalidMessageSize);
+    }
+    G_stream.received_length += length;
+    check(ed25519_stream_update(&G_stream.signer, data, length));
+    check(cx_hash_no_throw(&G_stream.message_hash_context.header, 0, data, length, NULL, 0));
+}
+
+static void start_first_pass(const uint8_t *data, size_t length) {
+    sign_offchain_message_stream_reset();
+
+    // the first chunk carries the signer and at least the message header
+    if (!length || data[0] != 1) {
+        fail(ApduReplySolanaInvalidMessage);
+    }
+    data++;
+    length--;
+    const int ret = read_derivation_path(data,
+                                         length,
+                                         G_stream.derivation_path,
+                                         &G_stream.derivation_path_length);
+    if (ret) {
+        fail(ret);
+    }
+    data += 1 + G_stream.derivation_path_length * 4;
+    length -= 1 + G_stream.derivation_path_length * 4;
+
+    Parser parser = {data, length};
+    if (parse_offchain_message_header(&parser, &G_stream.header) || G_stream.header.version != 0 ||
+        G_stream.header.format > 2) {
+        fail(ApduReplySolanaInvalidMessageHeader);
+    }
+    // the text is never displayed, only its hash
+    if (N_storage.settings.allow_blind_sign != BlindSignEnabled) {
+        fail(ApduReplySdkNotSupported);
+    }
+    G_stream.message_length = OFFCHAIN_MESSAGE_HEADER_LENGTH + G_stream.header.length;
+
+    cx_ecfp_private_key_t private_key;
+    cx_err_t cx_err = derive_private_key(&private_key);
+    if (cx_err == CX_OK) {
+        cx_err = ed25519_stream_init(&G_stream.signer, &private_key);
+    }
+    explicit_bzero(&private_key, sizeof(private_key));
+    check(cx_err);
+    check(cx_sha256_init_no_throw(&G_stream.message_hash_context));
+
+    G_stream.state = StreamStateFirstPass;
+    update_hashes(data, length);
+}
+
+static void finish_first_pass(void) {
+    check(cx_hash_no_throw(&G_stream.message_hash_context.header,
+                           CX_LAST,
+                           NULL,
+                           0,
+                           G_stream.message_hash.data,
+                           HASH_LENGTH));
+
+    cx_ecfp_private_key_t private_key;
+    cx_err_t cx_err = derive_private_key(&private_key);
+    if (cx_err == CX_OK) {
+        cx_err = ed25519_stream_finish_first_pass(&G_stream.signer, &private_key);
+    }
+    explicit_bzero(&private_key, sizeof(private_key));
+    check(cx_err);
+    memcpy(G_stream.public_key.data, G_stream.signer.public_key, PUBKEY_SIZE);
+
+    check(cx_sha256_init_no_throw(&G_stream.message_hash_context));
+    G_stream.received_length = 0;
+    G_stream.state = StreamStateFirstPassComplete;
+}
+
+// Sign once the second pass proved to carry the same message, the
+// signature is only sent if the review approves it
+static void finish_second_pass(void) {
+    Hash second_pass_hash;
+    check(cx_hash_no_throw(&G_stream.message_hash_context.header,
+                           CX_LAST,
+                           NULL,
+                           0,
+                           second_pass_hash.data,
+                           HASH_LENGTH));
+    // the hash on screen must be the one of the message signed
+    if (memcmp(second_pass_hash.data, G_stream.message_hash.data, HASH_LENGTH) != 0) {
+        fail(ApduReplySolanaInvalidMessage);
+    }
+
+    cx_ecfp_private_key_t private_key;
+    cx_err_t cx_err = derive_private_key(&private_key);
+    if (cx_err == CX_OK) {
+        cx_err =
+            ed25519_stream_finish_second_pass(&G_stream.signer, &private_key, G_stream.signature);
+    }
+    explicit_bzero(&private_key, sizeof(private_key));
+    check(cx_err);
+    G_stream.state = StreamStateReadyToSign;
+}
+
+uint8_t set_result_sign_offchain_message_stream(void) {
+    if (G_stream.state != StreamStateReadyToSign) {
+        fail(ApduReplySdkInvalidState);
+    }
+    memcpy(G_io_apdu_buffer, G_stream.signature, SIGNATURE_LENGTH);
+    sign_offchain_message_stream_reset();
+    return SIGNATURE_LENGTH;
+}
+
+static void start_sign_offchain_message_stream_ui(void) {
+    transaction_summary_reset();
+    SummaryItem *item = transaction_summary_primary_item();
+    summary_item_set_string(item, "Sign", "Off-Chain Message");
+
+    if (N_storage.settings.display_mode == DisplayModeExpert) {
+        summary_item_set_u64(transaction_summary_general_item(),
+                             "Version",
+                             G_stream.header.version);
+        summary_item_set_u64(transaction_summary_general_item(), "Format", G_stream.header.format);
+        summary_item_set_u64(transaction_summary_general_item(), "Size", G_stream.header.length);
+        summary_item_set_hash(transaction_summary_general_item(), "Hash", &G_stream.message_hash);
+        summary_item_set_pubkey(transaction_summary_general_item(), "Signer", &G_stream.public_key);
+    } else {
+        summary_item_set_hash(transaction_summary_general_item(), "Hash", &G_stream.message_hash);
+    }
+
+    enum SummaryItemKind summary_step_kinds[MAX_TRANSACTION_SUMMARY_ITEMS];
+    size_t num_summary_steps = 0;
+    if (transaction_summary_finalize(summary_step_kinds, &num_summary_steps)) {
+        fail(ApduReplySolanaSummaryFinalizeFailed);
+    }
+
+    start_sign_offchain_message_ui(false, num_summary_steps);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void handle_sign_offchain_message_stream(volatile unsigned int *flags, volatile unsigned int *tx) {
+    if (!tx || G_command.instruction != InsSignOffchainMessageStream ||
+        G_command.state != ApduStatePayloadComplete) {
+        THROW(ApduReplySdkInvalidParameter);
+    }
+    if (G_command.non_confirm) {
+        fail(ApduReplySdkNotSupported);
+    }
+
+    const uint8_t p2 = G_command.p2;
+    const bool second_pass = p2 & P2_SECOND_PASS;
+    const bool extend = p2 & P2_EXTEND;
+    const uint8_t *data = G_command.message;
+    const size_t length = G_command.message_length;
+
+    if (!second_pass && !extend) {
+        start_first_pass(data, length);
+    } else if (!second_pass && G_stream.state == StreamStateFirstPass) {
+        update_hashes(data, length);
+    } else if (second_pass && !extend && G_stream.state == StreamStateFirstPassComplete) {
+        G_stream.state = StreamStateSecondPass;
+        update_hashes(data, length);
+    } else if (second_pass && extend && G_stream.state == StreamStateSecondPass) {
+        update_hashes(data, length);
+    } else {
+        fail(ApduReplySolanaInvalidMessage);
+    }
+
+    if (p2 & P2_MORE) {
+        THROW(ApduReplySuccess);
+    }
+    if (G_stream.received_length != G_stream.message_length) {
+        fail(ApduReplySolanaInvalidMessageSize);
+    }
+
+    if (G_stream.state == StreamStateFirstPass) {
+        finish_first_pass();
+        THROW(ApduReplySuccess);
+    }
+
+    finish_second_pass();
+    start_sign_offchain_message_stream_ui();
+
+    *flags |= IO_ASYNCH_REPLY;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "os.h"
+#include "cx.h"
+#include "globals.h"
+
+// Off-chain messages too large for G_command.message are signed in two
+// passes over the same bytes, see doc/api.md and ed25519_stream.h. Only
+// running hashes are kept between APDUs, so memory does not grow with the
+// message, and the nonce is recomputed rather than kept. The signature is
+// computed when the second pass completes and kept while the review is on
+// screen: it is returned once approved and wiped on rejection.
+
+void handle_sign_offchain_message_stream(volatile unsigned int *flags, volatile unsigned int *tx);
+
+// Write the signature of the reviewed streamed message to G_io_apdu_buffer
+uint8_t set_result_sign_offchain_message_stream(void);
+
+// Forget any stream in progress, wiping its signature
+void sign_offchain_message_stream_reset(void);
+
+// Signature kept for the review, all zeros once the stream is forgotten
+const uint8_t *sign_offchain_message_stream_signature(void);
@@ -27,6 +27,7 @@
 #endif  // HAVE_NBGL
 
 #include "apdu.h"
+#include "utils.h"
 #include "ui_api.h"
 #include "handle_swap_sign_transaction.h"
 #include "io.h"
@@ -69,6 +70,8 @@ uint8_t io_event(uint8_t channel) {
             break;
 #endif  // HAVE_NBGL
         case SEPROXYHAL_TAG_TICKER_EVENT:
+            // The review is on screen by the first tick after it started
+            stage_signer_keys();
             UX_TICKER_EVENT(G_io_seproxyhal_spi_buffer, {});
             break;
         default:
@@ -115,6 +118,9 @@ static void write_u16_be(uint8_t *ptr, size_t offset, uint16_t value) {
 }
 
 void sendResponse(uint8_t tx, uint16_t sw, bool display_menu) {
+    // The review is over, approved or not
+    wipe_staged_signer_keys();
+
     // Write status word
     write_u16_be(G_io_apdu_buffer, tx, sw);
     tx += 2;
@@ -19,8 +19,15 @@
 #include "handle_get_pubkey.h"
 #include "handle_sign_message.h"
 #include "handle_sign_offchain_message.h"
+#include "handle_sign_offchain_message_stream.h"
+#include "handle_sign_message_batch.h"
+#include "handle_set_signing_policy.h"
+#include "handle_provide_token_descriptor.h"
+#include "capabilities.h"
 #include "apdu.h"
 #include "ui_api.h"
+#include "sol/token_cache.h"
+#include "sol/pubkey_cache.h"
 
 // Swap feature
 #include "swap_lib_calls.h"
@@ -36,10 +43,19 @@ ApduCommand G_command;
 unsigned char G_io_seproxyhal_spi_buffer[IO_SEPROXYHAL_BUFFER_SIZE_B];
 volatile bool G_called_from_swap;
 volatile bool G_swap_response_ready;
+// Set when the chunk just handled started a transaction whose signer keys are
+// still to be derived, app_main() does it after answering
+static volatile bool G_derive_signer_pubkeys;
 
 static void reset_main_globals(void) {
     MEMCLEAR(G_command);
     MEMCLEAR(G_io_seproxyhal_spi_buffer);
+    token_cache_reset();
+    pubkey_cache_reset();
+    sign_offchain_message_stream_reset();
+    sign_message_batch_reset();
+    sign_message_forget_summary();
+    wipe_staged_signer_keys();
 }
 
 void handleApdu(volatile unsigned int *flags, volatile unsigned int *tx, int rx) {
@@ -51,13 +67,36 @@ void handleApdu(volatile unsigned int *flags, volatile unsigned int *tx, int rx)
         THROW(ApduReplySdkExceptionIoOverflow);
     }
 
+    // Keys are only staged for the review in progress
+    wipe_staged_signer_keys();
+
     const int ret = apdu_handle_message(G_io_apdu_buffer, rx, &G_command);
+    if (ret == ApduReplySuccess) {
+        // A stale or repeated chunk, the command in progress is left as is
+        THROW(ApduReplySuccess);
+    }
     if (ret != 0) {
         MEMCLEAR(G_command);
+        sign_offchain_message_stream_reset();
+        sign_message_batch_reset();
+        sign_message_forget_summary();
         THROW(ret);
     }
 
+    reset_interrupted_commands(G_command.instruction);
+
     if (G_command.state == ApduStatePayloadInProgress) {
+        if ((G_command.instruction == InsDeprecatedSignMessage ||
+             G_command.instruction == InsSignMessage) &&
+            !G_command.signer_pubkeys_derived) {
+            G_derive_signer_pubkeys = true;
+        }
+        if (G_command.p2 & P2_OFFSET) {
+            // the host resumes from the committed length, whatever was lost
+            G_io_apdu_buffer[0] = G_command.transfer_committed >> 8;
+            G_io_apdu_buffer[1] = G_command.transfer_committed;
+            *tx = 2;
+        }
         THROW(ApduReplySuccess);
     }
 
@@ -70,6 +109,10 @@ void handleApdu(volatile unsigned int *flags, volatile unsigned int *tx, int rx)
             G_io_apdu_buffer[3] = MINOR_VERSION;
             G_io_apdu_buffer[4] = PATCH_VERSION;
             *tx = 5;
+            if (G_command.instruction == InsGetAppConfiguration) {
+                // room is left for the status word, in a short response
+                *tx += write_capabilities(G_io_apdu_buffer + 5, SHORT_APDU_BUFFER_SIZE - 5 - 2);
+            }
             THROW(ApduReplySuccess);
 
         case InsDeprecatedGetPubkey:
@@ -87,6 +130,26 @@ void handleApdu(volatile unsigned int *flags, volatile unsigned int *tx, int rx)
             handle_sign_offchain_message(flags, tx);
             break;
 
+        case InsProvideTokenDescriptor:
+            handle_provide_token_descriptor(tx);
+            break;
+
+        case InsGetPubkeyBatch:
+            handle_get_pubkey_batch(tx);
+            break;
+
+        case InsSignOffchainMessageStream:
+            handle_sign_offchain_message_stream(flags, tx);
+            break;
+
+        case InsSignMessageBatch:
+            handle_sign_message_batch(flags, tx);
+            break;
+
+        case InsSetSigningPolicy:
+            handle_set_signing_policy(flags, tx);
+            break;
+
         default:
             THROW(ApduReplyUnimplementedInstruction);
     }
@@ -115,6 +178,15 @@ void app_main(void) {
                 rx = tx;
                 tx = 0;  // ensure no race in catch_other if io_exchange throws
                          // an error
+                if (G_derive_signer_pubkeys) {
+                    // Answer first, the signer keys are then derived while
+                    // the host sends the next chunk. A failure is not
+                    // reported here, the handler derives again and throws.
+                    G_derive_signer_pubkeys = false;
+                    io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, rx);
+                    rx = 0;
+                    derive_signer_pubkeys(&G_command);
+                }
                 rx = io_exchange(CHANNEL_APDU | flags, rx);
                 flags = 0;
 
@@ -161,6 +233,10 @@ void app_main(void) {
 }
 
 void app_exit(void) {
+    // Provisioned token descriptors and derived keys only live for the
+    // current session
+    token_cache_reset();
+    pubkey_cache_reset();
     BEGIN_TRY_L(exit) {
         TRY_L(exit) {
             os_sched_exit(-1);
@@ -181,6 +257,7 @@ void nv_app_state_init() {
         storage.settings.pubkey_display = PubkeyDisplayShort;
 #endif
         storage.settings.display_mode = DisplayModeUser;
+        explicit_bzero(&storage.policy, sizeof(storage.policy));
         storage.initialized = 0x01;
         nvm_write((void *) &N_storage, (void *) &storage, sizeof(internalStorage_t));
     }
@@ -253,6 +330,8 @@ static void start_app_from_lib(void) {
 }
 
 static void library_main_helper(libargs_t *args) {
+    // Nothing derived outside of the swap session may be trusted in it
+    pubkey_cache_reset();
     switch (args->command) {
         case CHECK_ADDRESS:
             // ensure result is zero if an exception is thrown
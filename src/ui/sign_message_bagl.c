@@ -10,14 +10,31 @@
 #include "apdu.h"
 
 #include "handle_sign_message.h"
+#include "handle_sign_offchain_message.h"
+#include "handle_sign_offchain_message_stream.h"
+#include "handle_sign_message_batch.h"
+#include "handle_set_signing_policy.h"
 
-// Display offchain message screen
-UX_STEP_NOCB(ux_sign_msg_text_step,
-             bnnn_paging,
-             {
-                 .title = "Message",
-                 .text = (const char *) G_command.message + OFFCHAIN_MESSAGE_HEADER_LENGTH,
-             });
+// Flow index of the first offchain message page
+static size_t first_message_page_step;
+static char message_page_title[sizeof("Message 99/99")];
+static char message_page_text[OFFCHAIN_MESSAGE_PAGE_LENGTH + 1];
+
+// Display one page of the offchain message
+UX_STEP_NOCB_INIT(ux_sign_msg_text_step,
+                  bnnn_paging,
+                  {
+                      size_t step_index = G_ux.flow_stack[stack_slot].index;
+                      get_offchain_message_page(step_index - first_message_page_step,
+                                                message_page_title,
+                                                sizeof(message_page_title),
+                                                message_page_text,
+                                                sizeof(message_page_text));
+                  },
+                  {
+                      .title = message_page_title,
+                      .text = message_page_text,
+                  });
 
 // Display dynamic transaction item screen
 UX_STEP_NOCB_INIT(ux_summary_step,
@@ -37,10 +54,46 @@ UX_STEP_NOCB_INIT(ux_summary_step,
                       .text = G_transaction_summary_text,
                   });
 
+// Display one page of a batch review
+UX_STEP_NOCB_INIT(ux_batch_page_step,
+                  bnnn_paging,
+                  {
+                      size_t step_index = G_ux.flow_stack[stack_slot].index;
+                      get_sign_message_batch_page(step_index,
+                                                  G_transaction_summary_title,
+                                                  sizeof(G_transaction_summary_title),
+                                                  G_transaction_summary_text,
+                                                  sizeof(G_transaction_summary_text));
+                  },
+                  {
+                      .title = G_transaction_summary_title,
+                      .text = G_transaction_summary_text,
+                  });
+
+// Streamed off-chain messages and batches are signed from the state kept by
+// their handler, a reviewed signing policy is installed
+static uint8_t set_result_sign(void) {
+    if (G_command.instruction == InsSignOffchainMessageStream) {
+        return set_result_sign_offchain_message_stream();
+    }
+    if (G_command.instruction == InsSignMessageBatch) {
+        return set_result_sign_message_batch();
+    }
+    if (G_command.instruction == InsSetSigningPolicy) {
+        return set_result_set_signing_policy();
+    }
+    return set_result_sign_message();
+}
+
+static void reject_sign(void) {
+    reset_rejected_command(G_command.instruction);
+    sendResponse(0, ApduReplyUserRefusal, true);
+}
+
 // Approve and sign screen
 UX_STEP_CB(ux_approve_step,
            pb,
-           sendResponse(set_result_sign_message(), ApduReplySuccess, true),
+           sendResponse(set_result_sign(), ApduReplySuccess, true),
            {
                &C_icon_validate_14,
                "Approve",
@@ -49,7 +102,7 @@ UX_STEP_CB(ux_approve_step,
 // Reject signature screen
 UX_STEP_CB(ux_reject_step,
            pb,
-           sendResponse(0, ApduReplyUserRefusal, true),
+           reject_sign(),
            {
                &C_icon_crossmark,
                "Reject",
@@ -74,14 +127,25 @@ else if utf8:
 - Hash
 
 if ascii:
-- message text
+- message text, one step per page
+*/
+#define MAX_FLOW_STEPS_OFFCHAIN                          \
+    (6 + OFFCHAIN_MESSAGE_MAX_PAGES + 1 /* approve */    \
+     + 1                                /* reject */     \
+     + 1                                /* FLOW_END_STEP */ \
+    )
+/*
+BATCH UX Steps:
+- Sign batch
+- pages of every transaction
 */
-#define MAX_FLOW_STEPS_OFFCHAIN \
-    (7 + 1 /* approve */        \
-     + 1   /* reject */         \
-     + 1   /* FLOW_END_STEP */  \
+#define MAX_FLOW_STEPS_BATCH                             \
+    (1 + MAX_BATCH_PAGES + 1     /* approve */           \
+     + 1                         /* reject */            \
+     + 1                         /* FLOW_END_STEP */     \
     )
-static ux_flow_step_t const *flow_steps[MAX(MAX_FLOW_STEPS_ONCHAIN, MAX_FLOW_STEPS_OFFCHAIN)];
+static ux_flow_step_t const
+    *flow_steps[MAX(MAX(MAX_FLOW_STEPS_ONCHAIN, MAX_FLOW_STEPS_OFFCHAIN), MAX_FLOW_STEPS_BATCH)];
 
 void start_sign_tx_ui(size_t num_summary_steps) {
     MEMCLEAR(flow_steps);
@@ -104,7 +168,10 @@ void start_sign_offchain_message_ui(bool is_ascii, size_t num_summary_steps) {
         flow_steps[num_flow_steps++] = &ux_summary_step;
     }
     if (is_ascii) {
-        flow_steps[num_flow_steps++] = &ux_sign_msg_text_step;
+        first_message_page_step = num_flow_steps;
+        for (size_t i = 0; i < G_offchain_message_pager.page_count; i++) {
+            flow_steps[num_flow_steps++] = &ux_sign_msg_text_step;
+        }
     }
     flow_steps[num_flow_steps++] = &ux_approve_step;
     flow_steps[num_flow_steps++] = &ux_reject_step;
@@ -113,4 +180,23 @@ void start_sign_offchain_message_ui(bool is_ascii, size_t num_summary_steps) {
     ux_flow_init(0, flow_steps, NULL);
 }
 
+void start_sign_batch_ui(size_t num_pages) {
+    MEMCLEAR(flow_steps);
+    size_t num_flow_steps = 0;
+    for (size_t i = 0; i < num_pages; i++) {
+        flow_steps[num_flow_steps++] = &ux_batch_page_step;
+    }
+
+    flow_steps[num_flow_steps++] = &ux_approve_step;
+    flow_steps[num_flow_steps++] = &ux_reject_step;
+    flow_steps[num_flow_steps++] = FLOW_END_STEP;
+
+    ux_flow_init(0, flow_steps, NULL);
+}
+
+// A policy is reviewed like a transaction, its summary lists its fields
+void start_set_signing_policy_ui(size_t num_summary_steps) {
+    start_sign_tx_ui(num_summary_steps);
+}
+
 #endif
@@ -16,6 +16,9 @@
 
 #include "handle_sign_message.h"
 #include "handle_sign_offchain_message.h"
+#include "handle_sign_offchain_message_stream.h"
+#include "handle_sign_message_batch.h"
+#include "handle_set_signing_policy.h"
 
 // Content of the review flow
 static nbgl_contentTagValueList_t content;
@@ -34,19 +37,44 @@ static dynamic_slot_t displayed_slots[MAX_SIMULTANEOUS_DISPLAYED_SLOTS];
 
 // NBGL library has to know how many steps will be displayed
 static size_t transaction_steps_number;
-static bool last_step_is_ascii;
+// ASCII message pages are the last steps, starting at this index
+static bool last_steps_are_ascii;
+static size_t first_message_page_step;
+// Batch reviews display pages rendered by their handler
+static bool steps_are_batch_pages;
+
+// A page can be longer than a slot. Consecutive pages alternate between two
+// buffers, so that NBGL fetching the next pair to see if it fits on the
+// current screen does not overwrite the page it is about to draw.
+typedef struct message_page_slot_s {
+    char title[sizeof(G_transaction_summary_title)];
+    char text[OFFCHAIN_MESSAGE_PAGE_LENGTH + 1];
+} message_page_slot_t;
+static message_page_slot_t message_page_slots[2];
 
 // function called by NBGL to get the current_pair indexed by "index"
 // current_pair will point at values stored in displayed_slots[]
 // this will enable displaying at most sizeof(displayed_slots) values simultaneously
 static nbgl_contentTagValue_t *get_single_action_review_pair(uint8_t index) {
     uint8_t slot = index % ARRAY_COUNT(displayed_slots);
-    // Final step is special for ASCII messages
-    if (index == transaction_steps_number - 1 && last_step_is_ascii) {
-        strlcpy(displayed_slots[slot].title, "Message", sizeof(displayed_slots[slot].title));
-        strlcpy(displayed_slots[slot].text,
-                (const char *) G_command.message + OFFCHAIN_MESSAGE_HEADER_LENGTH,
-                sizeof(displayed_slots[slot].text));
+    // Final steps are special for ASCII messages
+    if (last_steps_are_ascii && index >= first_message_page_step) {
+        message_page_slot_t *page_slot =
+            &message_page_slots[index % ARRAY_COUNT(message_page_slots)];
+        get_offchain_message_page(index - first_message_page_step,
+                                  page_slot->title,
+                                  sizeof(page_slot->title),
+                                  page_slot->text,
+                                  sizeof(page_slot->text));
+        current_pair.item = page_slot->title;
+        current_pair.value = page_slot->text;
+        return &current_pair;
+    } else if (steps_are_batch_pages) {
+        get_sign_message_batch_page(index,
+                                    displayed_slots[slot].title,
+                                    sizeof(displayed_slots[slot].title),
+                                    displayed_slots[slot].text,
+                                    sizeof(displayed_slots[slot].text));
     } else {
         enum DisplayFlags flags = DisplayFlagNone;
         if (N_storage.settings.pubkey_display == PubkeyDisplayLong) {
@@ -67,22 +95,40 @@ static nbgl_contentTagValue_t *get_single_action_review_pair(uint8_t index) {
     return &current_pair;
 }
 
+static uint8_t set_result_sign(void) {
+    if (G_command.instruction == InsSignOffchainMessageStream) {
+        return set_result_sign_offchain_message_stream();
+    }
+    if (G_command.instruction == InsSignMessageBatch) {
+        return set_result_sign_message_batch();
+    }
+    if (G_command.instruction == InsSetSigningPolicy) {
+        return set_result_set_signing_policy();
+    }
+    return set_result_sign_message();
+}
+
 static void review_choice(bool confirm) {
     // Answer, display a status page and go back to main
     // validate_transaction(confirm);
     nbgl_reviewStatusType_t status_type;
     if (confirm) {
-        sendResponse(set_result_sign_message(), ApduReplySuccess, false);
+        sendResponse(set_result_sign(), ApduReplySuccess, false);
         if (operation_type == TYPE_MESSAGE) {
             status_type = STATUS_TYPE_MESSAGE_SIGNED;
+        } else if (operation_type == TYPE_OPERATION) {
+            status_type = STATUS_TYPE_OPERATION_SIGNED;
         } else {
             status_type = STATUS_TYPE_TRANSACTION_SIGNED;
         }
         nbgl_useCaseReviewStatus(status_type, ui_idle);
     } else {
+        reset_rejected_command(G_command.instruction);
         sendResponse(0, ApduReplyUserRefusal, false);
         if (operation_type == TYPE_MESSAGE) {
             status_type = STATUS_TYPE_MESSAGE_REJECTED;
+        } else if (operation_type == TYPE_OPERATION) {
+            status_type = STATUS_TYPE_OPERATION_REJECTED;
         } else {
             status_type = STATUS_TYPE_TRANSACTION_REJECTED;
         }
@@ -96,7 +142,8 @@ void start_sign_tx_ui(size_t num_summary_steps) {
 
     // Save steps number for later
     transaction_steps_number = num_summary_steps;
-    last_step_is_ascii = false;
+    last_steps_are_ascii = false;
+    steps_are_batch_pages = false;
 
     // Initialize the content structure
     content.nbMaxLinesForValue = 0;
@@ -123,9 +170,11 @@ void start_sign_offchain_message_ui(bool is_ascii, size_t num_summary_steps) {
 
     // Save steps number for later
     transaction_steps_number = num_summary_steps;
-    last_step_is_ascii = is_ascii;
+    last_steps_are_ascii = is_ascii;
+    steps_are_batch_pages = false;
+    first_message_page_step = num_summary_steps;
     if (is_ascii) {
-        ++transaction_steps_number;
+        transaction_steps_number += G_offchain_message_pager.page_count;
     }
 
     // Initialize the content structure
@@ -146,4 +195,60 @@ void start_sign_offchain_message_ui(bool is_ascii, size_t num_summary_steps) {
                        "Sign off-chain message on Solana network?",
                        review_choice);
 }
+
+void start_sign_batch_ui(size_t num_pages) {
+    // Set the transaction type
+    operation_type = TYPE_TRANSACTION;
+
+    // Save steps number for later
+    transaction_steps_number = num_pages;
+    last_steps_are_ascii = false;
+    steps_are_batch_pages = true;
+
+    // Initialize the content structure
+    content.nbMaxLinesForValue = 0;
+    content.smallCaseForValue = false;
+    content.wrapping = true;
+    content.pairs = NULL;  // to indicate that callback should be used
+    content.callback = get_single_action_review_pair;
+    content.startIndex = 0;
+    content.nbPairs = transaction_steps_number;
+
+    // Start review
+    nbgl_useCaseReview(operation_type,
+                       &content,
+                       &C_icon_solana_64x64,
+                       "Review transactions",
+                       NULL,
+                       "Sign all transactions on Solana network?",
+                       review_choice);
+}
+
+void start_set_signing_policy_ui(size_t num_summary_steps) {
+    // A policy is approved, nothing is signed yet
+    operation_type = TYPE_OPERATION;
+
+    // Save steps number for later
+    transaction_steps_number = num_summary_steps;
+    last_steps_are_ascii = false;
+    steps_are_batch_pages = false;
+
+    // Initialize the content structure
+    content.nbMaxLinesForValue = 0;
+    content.smallCaseForValue = false;
+    content.wrapping = true;
+    content.pairs = NULL;  // to indicate that callback should be used
+    content.callback = get_single_action_review_pair;
+    content.startIndex = 0;
+    content.nbPairs = transaction_steps_number;
+
+    // Start review
+    nbgl_useCaseReview(operation_type,
+                       &content,
+                       &C_icon_solana_64x64,
+                       "Review signing policy",
+                       NULL,
+                       "Sign matching transactions without review?",
+                       review_choice);
+}
 #endif
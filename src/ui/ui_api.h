@@ -9,3 +9,7 @@ void ui_get_public_key(void);
 void start_sign_tx_ui(size_t num_summary_steps);
 
 void start_sign_offchain_message_ui(bool is_ascii, size_t num_summary_steps);
+
+void start_sign_batch_ui(size_t num_pages);
+
+void start_set_signing_policy_ui(size_t num_summary_steps);
@@ -4,15 +4,26 @@
 #include <stdlib.h>
 
 #include "lib_standard_app/crypto_helpers.h"
+#include "sol/pubkey_cache.h"
 
 #include "utils.h"
+#include "handle_sign_message.h"
+#include "handle_sign_message_batch.h"
+#include "handle_sign_offchain_message_stream.h"
 
-void get_public_key(uint8_t publicKeyArray[static PUBKEY_LENGTH],
-                    const uint32_t *derivationPath,
-                    size_t pathLength) {
+cx_err_t get_public_key_no_throw(uint8_t publicKeyArray[static PUBKEY_LENGTH],
+                                 const uint32_t *derivationPath,
+                                 size_t pathLength) {
     uint8_t rawPubkey[65];
     cx_err_t cx_err;
 
+    // Derivation is slow, keys already derived this session are reused
+    const Pubkey *cached = pubkey_cache_lookup(derivationPath, pathLength);
+    if (cached != NULL) {
+        memcpy(publicKeyArray, cached->data, PUBKEY_LENGTH);
+        return CX_OK;
+    }
+
     cx_err = bip32_derive_with_seed_get_pubkey_256(HDW_ED25519_SLIP10,
                                                    CX_CURVE_Ed25519,
                                                    derivationPath,
@@ -24,7 +35,7 @@ void get_public_key(uint8_t publicKeyArray[static PUBKEY_LENGTH],
                                                    0);
 
     if (CX_OK != cx_err) {
-        THROW(cx_err);
+        return cx_err;
     }
 
     for (int i = 0; i < PUBKEY_LENGTH; i++) {
@@ -33,6 +44,29 @@ void get_public_key(uint8_t publicKeyArray[static PUBKEY_LENGTH],
     if ((rawPubkey[PUBKEY_LENGTH] & 1) != 0) {
         publicKeyArray[PUBKEY_LENGTH - 1] |= 0x80;
     }
+    pubkey_cache_insert(derivationPath, pathLength, (const Pubkey *) publicKeyArray);
+    return CX_OK;
+}
+
+void get_public_key(uint8_t publicKeyArray[static PUBKEY_LENGTH],
+                    const uint32_t *derivationPath,
+                    size_t pathLength) {
+    const cx_err_t cx_err = get_public_key_no_throw(publicKeyArray, derivationPath, pathLength);
+    if (CX_OK != cx_err) {
+        THROW(cx_err);
+    }
+}
+
+bool derive_signer_pubkeys(ApduCommand *command) {
+    for (size_t i = 0; i < command->num_derivation_paths; i++) {
+        if (get_public_key_no_throw(command->signer_pubkeys[i].data,
+                                    command->derivation_paths[i],
+                                    command->derivation_path_lengths[i]) != CX_OK) {
+            return false;
+        }
+    }
+    command->signer_pubkeys_derived = true;
+    return true;
 }
 
 int read_derivation_path(const uint8_t *data_buffer,
@@ -65,25 +99,107 @@ int read_derivation_path(const uint8_t *data_buffer,
     return 0;
 }
 
+// Private keys of the signers of the message under review, derived while
+// the review is on screen so that approving only has to sign
+typedef struct StagedSignerKeys {
+    bool pending;
+    bool staged;
+    cx_ecfp_private_key_t keys[MAX_SIGNERS];
+} StagedSignerKeys;
+
+static StagedSignerKeys G_staged_signer_keys;
+
+void stage_signer_keys_later(void) {
+    wipe_staged_signer_keys();
+    G_staged_signer_keys.pending = true;
+}
+
+void stage_signer_keys(void) {
+    if (!G_staged_signer_keys.pending) {
+        return;
+    }
+    G_staged_signer_keys.pending = false;
+
+    for (size_t i = 0; i < G_command.num_derivation_paths; i++) {
+        if (bip32_derive_with_seed_init_privkey_256(HDW_ED25519_SLIP10,
+                                                    CX_CURVE_Ed25519,
+                                                    G_command.derivation_paths[i],
+                                                    G_command.derivation_path_lengths[i],
+                                                    &G_staged_signer_keys.keys[i],
+                                                    NULL,
+                                                    NULL,
+                                                    0) != CX_OK) {
+            // Signing derives them again
+            wipe_staged_signer_keys();
+            return;
+        }
+    }
+    G_staged_signer_keys.staged = true;
+}
+
+void wipe_staged_signer_keys(void) {
+    explicit_bzero(&G_staged_signer_keys, sizeof(G_staged_signer_keys));
+}
+
 uint8_t set_result_sign_message(void) {
-    size_t sigLen = SIGNATURE_LENGTH;
-    cx_err_t cx_err;
+    // One signature per requested signer, in request order
+    for (size_t i = 0; i < G_command.num_derivation_paths; i++) {
+        size_t sigLen = SIGNATURE_LENGTH;
+        cx_err_t cx_err;
 
-    cx_err = bip32_derive_with_seed_eddsa_sign_hash_256(HDW_ED25519_SLIP10,
-                                                        CX_CURVE_Ed25519,
-                                                        G_command.derivation_path,
-                                                        G_command.derivation_path_length,
-                                                        CX_SHA512,
-                                                        G_command.message,
-                                                        G_command.message_length,
-                                                        G_io_apdu_buffer,
-                                                        &sigLen,
-                                                        NULL,
-                                                        0);
+        if (G_staged_signer_keys.staged) {
+            cx_err = cx_eddsa_sign_no_throw(&G_staged_signer_keys.keys[i],
+                                            CX_SHA512,
+                                            G_command.message,
+                                            G_command.message_length,
+                                            G_io_apdu_buffer + i * SIGNATURE_LENGTH,
+                                            sigLen);
+        } else {
+            cx_err =
+                bip32_derive_with_seed_eddsa_sign_hash_256(HDW_ED25519_SLIP10,
+                                                           CX_CURVE_Ed25519,
+                                                           G_command.derivation_paths[i],
+                                                           G_command.derivation_path_lengths[i],
+                                                           CX_SHA512,
+                                                           G_command.message,
+                                                           G_command.message_length,
+                                                           G_io_apdu_buffer + i * SIGNATURE_LENGTH,
+                                                           &sigLen,
+                                                           NULL,
+                                                           0);
+        }
 
-    if (CX_OK != cx_err) {
-        THROW(cx_err);
+        if (CX_OK != cx_err) {
+            wipe_staged_signer_keys();
+            THROW(cx_err);
+        }
+    }
+    wipe_staged_signer_keys();
+
+    return G_command.num_derivation_paths * SIGNATURE_LENGTH;
+}
+
+void reset_rejected_command(InstructionCode instruction) {
+    // what was computed or queued for the approval goes with it
+    if (instruction == InsSignMessageBatch) {
+        sign_message_batch_reset();
     }
+    if (instruction == InsSignOffchainMessageStream) {
+        sign_offchain_message_stream_reset();
+    }
+}
 
-    return SIGNATURE_LENGTH;
+void reset_interrupted_commands(InstructionCode instruction) {
+    // a streamed signature must not be interleaved with other commands
+    if (instruction != InsSignOffchainMessageStream) {
+        sign_offchain_message_stream_reset();
+    }
+    // nor may a batch, between being queued and signed
+    if (instruction != InsSignMessageBatch) {
+        sign_message_batch_reset();
+    }
+    // nor may any other command come between a message and its re-sending
+    if (instruction != InsDeprecatedSignMessage && instruction != InsSignMessage) {
+        sign_message_forget_summary();
+    }
 }
@@ -25,6 +25,20 @@ void get_public_key(uint8_t publicKeyArray[static PUBKEY_LENGTH],
                     const uint32_t *derivationPath,
                     size_t pathLength);
 
+cx_err_t get_public_key_no_throw(uint8_t publicKeyArray[static PUBKEY_LENGTH],
+                                 const uint32_t *derivationPath,
+                                 size_t pathLength);
+
+/**
+ * Derive the public keys of the signers of a command into
+ * command->signer_pubkeys. Does not throw, so that it can run between
+ * answering an APDU and receiving the next one.
+ *
+ * @return true on success, false if a derivation failed.
+ *
+ */
+bool derive_signer_pubkeys(ApduCommand *command);
+
 /**
  * Deserialize derivation path from raw bytes.
  *
@@ -47,6 +61,23 @@ int read_derivation_path(const uint8_t *data_buffer,
 
 uint8_t set_result_sign_message(void);
 
+// Have the private keys of the signers in G_command derived on the next
+// stage_signer_keys() call, made once the review is on screen. Signing then
+// uses them, and falls back to deriving them if they are not there yet.
+void stage_signer_keys_later(void);
+void stage_signer_keys(void);
+
+// Forget the staged keys, whatever ends the review
+void wipe_staged_signer_keys(void);
+
+// Drop the state kept for the approval of instruction once its review was
+// rejected: queued batches and streamed signatures
+void reset_rejected_command(InstructionCode instruction);
+
+// Drop the state of the commands spanning several APDUs that instruction
+// interrupts: streamed signatures, batches and re-sent messages
+void reset_interrupted_commands(InstructionCode instruction);
+
 #endif  //_UTILS_H_
 
 // Outdated ?
@@ -1,4 +1,4 @@
-from typing import List, Generator
+from typing import Dict, List, Generator, Tuple
 from enum import IntEnum
 from contextlib import contextmanager
 
@@ -15,6 +15,37 @@ class INS(IntEnum):
     INS_GET_PUBKEY = 0x05
     INS_SIGN_MESSAGE = 0x06
     INS_SIGN_OFFCHAIN_MESSAGE = 0x07
+    INS_PROVIDE_TOKEN_DESCRIPTOR = 0x08
+    INS_SIGN_OFFCHAIN_MESSAGE_STREAM = 0x09
+    INS_GET_PUBKEY_BATCH = 0x0A
+    INS_SIGN_MESSAGE_BATCH = 0x0B
+    INS_SET_SIGNING_POLICY = 0x0C
+
+
+# Tags of the capability block of GET APP CONFIGURATION, see doc/api.md
+class CAPABILITY(IntEnum):
+    FEATURES = 0x01
+    MAX_MESSAGE_LENGTH = 0x02
+    MAX_APDU_DATA_LENGTH = 0x03
+    MAX_SIGNERS = 0x04
+    MAX_INSTRUCTIONS = 0x05
+    MAX_SUMMARY_ITEMS = 0x06
+    MAX_BATCH_TRANSACTIONS = 0x07
+    KEY_DICTIONARY_SIZE = 0x08
+    MAX_OFFCHAIN_MESSAGE_LENGTH = 0x09
+    KEY_DICTIONARY_DIGEST = 0x0A
+
+
+# Bits of CAPABILITY.FEATURES
+class FEATURE(IntEnum):
+    COMPRESSED_MESSAGES = 0x0001
+    EXTENDED_APDUS = 0x0002
+    OFFSET_CHUNKS = 0x0004
+    PUBKEY_BATCH = 0x0008
+    SIGN_MESSAGE_BATCH = 0x0010
+    SIGNING_POLICY = 0x0020
+    OFFCHAIN_MESSAGE_STREAM = 0x0040
+    TOKEN_DESCRIPTORS = 0x0080
 
 
 CLA = 0xE0
@@ -25,13 +56,20 @@ P1_CONFIRM = 0x01
 P2_NONE = 0x00
 P2_EXTEND = 0x01
 P2_MORE = 0x02
+P2_SECOND_PASS = 0x04
+P2_COMPRESSED = 0x08
+P2_OFFSET = 0x10
 
 PUBLIC_KEY_LENGTH = 32
 
+HARDENED_INDEX = 0x80000000
+
 MAX_CHUNK_SIZE = 255
 
 STATUS_OK = 0x9000
 
+SIGNING_POLICY_VOTE_WITHDRAW = 0x02
+
 
 class ErrorType:
     NO_APP_RESPONSE = 0x6700
@@ -77,6 +115,19 @@ class SolanaClient:
         self._client = client
 
 
+    def get_capabilities(self) -> Dict[int, int]:
+        response: RAPDU = self._client.exchange(CLA, INS.INS_GET_APP_CONFIGURATION,
+                                                P1_NON_CONFIRM, P2_NONE)
+        # Settings and version, then the capability block: version, length and TLVs
+        block = response.data[7:7 + response.data[6]]
+        capabilities: Dict[int, int] = {}
+        while block:
+            tag, length = block[0], block[1]
+            capabilities[tag] = int.from_bytes(block[2:2 + length], byteorder='big')
+            block = block[2 + length:]
+        return capabilities
+
+
     def get_public_key(self, derivation_path: bytes) -> bytes:
         public_key: RAPDU = self._client.exchange(CLA, INS.INS_GET_PUBKEY,
                                                   P1_NON_CONFIRM, P2_NONE,
@@ -85,6 +136,21 @@ class SolanaClient:
         return public_key.data
 
 
+    def get_public_keys_range(self, base_path: bytes, first: int, count: int) -> List[bytes]:
+        keys: List[bytes] = []
+        while len(keys) < count:
+            request = b"\x00" + base_path + (first + len(keys)).to_bytes(4, byteorder='big') \
+                + (count - len(keys)).to_bytes(4, byteorder='big')
+            response: RAPDU = self._client.exchange(CLA, INS.INS_GET_PUBKEY_BATCH,
+                                                    P1_NON_CONFIRM, P2_NONE, request)
+            num_keys = response.data[0]
+            assert num_keys > 0, "no public key returned"
+            assert len(response.data) == 5 + num_keys * PUBLIC_KEY_LENGTH
+            keys += [response.data[5 + i * PUBLIC_KEY_LENGTH:5 + (i + 1) * PUBLIC_KEY_LENGTH]
+                     for i in range(num_keys)]
+        return keys
+
+
     @contextmanager
     def send_public_key_with_confirm(self, derivation_path: bytes) -> bytes:
         with self._client.exchange_async(CLA, INS.INS_GET_PUBKEY,
@@ -132,6 +198,48 @@ class SolanaClient:
             yield
 
 
+    def serialize_offset_transfer(self, derivation_path: bytes, message: bytes) -> bytes:
+        # What the chunks of a transfer sent with P2_OFFSET carry once put together
+        return _extend_and_serialize_multiple_derivations_paths([derivation_path]) + message
+
+
+    def send_message_offset_chunk(self,
+                                  transfer_id: int,
+                                  transfer: bytes,
+                                  offset: int,
+                                  length: int) -> RAPDU:
+        p2 = P2_OFFSET | (P2_MORE if offset + length < len(transfer) else 0)
+        return self._client.exchange(CLA, INS.INS_SIGN_MESSAGE, P1_CONFIRM, p2,
+                                     bytes([transfer_id]) + offset.to_bytes(2, 'big')
+                                     + transfer[offset:offset + length])
+
+
+    @contextmanager
+    def send_async_sign_message_with_offsets(self,
+                                             transfer_id: int,
+                                             derivation_path: bytes,
+                                             message: bytes,
+                                             max_chunk_size: int = MAX_CHUNK_SIZE) -> Generator[None, None, None]:
+        transfer = self.serialize_offset_transfer(derivation_path, message)
+        max_size = max_chunk_size - 3
+        committed = 0
+        # Each chunk is acknowledged with the committed length, resume from it
+        while len(transfer) - committed > max_size:
+            response = self.send_message_offset_chunk(transfer_id, transfer, committed, max_size)
+            committed = int.from_bytes(response.data, byteorder='big')
+        with self._client.exchange_async(CLA, INS.INS_SIGN_MESSAGE, P1_CONFIRM, P2_OFFSET,
+                                         bytes([transfer_id]) + committed.to_bytes(2, 'big')
+                                         + transfer[committed:]):
+            yield
+
+
+    def sign_message_unattended(self, derivation_path: bytes, message: bytes) -> RAPDU:
+        # Signed without review only under the installed signing policy
+        chunks = self.split_and_prefix_message(derivation_path, message)
+        assert len(chunks) == 1, "Message to send is too long"
+        return self._client.exchange(CLA, INS.INS_SIGN_MESSAGE, P1_NON_CONFIRM, P2_NONE, chunks[0])
+
+
     @contextmanager
     def send_async_sign_message(self,
                                 derivation_path : bytes,
@@ -148,5 +256,115 @@ class SolanaClient:
             yield
 
 
+    def send_offchain_message_stream_first_pass(self,
+                                                derivation_path : bytes,
+                                                message: bytes) -> RAPDU:
+        signer: bytes = _extend_and_serialize_multiple_derivations_paths([derivation_path])
+        first_pass = [signer + message[:MAX_CHUNK_SIZE - len(signer)]]
+        rest = message[MAX_CHUNK_SIZE - len(signer):]
+        first_pass += [rest[x:x + MAX_CHUNK_SIZE] for x in range(0, len(rest), MAX_CHUNK_SIZE)]
+
+        ins = INS.INS_SIGN_OFFCHAIN_MESSAGE_STREAM
+        for i, chunk in enumerate(first_pass):
+            p2 = (P2_EXTEND if i > 0 else 0) | (P2_MORE if i < len(first_pass) - 1 else 0)
+            rapdu = self._client.exchange(CLA, ins, P1_CONFIRM, p2, chunk)
+        return rapdu
+
+
+    def split_offchain_message_stream_second_pass(self, message: bytes) -> List[Tuple[int, bytes]]:
+        chunks = [message[x:x + MAX_CHUNK_SIZE] for x in range(0, len(message), MAX_CHUNK_SIZE)]
+        return [(P2_SECOND_PASS | (P2_EXTEND if i > 0 else 0)
+                 | (P2_MORE if i < len(chunks) - 1 else 0), chunk)
+                for i, chunk in enumerate(chunks)]
+
+
+    def send_offchain_message_stream_second_pass(self, message: bytes) -> RAPDU:
+        # Only returns when the second pass is refused before the review
+        for p2, chunk in self.split_offchain_message_stream_second_pass(message):
+            rapdu = self._client.exchange(CLA, INS.INS_SIGN_OFFCHAIN_MESSAGE_STREAM,
+                                          P1_CONFIRM, p2, chunk)
+        return rapdu
+
+
+    @contextmanager
+    def send_async_sign_offchain_message_stream(self,
+                                                derivation_path : bytes,
+                                                message: bytes) -> Generator[None, None, None]:
+        self.send_offchain_message_stream_first_pass(derivation_path, message)
+
+        ins = INS.INS_SIGN_OFFCHAIN_MESSAGE_STREAM
+        second_pass = self.split_offchain_message_stream_second_pass(message)
+        for p2, chunk in second_pass[:-1]:
+            self._client.exchange(CLA, ins, P1_CONFIRM, p2, chunk)
+        final_p2, final_chunk = second_pass[-1]
+        with self._client.exchange_async(CLA, ins, P1_CONFIRM, final_p2, final_chunk):
+            yield
+
+
+    def split_message_batch_transaction(self,
+                                        derivation_path: bytes,
+                                        message: bytes) -> List[bytes]:
+        # Only the first chunk carries the signer
+        signer: bytes = _extend_and_serialize_multiple_derivations_paths([derivation_path])
+        chunks = [signer + message[:MAX_CHUNK_SIZE - len(signer)]]
+        rest = message[MAX_CHUNK_SIZE - len(signer):]
+        return chunks + [rest[x:x + MAX_CHUNK_SIZE] for x in range(0, len(rest), MAX_CHUNK_SIZE)]
+
+
+    def send_message_batch_transaction(self, p1: int, p2: int, chunks: List[bytes]) -> RAPDU:
+        ins = INS.INS_SIGN_MESSAGE_BATCH
+        for i, chunk in enumerate(chunks[:-1]):
+            self._client.exchange(CLA, ins, p1, p2 | P2_MORE | (P2_EXTEND if i > 0 else 0), chunk)
+        final_p2 = p2 | (P2_EXTEND if len(chunks) > 1 else 0)
+        return self._client.exchange(CLA, ins, p1, final_p2, chunks[-1])
+
+
+    @contextmanager
+    def send_async_sign_message_batch(self,
+                                      derivation_path: bytes,
+                                      messages: List[bytes]) -> Generator[None, None, None]:
+        for message in messages[:-1]:
+            chunks = self.split_message_batch_transaction(derivation_path, message)
+            self.send_message_batch_transaction(P1_NON_CONFIRM, P2_NONE, chunks)
+
+        # The last transaction opens the review
+        chunks = self.split_message_batch_transaction(derivation_path, messages[-1])
+        ins = INS.INS_SIGN_MESSAGE_BATCH
+        for i, chunk in enumerate(chunks[:-1]):
+            self._client.exchange(CLA, ins, P1_CONFIRM, P2_MORE | (P2_EXTEND if i > 0 else 0), chunk)
+        final_p2 = P2_EXTEND if len(chunks) > 1 else 0
+        with self._client.exchange_async(CLA, ins, P1_CONFIRM, final_p2, chunks[-1]):
+            yield
+
+
+    def sign_message_batch(self, derivation_path: bytes, messages: List[bytes]) -> List[bytes]:
+        signatures = []
+        for message in messages:
+            chunks = self.split_message_batch_transaction(derivation_path, message)
+            signatures.append(self.send_message_batch_transaction(P1_CONFIRM,
+                                                                  P2_SECOND_PASS,
+                                                                  chunks).data)
+        return signatures
+
+
+    @contextmanager
+    def send_async_set_signing_policy(self,
+                                      pattern: int,
+                                      derivation_path: bytes,
+                                      account: bytes,
+                                      destination: bytes,
+                                      max_amount: int) -> Generator[None, None, None]:
+        request = bytes([pattern]) + derivation_path + account + destination \
+            + max_amount.to_bytes(8, byteorder='big')
+        with self._client.exchange_async(CLA, INS.INS_SET_SIGNING_POLICY,
+                                         P1_CONFIRM, P2_NONE, request):
+            yield
+
+
+    def clear_signing_policy(self) -> RAPDU:
+        return self._client.exchange(CLA, INS.INS_SET_SIGNING_POLICY,
+                                     P1_NON_CONFIRM, P2_NONE, b"\x00")
+
+
     def get_async_response(self) -> RAPDU:
         return self._client.last_async_response
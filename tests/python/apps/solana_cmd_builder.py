@@ -5,6 +5,7 @@ from nacl.signing import VerifyKey
 
 
 PROGRAM_ID_SYSTEM = "11111111111111111111111111111111"
+PROGRAM_ID_VOTE = "Vote111111111111111111111111111111111111111"
 
 # Fake blockhash so this example doesn't need a network connection. It should be queried from the cluster in normal use.
 FAKE_RECENT_BLOCKHASH = "11111111111111111111111111111111"
@@ -116,6 +117,19 @@ class Message:
         serialized += self.compiled_instructions[0].serialize()
         return serialized
 
+# Vote Withdraw of lamports from vote_account to destination, authority signing and paying the fees
+def vote_withdraw_message(authority: bytes, vote_account: bytes, destination: bytes, lamports: int) -> bytes:
+    serialized: bytes = MessageHeader(1, 0, 1).serialize()
+    account_keys = [authority, vote_account, destination, base58.b58decode(PROGRAM_ID_VOTE)]
+    serialized += len(account_keys).to_bytes(1, byteorder='little')
+    for account_key in account_keys:
+        serialized += account_key
+    serialized += base58.b58decode(FAKE_RECENT_BLOCKHASH)
+    data = (3).to_bytes(4, byteorder='little') + lamports.to_bytes(8, byteorder='little')
+    serialized += (1).to_bytes(1, byteorder='little')
+    serialized += CompiledInstruction(3, [1, 2, 0], data).serialize()
+    return serialized
+
 def is_printable_ascii(string: str) -> bool:
     try:
         string.decode('ascii')
@@ -59,7 +59,7 @@ SOL_PACKED_DERIVATION_PATH_2    = pack_derivation_path("m/44'/501'/0'/0'")
 SOL_CONF = create_currency_config("SOL", "Solana")
 
 
-def enable_blind_signing(navigator, firmware, snapshots_name: str):
+def enable_blind_signing(navigator, firmware, snapshots_name: str, do_comparison: bool = True):
     if firmware.is_nano:
         nav = [NavInsID.RIGHT_CLICK, NavInsID.BOTH_CLICK, # Go to settings
                NavInsID.BOTH_CLICK, # Select blind signing
@@ -70,6 +70,9 @@ def enable_blind_signing(navigator, firmware, snapshots_name: str):
         nav = [NavInsID.USE_CASE_HOME_SETTINGS,
                NavIns(NavInsID.TOUCH, (348,132)),
                NavInsID.USE_CASE_SETTINGS_MULTI_PAGE_EXIT]
+    if not do_comparison:
+        navigator.navigate(nav, screen_change_before_first_instruction=False)
+        return
     navigator.navigate_and_compare(ROOT_SCREENSHOT_PATH,
                                    snapshots_name,
                                    nav,
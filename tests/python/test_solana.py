@@ -1,12 +1,36 @@
 from ragger.backend import RaisePolicy
 from ragger.utils import RAPDU
+from ragger.bip import pack_derivation_path
 
-from .apps.solana import SolanaClient, ErrorType
-from .apps.solana_cmd_builder import SystemInstructionTransfer, Message, verify_signature, OffchainMessage
+from .apps.solana import SolanaClient, ErrorType, STATUS_OK, HARDENED_INDEX, P1_CONFIRM, P2_SECOND_PASS, SIGNING_POLICY_VOTE_WITHDRAW
+from .apps.solana import CAPABILITY, FEATURE, MAX_CHUNK_SIZE
+from .apps.solana_cmd_builder import SystemInstructionTransfer, Message, verify_signature, OffchainMessage, vote_withdraw_message
 from .apps.solana_utils import FOREIGN_PUBLIC_KEY, FOREIGN_PUBLIC_KEY_2, AMOUNT, AMOUNT_2, SOL_PACKED_DERIVATION_PATH, SOL_PACKED_DERIVATION_PATH_2, ROOT_SCREENSHOT_PATH
 from .apps.solana_utils import enable_blind_signing, enable_expert_mode
 
 
+class TestGetAppConfiguration:
+
+    def test_solana_get_capabilities(self, backend):
+        sol = SolanaClient(backend)
+        capabilities = sol.get_capabilities()
+
+        features = capabilities[CAPABILITY.FEATURES]
+        for feature in (FEATURE.COMPRESSED_MESSAGES, FEATURE.OFFSET_CHUNKS, FEATURE.PUBKEY_BATCH,
+                        FEATURE.SIGN_MESSAGE_BATCH, FEATURE.SIGNING_POLICY,
+                        FEATURE.OFFCHAIN_MESSAGE_STREAM):
+            assert features & feature
+
+        assert capabilities[CAPABILITY.MAX_APDU_DATA_LENGTH] >= MAX_CHUNK_SIZE
+        assert capabilities[CAPABILITY.MAX_MESSAGE_LENGTH] > capabilities[CAPABILITY.MAX_APDU_DATA_LENGTH]
+        assert capabilities[CAPABILITY.MAX_OFFCHAIN_MESSAGE_LENGTH] < capabilities[CAPABILITY.MAX_MESSAGE_LENGTH]
+        assert capabilities[CAPABILITY.MAX_SIGNERS] >= 2
+        assert capabilities[CAPABILITY.MAX_BATCH_TRANSACTIONS] >= 2
+        # Well-known keys then the registry mints
+        assert capabilities[CAPABILITY.KEY_DICTIONARY_SIZE] > 20
+        assert CAPABILITY.KEY_DICTIONARY_DIGEST in capabilities
+
+
 class TestGetPublicKey:
 
     def test_solana_get_public_key_ok(self, backend, scenario_navigator):
@@ -28,6 +52,22 @@ class TestGetPublicKey:
         assert sol.get_async_response().status == ErrorType.USER_CANCEL
 
 
+class TestGetPublicKeyBatch:
+
+    def test_solana_get_public_keys_range_ok(self, backend):
+        sol = SolanaClient(backend)
+        # m/44'/501'/11105' to m/44'/501'/11112', more than one response holds
+        first_child = HARDENED_INDEX | 11105
+        keys = sol.get_public_keys_range(pack_derivation_path("m/44'/501'"), first_child, 8)
+
+        assert len(keys) == 8
+        assert keys[6] == FOREIGN_PUBLIC_KEY
+        assert keys[7] == FOREIGN_PUBLIC_KEY_2
+        for i, key in enumerate(keys):
+            path = pack_derivation_path(f"m/44'/501'/{11105 + i}'")
+            assert key == sol.get_public_key(path)
+
+
 class TestMessageSigning:
 
     def test_solana_simple_transfer_ok_1(self, backend, scenario_navigator):
@@ -75,6 +115,123 @@ class TestMessageSigning:
         assert rapdu.status == ErrorType.USER_CANCEL
 
 
+    def test_solana_simple_transfer_with_offsets_ok(self, backend, scenario_navigator):
+        sol = SolanaClient(backend)
+        from_public_key = sol.get_public_key(SOL_PACKED_DERIVATION_PATH)
+
+        instruction: SystemInstructionTransfer = SystemInstructionTransfer(from_public_key, FOREIGN_PUBLIC_KEY, AMOUNT)
+        message: bytes = Message([instruction]).serialize()
+        transfer: bytes = sol.serialize_offset_transfer(SOL_PACKED_DERIVATION_PATH, message)
+
+        # A stale chunk of another transfer changes nothing
+        rapdu: RAPDU = sol.send_message_offset_chunk(0x41, transfer, 61, 61)
+        assert rapdu.status == STATUS_OK
+        assert rapdu.data == b""
+
+        # Several chunks, each one acknowledged with the committed length
+        # No golden snapshots yet for this test, screens are not compared
+        with sol.send_async_sign_message_with_offsets(0x42, SOL_PACKED_DERIVATION_PATH, message, max_chunk_size=64):
+            scenario_navigator.review_approve(path=ROOT_SCREENSHOT_PATH, do_comparison=False)
+
+        signature: bytes = sol.get_async_response().data
+        verify_signature(from_public_key, message, signature)
+
+        # The last chunk again, as if its response was lost, is ignored
+        last_offset = (len(transfer) - 1) // 61 * 61
+        rapdu = sol.send_message_offset_chunk(0x42, transfer, last_offset, len(transfer) - last_offset)
+        assert rapdu.status == STATUS_OK
+        assert rapdu.data == b""
+
+
+# No golden snapshots yet for batch reviews, screens are not compared
+class TestMessageBatchSigning:
+
+    def test_solana_batch_transfers_ok(self, backend, scenario_navigator):
+        sol = SolanaClient(backend)
+        from_public_key = sol.get_public_key(SOL_PACKED_DERIVATION_PATH)
+
+        messages = [Message([SystemInstructionTransfer(from_public_key, FOREIGN_PUBLIC_KEY, AMOUNT)]).serialize(),
+                    Message([SystemInstructionTransfer(from_public_key, FOREIGN_PUBLIC_KEY_2, AMOUNT_2)]).serialize()]
+
+        with sol.send_async_sign_message_batch(SOL_PACKED_DERIVATION_PATH, messages):
+            scenario_navigator.review_approve(path=ROOT_SCREENSHOT_PATH, do_comparison=False)
+        assert sol.get_async_response().status == STATUS_OK
+
+        signatures = sol.sign_message_batch(SOL_PACKED_DERIVATION_PATH, messages)
+        assert len(signatures) == len(messages)
+        for message, signature in zip(messages, signatures):
+            verify_signature(from_public_key, message, signature)
+
+
+    def test_solana_batch_transfers_refused(self, backend, scenario_navigator):
+        sol = SolanaClient(backend)
+        from_public_key = sol.get_public_key(SOL_PACKED_DERIVATION_PATH)
+
+        messages = [Message([SystemInstructionTransfer(from_public_key, FOREIGN_PUBLIC_KEY, AMOUNT)]).serialize(),
+                    Message([SystemInstructionTransfer(from_public_key, FOREIGN_PUBLIC_KEY_2, AMOUNT_2)]).serialize()]
+
+        backend.raise_policy = RaisePolicy.RAISE_NOTHING
+        with sol.send_async_sign_message_batch(SOL_PACKED_DERIVATION_PATH, messages):
+            scenario_navigator.review_reject(path=ROOT_SCREENSHOT_PATH, do_comparison=False)
+        assert sol.get_async_response().status == ErrorType.USER_CANCEL
+
+        # Nothing was approved, nothing is signed
+        chunks = sol.split_message_batch_transaction(SOL_PACKED_DERIVATION_PATH, messages[0])
+        rapdu: RAPDU = sol.send_message_batch_transaction(P1_CONFIRM, P2_SECOND_PASS, chunks)
+        assert rapdu.status == ErrorType.SDK_INVALID_STATE
+
+
+# No golden snapshots yet for policy reviews, screens are not compared
+class TestSigningPolicy:
+
+    VOTE_ACCOUNT = bytes([0x11] * 32)
+    MAX_AMOUNT = 1_000_000
+
+    def test_solana_signing_policy_vote_withdraw(self, backend, scenario_navigator):
+        sol = SolanaClient(backend)
+        authority = sol.get_public_key(SOL_PACKED_DERIVATION_PATH)
+        backend.raise_policy = RaisePolicy.RAISE_NOTHING
+
+        with sol.send_async_set_signing_policy(SIGNING_POLICY_VOTE_WITHDRAW,
+                                               SOL_PACKED_DERIVATION_PATH,
+                                               self.VOTE_ACCOUNT,
+                                               FOREIGN_PUBLIC_KEY,
+                                               self.MAX_AMOUNT):
+            scenario_navigator.review_approve(path=ROOT_SCREENSHOT_PATH, do_comparison=False)
+        assert sol.get_async_response().status == STATUS_OK
+
+        # The maximum applies to each transaction, not to their sum
+        message = vote_withdraw_message(authority, self.VOTE_ACCOUNT, FOREIGN_PUBLIC_KEY, self.MAX_AMOUNT)
+        for _ in range(2):
+            rapdu: RAPDU = sol.sign_message_unattended(SOL_PACKED_DERIVATION_PATH, message)
+            assert rapdu.status == STATUS_OK
+            verify_signature(authority, message, rapdu.data)
+
+        over = vote_withdraw_message(authority, self.VOTE_ACCOUNT, FOREIGN_PUBLIC_KEY, self.MAX_AMOUNT + 1)
+        assert sol.sign_message_unattended(SOL_PACKED_DERIVATION_PATH, over).status == ErrorType.SDK_NOT_SUPPORTED
+
+        # Once cleared, nothing is signed without review
+        assert sol.clear_signing_policy().status == STATUS_OK
+        assert sol.sign_message_unattended(SOL_PACKED_DERIVATION_PATH, message).status == ErrorType.SDK_NOT_SUPPORTED
+
+
+    def test_solana_signing_policy_refused(self, backend, scenario_navigator):
+        sol = SolanaClient(backend)
+        authority = sol.get_public_key(SOL_PACKED_DERIVATION_PATH)
+        backend.raise_policy = RaisePolicy.RAISE_NOTHING
+
+        with sol.send_async_set_signing_policy(SIGNING_POLICY_VOTE_WITHDRAW,
+                                               SOL_PACKED_DERIVATION_PATH,
+                                               self.VOTE_ACCOUNT,
+                                               FOREIGN_PUBLIC_KEY,
+                                               self.MAX_AMOUNT):
+            scenario_navigator.review_reject(path=ROOT_SCREENSHOT_PATH, do_comparison=False)
+        assert sol.get_async_response().status == ErrorType.USER_CANCEL
+
+        message = vote_withdraw_message(authority, self.VOTE_ACCOUNT, FOREIGN_PUBLIC_KEY, 1)
+        assert sol.sign_message_unattended(SOL_PACKED_DERIVATION_PATH, message).status == ErrorType.SDK_NOT_SUPPORTED
+
+
 class TestOffchainMessageSigning:
 
     def test_ledger_sign_offchain_message_ascii_ok(self, backend, scenario_navigator):
@@ -202,3 +359,42 @@ class TestOffchainMessageSigning:
         rapdu: RAPDU = sol.get_async_response()
         assert rapdu.status == ErrorType.USER_CANCEL
 
+
+
+    # No golden snapshots yet for the streamed review, screens are not compared
+    def test_ledger_sign_offchain_message_stream_ok(self, backend, scenario_navigator, navigator, test_name):
+        enable_blind_signing(navigator, backend.firmware, test_name + "_1", do_comparison=False)
+
+        sol = SolanaClient(backend)
+        from_public_key = sol.get_public_key(SOL_PACKED_DERIVATION_PATH)
+
+        # Spans several chunks on both passes
+        offchain_message: OffchainMessage = OffchainMessage(0, b"Streamed message " * 40)
+        message: bytes = offchain_message.serialize()
+
+        with sol.send_async_sign_offchain_message_stream(SOL_PACKED_DERIVATION_PATH, message):
+            scenario_navigator.review_approve(path=ROOT_SCREENSHOT_PATH, do_comparison=False)
+
+        streamed_signature: bytes = sol.get_async_response().data
+        verify_signature(from_public_key, message, streamed_signature)
+
+        # Ed25519 is deterministic, the one-shot command must sign the same bytes identically
+        with sol.send_async_sign_offchain_message(SOL_PACKED_DERIVATION_PATH, message):
+            scenario_navigator.review_approve(path=ROOT_SCREENSHOT_PATH, do_comparison=False)
+
+        assert sol.get_async_response().data == streamed_signature
+
+
+    def test_ledger_sign_offchain_message_stream_mismatch(self, backend, navigator, test_name):
+        enable_blind_signing(navigator, backend.firmware, test_name + "_1", do_comparison=False)
+
+        sol = SolanaClient(backend)
+        message: bytes = OffchainMessage(0, b"Streamed message " * 40).serialize()
+        other: bytes = OffchainMessage(0, b"Streamed massage " * 40).serialize()
+
+        # The second pass over other bytes is refused before any review
+        backend.raise_policy = RaisePolicy.RAISE_NOTHING
+        assert sol.send_offchain_message_stream_first_pass(SOL_PACKED_DERIVATION_PATH,
+                                                           message).status == STATUS_OK
+        rapdu: RAPDU = sol.send_offchain_message_stream_second_pass(other)
+        assert rapdu.status == ErrorType.SOLANA_INVALID_MESSAGE
@@ -0,0 +1,84 @@
+#include "apdu.h"
+#include "bench.h"
+#include "utils.h"
+#include <stdio.h>
+
+ApduCommand G_command;
+
+#define ITERATIONS    20000
+#define CHUNK_DATA    255
+#define MAX_CHUNKS    8
+#define PATH_LENGTH   17
+
+static uint8_t apdus[MAX_CHUNKS][OFFSET_CDATA + CHUNK_DATA];
+static size_t apdu_lengths[MAX_CHUNKS];
+static size_t chunk_count;
+static size_t message_length;
+
+// One largest sign request, split into 255-byte APDUs
+static void prepare_chunks(void) {
+    static const uint8_t path[PATH_LENGTH] =
+        {4, 0x80, 0, 0, 44, 0x80, 0, 0x01, 0xf5, 0x80, 0, 0, 0, 0x80, 0, 0, 0};
+    const size_t total = MAX_MESSAGE_LENGTH - MAX_DERIVATION_PATH_BUFFER_LENGTH - 1;
+    size_t sent = 0;
+    for (chunk_count = 0; sent < total; chunk_count++) {
+        uint8_t *apdu = apdus[chunk_count];
+        uint8_t *data = apdu + OFFSET_CDATA;
+        size_t prefix = 0;
+        if (chunk_count == 0) {
+            data[0] = 1;
+            memcpy(data + 1, path, sizeof(path));
+            prefix = 1 + sizeof(path);
+        }
+        const size_t take = total - sent < CHUNK_DATA - prefix ? total - sent : CHUNK_DATA - prefix;
+        for (size_t i = 0; i < take; i++) {
+            data[prefix + i] = (uint8_t) (sent + i);
+        }
+        sent += take;
+        apdu[OFFSET_CLA] = CLA;
+        apdu[OFFSET_INS] = InsSignMessage;
+        apdu[OFFSET_P1] = P1_CONFIRM;
+        apdu[OFFSET_P2] = (chunk_count ? P2_EXTEND : 0) | (sent < total ? P2_MORE : 0);
+        apdu[OFFSET_LC] = prefix + take;
+        apdu_lengths[chunk_count] = OFFSET_CDATA + prefix + take;
+    }
+    message_length = total;
+}
+
+int main() {
+    prepare_chunks();
+
+    uint64_t chunk_ns = 0;
+    uint64_t last_chunk_ns = 0;
+    uint64_t full_hash_ns = 0;
+    for (size_t iteration = 0; iteration < ITERATIONS; iteration++) {
+        for (size_t i = 0; i < chunk_count; i++) {
+            const uint64_t start = bench_now_ns();
+            if (apdu_handle_message(apdus[i], apdu_lengths[i], &G_command) != 0) {
+                return 1;
+            }
+            const uint64_t elapsed = bench_now_ns() - start;
+            chunk_ns += elapsed;
+            if (i + 1 == chunk_count) {
+                last_chunk_ns += elapsed;
+            }
+        }
+
+        // What the handlers used to do once the payload was complete
+        const uint64_t start = bench_now_ns();
+        cx_hash_sha256(G_command.message,
+                       G_command.message_length,
+                       G_command.message_hash.data,
+                       HASH_LENGTH);
+        full_hash_ns += bench_now_ns() - start;
+        bench_do_not_optimize(&G_command.message_hash);
+    }
+
+    printf("%zu byte message in %zu APDUs\n", message_length, chunk_count);
+    printf("%-32s %9.1f us\n", "all chunks, hashing included", chunk_ns / 1000.0 / ITERATIONS);
+    printf("%-32s %9.1f us\n", "last chunk to hash ready", last_chunk_ns / 1000.0 / ITERATIONS);
+    printf("%-32s %9.1f us\n",
+           "full pass after last chunk",
+           full_hash_ns / 1000.0 / ITERATIONS);
+    return 0;
+}
@@ -0,0 +1,663 @@
+#include "apdu.h"
+#include "utils.h"
+#include "common_byte_strings.h"
+#include <assert.h>
+#include <stdio.h>
+
+ApduCommand G_command;
+
+#define MAX_APDU_DATA 255
+
+static const uint8_t DERIVATION_PATH[] =
+    {4, 0x80, 0, 0, 44, 0x80, 0, 0x01, 0xf5, 0x80, 0, 0, 0, 0x80, 0, 0, 0};
+
+// Serialize one modern APDU into apdu, returns its length
+static size_t make_apdu(uint8_t *apdu,
+                        uint8_t instruction,
+                        uint8_t p1,
+                        uint8_t p2,
+                        const uint8_t *data,
+                        size_t data_length) {
+    assert(data_length <= MAX_APDU_DATA);
+    apdu[OFFSET_CLA] = CLA;
+    apdu[OFFSET_INS] = instruction;
+    apdu[OFFSET_P1] = p1;
+    apdu[OFFSET_P2] = p2;
+    apdu[OFFSET_LC] = data_length;
+    memcpy(apdu + OFFSET_CDATA, data, data_length);
+    return OFFSET_CDATA + data_length;
+}
+
+// Send message as a sign request, split into APDUs of at most chunk_size
+// data bytes, the first one also carrying the signer count and path.
+// p2_flags are added to the chunking flags of every APDU
+static int send_message_with_p2(uint8_t instruction,
+                                uint8_t p2_flags,
+                                const uint8_t *message,
+                                size_t message_length,
+                                size_t chunk_size,
+                                ApduCommand *command) {
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA];
+    uint8_t data[MAX_APDU_DATA];
+
+    data[0] = 1;
+    memcpy(data + 1, DERIVATION_PATH, sizeof(DERIVATION_PATH));
+    size_t prefix = 1 + sizeof(DERIVATION_PATH);
+    size_t sent = 0;
+    bool first = true;
+    do {
+        const size_t remaining = message_length - sent;
+        const size_t take = remaining < chunk_size - prefix ? remaining : chunk_size - prefix;
+        memcpy(data + prefix, message + sent, take);
+        sent += take;
+        const uint8_t p2 =
+            p2_flags | (first ? 0 : P2_EXTEND) | (sent < message_length ? P2_MORE : 0);
+        const size_t apdu_length =
+            make_apdu(apdu, instruction, P1_CONFIRM, p2, data, prefix + take);
+        const int ret = apdu_handle_message(apdu, apdu_length, command);
+        if (ret != 0) {
+            return ret;
+        }
+        prefix = 0;
+        first = false;
+    } while (sent < message_length);
+    return 0;
+}
+
+static int send_message(uint8_t instruction,
+                        const uint8_t *message,
+                        size_t message_length,
+                        size_t chunk_size,
+                        ApduCommand *command) {
+    return send_message_with_p2(instruction, 0, message, message_length, chunk_size, command);
+}
+
+static void fill_message(uint8_t *message, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        message[i] = (uint8_t) (i * 31 + 7);
+    }
+}
+
+void test_host_sha256() {
+    const uint8_t abc[] = "abc";
+    const uint8_t expected[] = {0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40,
+                                0xde, 0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17,
+                                0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+    uint8_t digest[CX_SHA256_SIZE];
+    cx_hash_sha256(abc, 3, digest, sizeof(digest));
+    assert(memcmp(digest, expected, sizeof(expected)) == 0);
+}
+
+void test_sign_message_hash_every_chunking() {
+    static uint8_t message[MAX_MESSAGE_LENGTH - MAX_DERIVATION_PATH_BUFFER_LENGTH - 1];
+    fill_message(message, sizeof(message));
+
+    const size_t lengths[] = {1, 63, 64, 65, 200, 1000, sizeof(message)};
+    const size_t chunk_sizes[] = {30, 64, 128, MAX_APDU_DATA};
+    for (size_t i = 0; i < ARRAY_COUNT(lengths); i++) {
+        Hash expected;
+        cx_hash_sha256(message, lengths[i], expected.data, HASH_LENGTH);
+
+        for (size_t j = 0; j < ARRAY_COUNT(chunk_sizes); j++) {
+            ApduCommand command;
+            assert(send_message(InsSignMessage, message, lengths[i], chunk_sizes[j], &command) ==
+                   0);
+            assert(command.state == ApduStatePayloadComplete);
+            assert(command.message_length == (int) lengths[i]);
+            assert(memcmp(command.message, message, lengths[i]) == 0);
+            assert(memcmp(&command.message_hash, &expected, HASH_LENGTH) == 0);
+        }
+    }
+}
+
+void test_sign_offchain_message_hash() {
+    uint8_t message[300];
+    fill_message(message, sizeof(message));
+    Hash expected;
+    cx_hash_sha256(message, sizeof(message), expected.data, HASH_LENGTH);
+
+    ApduCommand command;
+    assert(send_message(InsSignOffchainMessage, message, sizeof(message), 100, &command) == 0);
+    assert(command.state == ApduStatePayloadComplete);
+    assert(memcmp(&command.message_hash, &expected, HASH_LENGTH) == 0);
+}
+
+void test_hash_pending_until_last_chunk() {
+    uint8_t message[400];
+    fill_message(message, sizeof(message));
+    const Hash zero = {{0}};
+
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA];
+    uint8_t data[MAX_APDU_DATA];
+    data[0] = 1;
+    memcpy(data + 1, DERIVATION_PATH, sizeof(DERIVATION_PATH));
+    memcpy(data + 1 + sizeof(DERIVATION_PATH), message, 200);
+
+    ApduCommand command;
+    size_t length = make_apdu(apdu,
+                              InsSignMessage,
+                              P1_CONFIRM,
+                              P2_MORE,
+                              data,
+                              1 + sizeof(DERIVATION_PATH) + 200);
+    assert(apdu_handle_message(apdu, length, &command) == 0);
+    assert(command.state == ApduStatePayloadInProgress);
+    assert(memcmp(&command.message_hash, &zero, HASH_LENGTH) == 0);
+
+    length = make_apdu(apdu, InsSignMessage, P1_CONFIRM, P2_EXTEND, message + 200, 200);
+    assert(apdu_handle_message(apdu, length, &command) == 0);
+    assert(command.state == ApduStatePayloadComplete);
+
+    Hash expected;
+    cx_hash_sha256(message, sizeof(message), expected.data, HASH_LENGTH);
+    assert(memcmp(&command.message_hash, &expected, HASH_LENGTH) == 0);
+}
+
+void test_restart_resets_hash() {
+    uint8_t message[100];
+    fill_message(message, sizeof(message));
+
+    // An abandoned multi-chunk message must not leak into the next one
+    ApduCommand command;
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA];
+    uint8_t data[MAX_APDU_DATA];
+    data[0] = 1;
+    memcpy(data + 1, DERIVATION_PATH, sizeof(DERIVATION_PATH));
+    memcpy(data + 1 + sizeof(DERIVATION_PATH), message, 50);
+    const size_t length = make_apdu(apdu,
+                                    InsSignMessage,
+                                    P1_CONFIRM,
+                                    P2_MORE,
+                                    data,
+                                    1 + sizeof(DERIVATION_PATH) + 50);
+    assert(apdu_handle_message(apdu, length, &command) == 0);
+
+    assert(send_message(InsSignMessage, message, sizeof(message), MAX_APDU_DATA, &command) == 0);
+    Hash expected;
+    cx_hash_sha256(message, sizeof(message), expected.data, HASH_LENGTH);
+    assert(memcmp(&command.message_hash, &expected, HASH_LENGTH) == 0);
+}
+
+void test_deprecated_sign_message_hash() {
+    uint8_t message[50];
+    fill_message(message, sizeof(message));
+
+    // CLA INS P1 P2 Lc(u16) | path | length(u16) | message
+    uint8_t apdu[DEPRECATED_OFFSET_CDATA + sizeof(DERIVATION_PATH) + 2 + sizeof(message)];
+    const size_t data_length = sizeof(apdu) - DEPRECATED_OFFSET_CDATA;
+    apdu[OFFSET_CLA] = CLA;
+    apdu[OFFSET_INS] = InsDeprecatedSignMessage;
+    apdu[OFFSET_P1] = P1_CONFIRM;
+    apdu[OFFSET_P2] = 0;
+    apdu[OFFSET_LC] = data_length >> 8;
+    apdu[OFFSET_LC + 1] = data_length & 0xff;
+    uint8_t *data = apdu + DEPRECATED_OFFSET_CDATA;
+    memcpy(data, DERIVATION_PATH, sizeof(DERIVATION_PATH));
+    data += sizeof(DERIVATION_PATH);
+    data[0] = 0;
+    data[1] = sizeof(message);
+    memcpy(data + 2, message, sizeof(message));
+
+    ApduCommand command;
+    assert(apdu_handle_message(apdu, sizeof(apdu), &command) == 0);
+    assert(command.state == ApduStatePayloadComplete);
+
+    Hash expected;
+    cx_hash_sha256(message, sizeof(message), expected.data, HASH_LENGTH);
+    assert(memcmp(&command.message_hash, &expected, HASH_LENGTH) == 0);
+}
+
+void test_get_pubkey() {
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA];
+    const size_t length =
+        make_apdu(apdu, InsGetPubkey, P1_NON_CONFIRM, 0, DERIVATION_PATH, sizeof(DERIVATION_PATH));
+
+    ApduCommand command;
+    assert(apdu_handle_message(apdu, length, &command) == 0);
+    assert(command.state == ApduStatePayloadComplete);
+    assert(command.non_confirm);
+    assert(command.derivation_path_lengths[0] == 4);
+    assert(command.derivation_paths[0][1] == 0x800001f5);
+}
+
+void test_invalid_continuation() {
+    uint8_t message[10] = {0};
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA];
+
+    // P2_EXTEND without a message in progress
+    ApduCommand command = {0};
+    const size_t length =
+        make_apdu(apdu, InsSignMessage, P1_CONFIRM, P2_EXTEND, message, sizeof(message));
+    assert(apdu_handle_message(apdu, length, &command) == ApduReplySolanaInvalidMessage);
+}
+
+// Serialize a first chunk carrying num_paths signers then message
+static size_t make_signers_apdu(uint8_t *apdu,
+                                uint8_t instruction,
+                                uint8_t num_paths,
+                                const uint8_t *message,
+                                size_t message_length) {
+    static const uint8_t SECOND_DERIVATION_PATH[] =
+        {3, 0x80, 0, 0, 44, 0x80, 0, 0x01, 0xf5, 0x80, 0, 0, 1};
+    uint8_t data[MAX_APDU_DATA];
+    size_t length = 0;
+    data[length++] = num_paths;
+    for (uint8_t i = 0; i < num_paths; i++) {
+        const uint8_t *path = i % 2 ? SECOND_DERIVATION_PATH : DERIVATION_PATH;
+        const size_t path_length = 1 + 4 * path[0];
+        memcpy(data + length, path, path_length);
+        length += path_length;
+    }
+    memcpy(data + length, message, message_length);
+    length += message_length;
+    return make_apdu(apdu, instruction, P1_CONFIRM, 0, data, length);
+}
+
+void test_sign_message_multiple_signers() {
+    uint8_t message[100];
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA];
+    uint8_t signatures[2 * SIGNATURE_LENGTH];
+    fill_message(message, sizeof(message));
+
+    size_t length = make_signers_apdu(apdu, InsSignMessage, 2, message, sizeof(message));
+    assert(apdu_handle_message(apdu, length, &G_command) == 0);
+    assert(G_command.state == ApduStatePayloadComplete);
+    assert(G_command.num_derivation_paths == 2);
+    assert(G_command.derivation_path_lengths[0] == 4);
+    assert(G_command.derivation_path_lengths[1] == 3);
+    assert(G_command.derivation_paths[1][2] == 0x80000001);
+    assert(G_command.message_length == sizeof(message));
+
+    // one signature per signer, in request order
+    assert(set_result_sign_message() == 2 * SIGNATURE_LENGTH);
+    memcpy(signatures, G_io_apdu_buffer, sizeof(signatures));
+    assert(memcmp(signatures, signatures + SIGNATURE_LENGTH, SIGNATURE_LENGTH) != 0);
+
+    length = make_signers_apdu(apdu, InsSignMessage, 1, message, sizeof(message));
+    assert(apdu_handle_message(apdu, length, &G_command) == 0);
+    assert(set_result_sign_message() == SIGNATURE_LENGTH);
+    assert(memcmp(signatures, G_io_apdu_buffer, SIGNATURE_LENGTH) == 0);
+
+    // bounded per target, and only transactions have several signers
+    length = make_signers_apdu(apdu, InsSignMessage, MAX_SIGNERS + 1, message, 10);
+    assert(apdu_handle_message(apdu, length, &G_command) == ApduReplySolanaInvalidMessage);
+    length = make_signers_apdu(apdu, InsSignMessage, 0, message, 10);
+    assert(apdu_handle_message(apdu, length, &G_command) == ApduReplySolanaInvalidMessage);
+    length = make_signers_apdu(apdu, InsSignOffchainMessage, 2, message, 10);
+    assert(apdu_handle_message(apdu, length, &G_command) == ApduReplySolanaInvalidMessage);
+}
+
+void test_offchain_message_stream_chunk() {
+    uint8_t message[MAX_APDU_DATA];
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA];
+    fill_message(message, sizeof(message));
+
+    // chunks are handed over one at a time with their P2, never accumulated
+    ApduCommand command = {0};
+    for (int i = 0; i < 2; i++) {
+        const uint8_t p2 = P2_SECOND_PASS | P2_EXTEND | P2_MORE;
+        const size_t length = make_apdu(apdu,
+                                        InsSignOffchainMessageStream,
+                                        P1_CONFIRM,
+                                        p2,
+                                        message,
+                                        sizeof(message));
+        assert(apdu_handle_message(apdu, length, &command) == 0);
+        assert(command.state == ApduStatePayloadComplete);
+        assert(command.p2 == p2);
+        assert(command.message_length == sizeof(message));
+        assert(memcmp(command.message, message, sizeof(message)) == 0);
+    }
+
+    // a chunk must carry data
+    const size_t length =
+        make_apdu(apdu, InsSignOffchainMessageStream, P1_CONFIRM, P2_MORE, NULL, 0);
+    assert(apdu_handle_message(apdu, length, &command) == ApduReplySolanaInvalidMessageSize);
+}
+
+void test_sign_message_batch_chunks() {
+    uint8_t message[400];
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA];
+    fill_message(message, sizeof(message));
+
+    // queued and signed transactions are hashed like any SIGN MESSAGE
+    ApduCommand command = {0};
+    assert(send_message(InsSignMessage, message, sizeof(message), 100, &command) == 0);
+    Hash expected;
+    memcpy(&expected, &command.message_hash, sizeof(expected));
+    memset(&command, 0, sizeof(command));
+    assert(send_message(InsSignMessageBatch, message, sizeof(message), 100, &command) == 0);
+    assert(command.state == ApduStatePayloadComplete);
+    assert(memcmp(&command.message_hash, &expected, sizeof(expected)) == 0);
+
+    // a transaction is either queued or signed, not both
+    uint8_t data[MAX_APDU_DATA];
+    data[0] = 1;
+    memcpy(data + 1, DERIVATION_PATH, sizeof(DERIVATION_PATH));
+    size_t length = make_apdu(apdu,
+                              InsSignMessageBatch,
+                              P1_CONFIRM,
+                              P2_SECOND_PASS | P2_MORE,
+                              data,
+                              1 + sizeof(DERIVATION_PATH));
+    assert(apdu_handle_message(apdu, length, &command) == 0);
+    assert(command.p2 & P2_SECOND_PASS);
+    length = make_apdu(apdu, InsSignMessageBatch, P1_CONFIRM, P2_EXTEND, message, 10);
+    assert(apdu_handle_message(apdu, length, &command) == ApduReplySolanaInvalidMessage);
+
+    // one signer per transaction
+    length = make_signers_apdu(apdu, InsSignMessageBatch, 2, message, 10);
+    assert(apdu_handle_message(apdu, length, &command) == ApduReplySolanaInvalidMessage);
+}
+
+void test_sign_message_compressed() {
+    // A transfer, the system program taken from the dictionary
+    const uint8_t message[] = {1,  0, 1, 3, BYTES32_BS58_2, BYTES32_BS58_3, PROGRAM_ID_SYSTEM,
+                               BYTES32_BS58_4, 1, 2, 2, 0, 1, 12, 2, 0, 0, 0, 42, 0, 0, 0, 0, 0, 0,
+                               0};
+    uint8_t compressed[sizeof(message)];
+    size_t compressed_length = 0;
+    assert(message_compress(message,
+                            sizeof(message),
+                            compressed,
+                            sizeof(compressed),
+                            &compressed_length) == 0);
+    assert(compressed_length < sizeof(message));
+    Hash expected;
+    cx_hash_sha256(message, sizeof(message), expected.data, HASH_LENGTH);
+
+    // what is hashed and kept is the original message, however it is chunked
+    const size_t chunk_sizes[] = {19, 30, 64, MAX_APDU_DATA};
+    for (size_t i = 0; i < ARRAY_COUNT(chunk_sizes); i++) {
+        ApduCommand command;
+        assert(send_message_with_p2(InsSignMessage,
+                                    P2_COMPRESSED,
+                                    compressed,
+                                    compressed_length,
+                                    chunk_sizes[i],
+                                    &command) == 0);
+        assert(command.state == ApduStatePayloadComplete);
+        assert(command.message_length == (int) sizeof(message));
+        assert(memcmp(command.message, message, sizeof(message)) == 0);
+        assert(memcmp(&command.message_hash, &expected, HASH_LENGTH) == 0);
+    }
+
+    // the account table must be complete once the last chunk arrived
+    ApduCommand command;
+    assert(send_message_with_p2(InsSignMessage, P2_COMPRESSED, compressed, 40, 64, &command) ==
+           ApduReplySolanaInvalidMessage);
+
+    // a message is compressed from its first chunk to its last
+    uint8_t data[MAX_APDU_DATA];
+    data[0] = 1;
+    memcpy(data + 1, DERIVATION_PATH, sizeof(DERIVATION_PATH));
+    memcpy(data + 1 + sizeof(DERIVATION_PATH), compressed, 10);
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA];
+    size_t length = make_apdu(apdu,
+                              InsSignMessage,
+                              P1_CONFIRM,
+                              P2_COMPRESSED | P2_MORE,
+                              data,
+                              1 + sizeof(DERIVATION_PATH) + 10);
+    assert(apdu_handle_message(apdu, length, &command) == 0);
+    length = make_apdu(apdu, InsSignMessage, P1_CONFIRM, P2_EXTEND, compressed + 10, 10);
+    assert(apdu_handle_message(apdu, length, &command) == ApduReplySolanaInvalidMessage);
+
+    // only transactions are compressed
+    assert(send_message_with_p2(InsSignOffchainMessage,
+                                P2_COMPRESSED,
+                                compressed,
+                                compressed_length,
+                                64,
+                                &command) == ApduReplySdkNotSupported);
+}
+
+// Signer count, path then message, as sent over a P2_OFFSET transfer
+static size_t make_transfer(uint8_t *transfer, const uint8_t *message, size_t message_length) {
+    transfer[0] = 1;
+    memcpy(transfer + 1, DERIVATION_PATH, sizeof(DERIVATION_PATH));
+    memcpy(transfer + 1 + sizeof(DERIVATION_PATH), message, message_length);
+    return 1 + sizeof(DERIVATION_PATH) + message_length;
+}
+
+// Send transfer[offset, offset + length) as one P2_OFFSET chunk
+static int send_at(uint8_t transfer_id,
+                   const uint8_t *transfer,
+                   size_t transfer_length,
+                   size_t offset,
+                   size_t length,
+                   ApduCommand *command) {
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA];
+    uint8_t data[MAX_APDU_DATA] = {transfer_id, offset >> 8, offset};
+    memcpy(data + 3, transfer + offset, length);
+    const uint8_t p2 = P2_OFFSET | (offset + length < transfer_length ? P2_MORE : 0);
+    const size_t apdu_length = make_apdu(apdu, InsSignMessage, P1_CONFIRM, p2, data, 3 + length);
+    return apdu_handle_message(apdu, apdu_length, command);
+}
+
+static void assert_message_complete(const ApduCommand *command,
+                                    const uint8_t *message,
+                                    size_t message_length) {
+    Hash expected;
+    cx_hash_sha256(message, message_length, expected.data, HASH_LENGTH);
+    assert(command->state == ApduStatePayloadComplete);
+    assert(command->message_length == (int) message_length);
+    assert(memcmp(command->message, message, message_length) == 0);
+    assert(memcmp(&command->message_hash, &expected, HASH_LENGTH) == 0);
+}
+
+void test_offset_chunks_in_order() {
+    uint8_t message[600];
+    uint8_t transfer[MAX_MESSAGE_LENGTH];
+    fill_message(message, sizeof(message));
+    const size_t length = make_transfer(transfer, message, sizeof(message));
+
+    ApduCommand command = {0};
+    for (size_t offset = 0; offset < length; offset += 200) {
+        const size_t take = length - offset < 200 ? length - offset : 200;
+        assert(send_at(1, transfer, length, offset, take, &command) == 0);
+        if (offset + take < length) {
+            assert(command.state == ApduStatePayloadInProgress);
+            assert(command.transfer_committed == offset + take);
+        }
+    }
+    assert_message_complete(&command, message, sizeof(message));
+}
+
+void test_offset_chunks_lost() {
+    uint8_t message[600];
+    uint8_t transfer[MAX_MESSAGE_LENGTH];
+    fill_message(message, sizeof(message));
+    const size_t length = make_transfer(transfer, message, sizeof(message));
+
+    ApduCommand command = {0};
+    assert(send_at(1, transfer, length, 0, 200, &command) == 0);
+    // [200, 400) is lost, what follows is dropped rather than failing
+    assert(send_at(1, transfer, length, 400, length - 400, &command) == 0);
+    assert(command.state == ApduStatePayloadInProgress);
+    assert(command.transfer_committed == 200);
+
+    // the host resumes from the acknowledged length
+    assert(send_at(1, transfer, length, 200, 200, &command) == 0);
+    assert(command.transfer_committed == 400);
+    assert(send_at(1, transfer, length, 400, length - 400, &command) == 0);
+    assert_message_complete(&command, message, sizeof(message));
+}
+
+void test_offset_chunks_duplicated() {
+    uint8_t message[600];
+    uint8_t transfer[MAX_MESSAGE_LENGTH];
+    fill_message(message, sizeof(message));
+    const size_t length = make_transfer(transfer, message, sizeof(message));
+
+    ApduCommand command = {0};
+    assert(send_at(1, transfer, length, 0, 200, &command) == 0);
+    assert(send_at(1, transfer, length, 0, 200, &command) == 0);
+    assert(command.transfer_committed == 200);
+    assert(command.num_derivation_paths == 1);
+
+    // only the bytes not committed yet are taken from an overlapping chunk
+    assert(send_at(1, transfer, length, 100, 200, &command) == 0);
+    assert(command.transfer_committed == 300);
+    assert(send_at(1, transfer, length, 200, 100, &command) == 0);
+    assert(command.transfer_committed == 300);
+    assert(send_at(1, transfer, length, 300, 200, &command) == 0);
+    assert(send_at(1, transfer, length, 500, length - 500, &command) == 0);
+    assert_message_complete(&command, message, sizeof(message));
+}
+
+void test_offset_chunks_reordered() {
+    uint8_t message[600];
+    uint8_t transfer[MAX_MESSAGE_LENGTH];
+    fill_message(message, sizeof(message));
+    const size_t length = make_transfer(transfer, message, sizeof(message));
+
+    // the last chunk overtakes the middle one and has to be sent again
+    ApduCommand command = {0};
+    assert(send_at(1, transfer, length, 0, 250, &command) == 0);
+    assert(send_at(1, transfer, length, 500, length - 500, &command) == 0);
+    assert(send_at(1, transfer, length, 250, 250, &command) == 0);
+    assert(command.state == ApduStatePayloadInProgress);
+    assert(command.transfer_committed == 500);
+    assert(send_at(1, transfer, length, 500, length - 500, &command) == 0);
+    assert_message_complete(&command, message, sizeof(message));
+}
+
+void test_offset_chunks_new_transfer() {
+    uint8_t message[600];
+    uint8_t transfer[MAX_MESSAGE_LENGTH];
+    fill_message(message, sizeof(message));
+    const size_t length = make_transfer(transfer, message, sizeof(message));
+
+    // another transfer id starts over, from its first byte only
+    ApduCommand command = {0};
+    assert(send_at(1, transfer, length, 0, 200, &command) == 0);
+    assert(send_at(1, transfer, length, 200, 200, &command) == 0);
+    assert(send_at(2, transfer, length, 0, 100, &command) == 0);
+    assert(command.transfer_id == 2);
+    assert(command.transfer_committed == 100);
+
+    // a chunk of another transfer past its start is stale and ignored
+    const ApduCommand in_progress = command;
+    assert(send_at(3, transfer, length, 100, 100, &command) == ApduReplySuccess);
+    assert(memcmp(&command, &in_progress, sizeof(command)) == 0);
+
+    // offsets replace P2_EXTEND and only modern hosts send them
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA];
+    const uint8_t data[] = {1, 0, 0, 1};
+    size_t apdu_length =
+        make_apdu(apdu, InsSignMessage, P1_CONFIRM, P2_OFFSET | P2_EXTEND, data, sizeof(data));
+    assert(apdu_handle_message(apdu, apdu_length, &command) == ApduReplySdkNotSupported);
+    apdu_length = make_apdu(apdu, InsSignMessage, P1_CONFIRM, P2_OFFSET, data, 3);
+    assert(apdu_handle_message(apdu, apdu_length, &command) == ApduReplySolanaInvalidMessageSize);
+}
+
+void test_offset_chunks_after_completion() {
+    uint8_t message[600];
+    uint8_t transfer[MAX_MESSAGE_LENGTH];
+    fill_message(message, sizeof(message));
+    const size_t length = make_transfer(transfer, message, sizeof(message));
+
+    ApduCommand command = {0};
+    assert(send_at(1, transfer, length, 0, 200, &command) == 0);
+    assert(send_at(1, transfer, length, 200, 200, &command) == 0);
+    assert(send_at(1, transfer, length, 400, length - 400, &command) == 0);
+    assert_message_complete(&command, message, sizeof(message));
+    assert(command.transfer_id == 1);
+    assert(command.transfer_committed == length);
+
+    // the last chunk again, its response lost, or any other one of the
+    // transfer leaves the complete message as is
+    const ApduCommand complete = command;
+    assert(send_at(1, transfer, length, 400, length - 400, &command) == ApduReplySuccess);
+    assert(send_at(1, transfer, length, 200, 200, &command) == ApduReplySuccess);
+    assert(memcmp(&command, &complete, sizeof(command)) == 0);
+
+    // as does a stale chunk of an older transfer
+    assert(send_at(0, transfer, length, 400, length - 400, &command) == ApduReplySuccess);
+    assert(memcmp(&command, &complete, sizeof(command)) == 0);
+
+    // while another transfer starts over
+    assert(send_at(2, transfer, length, 0, 200, &command) == 0);
+    assert(command.state == ApduStatePayloadInProgress);
+    assert(command.transfer_id == 2);
+    assert(command.transfer_committed == 200);
+}
+
+// Serialize one extended length APDU into apdu, returns its length
+static size_t make_extended_apdu(uint8_t *apdu,
+                                 uint8_t instruction,
+                                 uint8_t p2,
+                                 const uint8_t *data,
+                                 size_t data_length) {
+    assert(data_length <= MAX_APDU_DATA_LENGTH);
+    apdu[OFFSET_CLA] = CLA;
+    apdu[OFFSET_INS] = instruction;
+    apdu[OFFSET_P1] = P1_CONFIRM;
+    apdu[OFFSET_P2] = p2;
+    apdu[OFFSET_LC] = 0;
+    apdu[OFFSET_LC + 1] = data_length >> 8;
+    apdu[OFFSET_LC + 2] = data_length;
+    memcpy(apdu + EXTENDED_OFFSET_CDATA, data, data_length);
+    return EXTENDED_OFFSET_CDATA + data_length;
+}
+
+void test_extended_length_apdu() {
+    static uint8_t message[PACKET_DATA_SIZE];
+    static uint8_t transfer[IO_APDU_BUFFER_SIZE];
+    static uint8_t apdu[IO_APDU_BUFFER_SIZE];
+    fill_message(message, sizeof(message));
+    assert(EXTENDED_APDUS_SUPPORTED);
+
+    // a full transaction fits a single APDU
+    ApduCommand command = {0};
+    size_t length = make_transfer(transfer, message, sizeof(message));
+    size_t apdu_length = make_extended_apdu(apdu, InsSignMessage, 0, transfer, length);
+    assert(apdu_handle_message(apdu, apdu_length, &command) == 0);
+    assert_message_complete(&command, message, sizeof(message));
+
+    // or two, chunked as usual
+    apdu_length = make_extended_apdu(apdu, InsSignMessage, P2_MORE, transfer, 700);
+    assert(apdu_handle_message(apdu, apdu_length, &command) == 0);
+    apdu_length = make_extended_apdu(apdu, InsSignMessage, P2_EXTEND, transfer + 700, length - 700);
+    assert(apdu_handle_message(apdu, apdu_length, &command) == 0);
+    assert_message_complete(&command, message, sizeof(message));
+
+    // the length must match, and fit the APDU buffer
+    apdu_length = make_extended_apdu(apdu, InsSignMessage, 0, transfer, length);
+    assert(apdu_handle_message(apdu, apdu_length - 1, &command) ==
+           ApduReplySolanaInvalidMessageSize);
+    apdu[OFFSET_LC + 1] = 0xff;
+    assert(apdu_handle_message(apdu, apdu_length, &command) == ApduReplySolanaInvalidMessageSize);
+    assert(apdu_handle_message(apdu, OFFSET_CDATA + 1, &command) ==
+           ApduReplySolanaInvalidMessageSize);
+
+    // other instructions fit short APDUs
+    apdu_length = make_extended_apdu(apdu, InsGetPubkeyBatch, 0, transfer, 300);
+    assert(apdu_handle_message(apdu, apdu_length, &command) == ApduReplySolanaInvalidMessageSize);
+}
+
+int main() {
+    test_host_sha256();
+    test_sign_message_hash_every_chunking();
+    test_sign_offchain_message_hash();
+    test_hash_pending_until_last_chunk();
+    test_restart_resets_hash();
+    test_deprecated_sign_message_hash();
+    test_get_pubkey();
+    test_invalid_continuation();
+    test_sign_message_multiple_signers();
+    test_offchain_message_stream_chunk();
+    test_sign_message_batch_chunks();
+    test_sign_message_compressed();
+    test_offset_chunks_in_order();
+    test_offset_chunks_lost();
+    test_offset_chunks_duplicated();
+    test_offset_chunks_reordered();
+    test_offset_chunks_new_transfer();
+    test_offset_chunks_after_completion();
+    test_extended_length_apdu();
+
+    printf("passed\n");
+    return 0;
+}
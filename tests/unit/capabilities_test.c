@@ -0,0 +1,80 @@
+#include "capabilities.h"
+#include "globals.h"
+#include "utils.h"
+#include "sol/message.h"
+#include "sol/pubkey_dictionary.h"
+#include "sol/transaction_summary.h"
+#include <assert.h>
+#include <stdio.h>
+
+ApduCommand G_command;
+
+// Of the dictionary of libsol/pubkey_dictionary.c, to update along with it
+#define KEY_DICTIONARY_DIGEST 0x0d1088ea
+
+// Value of tag in the block, -1 if it is missing
+static int64_t find_capability(const uint8_t *block, size_t length, uint8_t tag) {
+    size_t offset = 2;
+    while (offset < length) {
+        assert(offset + 2 <= length);
+        const uint8_t value_length = block[offset + 1];
+        assert(offset + 2 + value_length <= length);
+        if (block[offset] == tag) {
+            int64_t value = 0;
+            for (uint8_t i = 0; i < value_length; i++) {
+                value = value << 8 | block[offset + 2 + i];
+            }
+            return value;
+        }
+        offset += 2 + value_length;
+    }
+    return -1;
+}
+
+void test_capabilities_block() {
+    uint8_t block[SHORT_APDU_BUFFER_SIZE];
+    const size_t length = write_capabilities(block, sizeof(block));
+    assert(length > 2);
+    assert(block[0] == CAPABILITIES_VERSION);
+    assert(block[1] == length - 2);
+
+    assert(find_capability(block, length, CapabilityMaxMessageLength) == MAX_MESSAGE_LENGTH);
+    assert(find_capability(block, length, CapabilityMaxApduDataLength) == MAX_APDU_DATA_LENGTH);
+    assert(find_capability(block, length, CapabilityMaxSigners) == MAX_SIGNERS);
+    assert(find_capability(block, length, CapabilityMaxInstructions) == MAX_INSTRUCTIONS);
+    assert(find_capability(block, length, CapabilityMaxSummaryItems) ==
+           MAX_TRANSACTION_SUMMARY_ITEMS);
+    assert(find_capability(block, length, CapabilityMaxBatchTransactions) ==
+           MAX_BATCH_TRANSACTIONS);
+    assert(find_capability(block, length, CapabilityKeyDictionarySize) ==
+           (int64_t) pubkey_dictionary_size());
+    assert(find_capability(block, length, CapabilityKeyDictionaryDigest) ==
+           KEY_DICTIONARY_DIGEST);
+    assert(find_capability(block, length, CapabilityMaxOffchainMessageLength) ==
+           MAX_OFFCHAIN_MESSAGE_LENGTH);
+
+    const int64_t features = find_capability(block, length, CapabilityFeatures);
+    assert(features & CapabilityFeatureCompressedMessages);
+    assert(features & CapabilityFeatureOffsetChunks);
+    assert(features & CapabilityFeatureTokenDescriptors);
+    assert(!(features & CapabilityFeatureExtendedApdus) == !EXTENDED_APDUS_SUPPORTED);
+
+    // unknown tags are absent, not errors
+    assert(find_capability(block, length, 0xff) == -1);
+}
+
+void test_capabilities_do_not_fit() {
+    uint8_t block[SHORT_APDU_BUFFER_SIZE];
+    const size_t length = write_capabilities(block, sizeof(block));
+    assert(write_capabilities(block, length) == length);
+    assert(write_capabilities(block, length - 1) == 0);
+    assert(write_capabilities(block, 1) == 0);
+}
+
+int main() {
+    test_capabilities_block();
+    test_capabilities_do_not_fit();
+
+    printf("passed\n");
+    return 0;
+}
@@ -0,0 +1,199 @@
+#include "apdu.h"
+#include "ed25519_stream.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+ApduCommand G_command;
+
+// RFC 8032 section 7.1
+typedef struct TestVector {
+    const char *secret_key;
+    const char *public_key;
+    const char *message;
+    const char *signature;
+} TestVector;
+
+static const TestVector RFC8032_VECTORS[] = {
+    {"9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
+     "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+     "",
+     "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9"
+     "b46bd25bf5f0595bbe24655141438e7a100b"},
+    {"4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb",
+     "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c",
+     "72",
+     "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da085ac1e43e15996e458f3613d0f1"
+     "1d8c387b2eaeb4302aeeb00d291612bb0c00"},
+    {"c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7",
+     "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025",
+     "af82",
+     "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac18ff9b538d16f290ae67f760984d"
+     "c6594a7c15e9716ed28dc027beceea1ec40a"},
+    // TEST SHA(abc)
+    {"833fe62409237b9d62ec77587520911e9a759cec1d19755b7da901b96dca3d42",
+     "ec172b93ad5e563bf4932c70e1245034c35467ef2efd4d64ebf819683467e2bf",
+     "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3fe"
+     "ebbd454d4423643ce80e2a9ac94fa54ca49f",
+     "dc2a4459e7369633a52b1bf277839a00201009a3efbf3ecb69bea2186c26b58909351fc9ac90b3ecfdfbc7c66431"
+     "e0303dca179c138ac17ad9bef1177331a704"},
+};
+
+#define MAX_TEST_MESSAGE_LENGTH 1024
+
+static size_t from_hex(uint8_t *out, size_t out_size, const char *hex) {
+    const size_t length = strlen(hex) / 2;
+    assert(length <= out_size);
+    for (size_t i = 0; i < length; i++) {
+        unsigned int byte;
+        assert(sscanf(hex + 2 * i, "%2x", &byte) == 1);
+        out[i] = (uint8_t) byte;
+    }
+    return length;
+}
+
+static void make_private_key(cx_ecfp_private_key_t *private_key, const char *secret_key) {
+    memset(private_key, 0, sizeof(*private_key));
+    private_key->curve = CX_CURVE_Ed25519;
+    private_key->d_len = from_hex(private_key->d, sizeof(private_key->d), secret_key);
+}
+
+static void update_in_chunks(Ed25519Stream *stream,
+                             const uint8_t *message,
+                             size_t length,
+                             size_t chunk_length) {
+    for (size_t offset = 0; offset < length; offset += chunk_length) {
+        const size_t remaining = length - offset;
+        const size_t take = remaining < chunk_length ? remaining : chunk_length;
+        assert(ed25519_stream_update(stream, message + offset, take) == CX_OK);
+    }
+}
+
+// Both passes over message, in chunks of their own length
+static cx_err_t sign_streamed(const cx_ecfp_private_key_t *private_key,
+                              const uint8_t *message,
+                              size_t length,
+                              size_t first_chunk_length,
+                              size_t second_chunk_length,
+                              uint8_t public_key[static ED25519_SCALAR_LENGTH],
+                              uint8_t signature[static ED25519_SIGNATURE_LENGTH]) {
+    Ed25519Stream stream;
+    assert(ed25519_stream_init(&stream, private_key) == CX_OK);
+    update_in_chunks(&stream, message, length, first_chunk_length);
+    assert(ed25519_stream_finish_first_pass(&stream, private_key) == CX_OK);
+    memcpy(public_key, stream.public_key, ED25519_SCALAR_LENGTH);
+    update_in_chunks(&stream, message, length, second_chunk_length);
+    return ed25519_stream_finish_second_pass(&stream, private_key, signature);
+}
+
+void test_rfc8032_vectors() {
+    for (size_t i = 0; i < sizeof(RFC8032_VECTORS) / sizeof(RFC8032_VECTORS[0]); i++) {
+        const TestVector *vector = &RFC8032_VECTORS[i];
+        cx_ecfp_private_key_t private_key;
+        uint8_t message[MAX_TEST_MESSAGE_LENGTH];
+        uint8_t expected_public_key[ED25519_SCALAR_LENGTH];
+        uint8_t expected_signature[ED25519_SIGNATURE_LENGTH];
+        make_private_key(&private_key, vector->secret_key);
+        const size_t length = from_hex(message, sizeof(message), vector->message);
+        from_hex(expected_public_key, sizeof(expected_public_key), vector->public_key);
+        from_hex(expected_signature, sizeof(expected_signature), vector->signature);
+
+        // the host SDK signs as the device would
+        uint8_t signature[ED25519_SIGNATURE_LENGTH];
+        assert(cx_eddsa_sign_no_throw(&private_key,
+                                      CX_SHA512,
+                                      message,
+                                      length,
+                                      signature,
+                                      sizeof(signature)) == CX_OK);
+        assert(memcmp(signature, expected_signature, sizeof(signature)) == 0);
+
+        uint8_t public_key[ED25519_SCALAR_LENGTH];
+        memset(signature, 0, sizeof(signature));
+        assert(sign_streamed(&private_key, message, length, 1, 7, public_key, signature) ==
+               CX_OK);
+        assert(memcmp(public_key, expected_public_key, sizeof(public_key)) == 0);
+        assert(memcmp(signature, expected_signature, sizeof(signature)) == 0);
+    }
+}
+
+void test_streamed_matches_one_shot() {
+    cx_ecfp_private_key_t private_key;
+    make_private_key(&private_key, RFC8032_VECTORS[0].secret_key);
+    uint8_t message[MAX_TEST_MESSAGE_LENGTH];
+    srand(1);
+    for (size_t i = 0; i < sizeof(message); i++) {
+        message[i] = (uint8_t) rand();
+    }
+
+    uint8_t expected[ED25519_SIGNATURE_LENGTH];
+    assert(cx_eddsa_sign_no_throw(&private_key,
+                                  CX_SHA512,
+                                  message,
+                                  sizeof(message),
+                                  expected,
+                                  sizeof(expected)) == CX_OK);
+
+    // the chunking of either pass does not matter
+    const size_t chunk_lengths[] = {1, 100, 255, sizeof(message)};
+    const size_t num_chunk_lengths = sizeof(chunk_lengths) / sizeof(chunk_lengths[0]);
+    for (size_t i = 0; i < num_chunk_lengths; i++) {
+        uint8_t public_key[ED25519_SCALAR_LENGTH];
+        uint8_t signature[ED25519_SIGNATURE_LENGTH];
+        assert(sign_streamed(&private_key,
+                             message,
+                             sizeof(message),
+                             chunk_lengths[i],
+                             chunk_lengths[(i + 1) % num_chunk_lengths],
+                             public_key,
+                             signature) == CX_OK);
+        assert(memcmp(signature, expected, sizeof(signature)) == 0);
+    }
+}
+
+void test_second_pass_over_other_message_refused() {
+    cx_ecfp_private_key_t private_key;
+    make_private_key(&private_key, RFC8032_VECTORS[1].secret_key);
+    const uint8_t first[] = "first message";
+    const uint8_t second[] = "other message";
+
+    Ed25519Stream stream;
+    uint8_t signature[ED25519_SIGNATURE_LENGTH];
+    assert(ed25519_stream_init(&stream, &private_key) == CX_OK);
+    assert(ed25519_stream_update(&stream, first, sizeof(first)) == CX_OK);
+    assert(ed25519_stream_finish_first_pass(&stream, &private_key) == CX_OK);
+    assert(ed25519_stream_update(&stream, second, sizeof(second)) == CX_OK);
+    memset(signature, 0xff, sizeof(signature));
+    assert(ed25519_stream_finish_second_pass(&stream, &private_key, signature) != CX_OK);
+
+    // nothing is left of the signature or the stream
+    const uint8_t zeros[ED25519_SIGNATURE_LENGTH] = {0};
+    assert(memcmp(signature, zeros, sizeof(signature)) == 0);
+    assert(!stream.second_pass);
+}
+
+void test_out_of_order_refused() {
+    cx_ecfp_private_key_t private_key;
+    make_private_key(&private_key, RFC8032_VECTORS[2].secret_key);
+    uint8_t signature[ED25519_SIGNATURE_LENGTH];
+
+    // the second pass needs R
+    Ed25519Stream stream;
+    assert(ed25519_stream_init(&stream, &private_key) == CX_OK);
+    assert(ed25519_stream_finish_second_pass(&stream, &private_key, signature) != CX_OK);
+
+    // a single first pass
+    assert(ed25519_stream_init(&stream, &private_key) == CX_OK);
+    assert(ed25519_stream_finish_first_pass(&stream, &private_key) == CX_OK);
+    assert(ed25519_stream_finish_first_pass(&stream, &private_key) != CX_OK);
+}
+
+int main() {
+    test_rfc8032_vectors();
+    test_streamed_matches_one_shot();
+    test_second_pass_over_other_message_refused();
+    test_out_of_order_refused();
+
+    printf("passed\n");
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include "apdu.h"
+#include "utils.h"
+#include "handle_get_pubkey.h"
+#include <assert.h>
+#include <stdio.h>
+
+ApduCommand G_command;
+
+#define MAX_APDU_DATA 255
+#define HEADER_LENGTH 5
+#define MAX_KEYS      ((SHORT_APDU_BUFFER_SIZE - HEADER_LENGTH - 2) / PUBKEY_LENGTH)
+
+// Run GET PUBKEY BATCH on data, returns the status word it throws
+static unsigned int get_pubkey_batch(uint8_t p1,
+                                     const uint8_t *data,
+                                     size_t data_length,
+                                     unsigned int *tx) {
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA] = {CLA, InsGetPubkeyBatch, p1, 0, data_length};
+    memcpy(apdu + OFFSET_CDATA, data, data_length);
+    assert(apdu_handle_message(apdu, OFFSET_CDATA + data_length, &G_command) == 0);
+
+    jmp_buf catch;
+    volatile unsigned int result = 0;
+    sdk_stub_catch = &catch;
+    const int code = setjmp(catch);
+    if (code == 0) {
+        handle_get_pubkey_batch(&result);
+    }
+    sdk_stub_catch = NULL;
+    *tx = result;
+    return code;
+}
+
+static uint32_t cursor_of_response() {
+    return U4BE(G_io_apdu_buffer, 1);
+}
+
+static void assert_key_of(size_t index, const uint32_t *path, size_t path_length) {
+    uint8_t expected[PUBKEY_LENGTH];
+    get_public_key(expected, path, path_length);
+    assert(memcmp(G_io_apdu_buffer + HEADER_LENGTH + index * PUBKEY_LENGTH,
+                  expected,
+                  PUBKEY_LENGTH) == 0);
+}
+
+// 44'/501' then first (u32 BE) and count (u32 BE)
+static size_t make_range(uint8_t *data, uint32_t first, uint32_t count) {
+    const uint8_t request[] = {0x00,
+                               2,
+                               0x80,
+                               0,
+                               0,
+                               44,
+                               0x80,
+                               0,
+                               0x01,
+                               0xf5,
+                               first >> 24,
+                               first >> 16,
+                               first >> 8,
+                               first,
+                               count >> 24,
+                               count >> 16,
+                               count >> 8,
+                               count};
+    memcpy(data, request, sizeof(request));
+    return sizeof(request);
+}
+
+void test_range_with_cursor() {
+    uint8_t data[MAX_APDU_DATA];
+    unsigned int tx = 0;
+    uint32_t path[3] = {0x8000002c, 0x800001f5, 0};
+
+    // 20 accounts take three responses, resumed from the cursor
+    uint32_t next = 0x80000000;
+    size_t remaining = 20;
+    while (remaining > 0) {
+        const size_t length = make_range(data, next, remaining);
+        assert(get_pubkey_batch(P1_NON_CONFIRM, data, length, &tx) == ApduReplySuccess);
+        const size_t num_keys = G_io_apdu_buffer[0];
+        assert(num_keys == (remaining < MAX_KEYS ? remaining : MAX_KEYS));
+        assert(tx == HEADER_LENGTH + num_keys * PUBKEY_LENGTH);
+        for (size_t i = 0; i < num_keys; i++) {
+            path[2] = next + i;
+            assert_key_of(i, path, 3);
+        }
+        next += num_keys;
+        remaining -= num_keys;
+        assert(cursor_of_response() == next);
+    }
+    assert(next == 0x80000000 + 20);
+}
+
+void test_list() {
+    const uint8_t data[] = {0x01, 2, 3, 0x80, 0, 0, 44, 0x80, 0, 0x01, 0xf5, 0x80, 0, 0, 7,
+                            2, 0x80, 0, 0, 44, 0x80, 0, 0x01, 0xf5};
+    const uint32_t first[] = {0x8000002c, 0x800001f5, 0x80000007};
+    const uint32_t second[] = {0x8000002c, 0x800001f5};
+    unsigned int tx = 0;
+
+    assert(get_pubkey_batch(P1_NON_CONFIRM, data, sizeof(data), &tx) == ApduReplySuccess);
+    assert(G_io_apdu_buffer[0] == 2);
+    assert(cursor_of_response() == 2);
+    assert(tx == HEADER_LENGTH + 2 * PUBKEY_LENGTH);
+    assert_key_of(0, first, ARRAY_COUNT(first));
+    assert_key_of(1, second, ARRAY_COUNT(second));
+}
+
+void test_invalid_requests() {
+    uint8_t data[MAX_APDU_DATA];
+    unsigned int tx = 0;
+
+    // only exported, never confirmed
+    size_t length = make_range(data, 0x80000000, 1);
+    assert(get_pubkey_batch(P1_CONFIRM, data, length, &tx) == ApduReplySdkNotSupported);
+
+    // empty, wrapping and straddling the hardened boundary
+    length = make_range(data, 0x80000000, 0);
+    assert(get_pubkey_batch(P1_NON_CONFIRM, data, length, &tx) == ApduReplySolanaInvalidMessage);
+    length = make_range(data, 0xfffffffe, 3);
+    assert(get_pubkey_batch(P1_NON_CONFIRM, data, length, &tx) == ApduReplySolanaInvalidMessage);
+    length = make_range(data, 0x7fffffff, 2);
+    assert(get_pubkey_batch(P1_NON_CONFIRM, data, length, &tx) == ApduReplySolanaInvalidMessage);
+
+    // truncated range and unknown layout
+    length = make_range(data, 0x80000000, 1);
+    assert(get_pubkey_batch(P1_NON_CONFIRM, data, length - 1, &tx) ==
+           ApduReplySolanaInvalidMessageSize);
+    data[0] = 0x02;
+    assert(get_pubkey_batch(P1_NON_CONFIRM, data, length, &tx) == ApduReplySolanaInvalidMessage);
+}
+
+int main() {
+    test_range_with_cursor();
+    test_list();
+    test_invalid_requests();
+
+    printf("passed\n");
+    return 0;
+}
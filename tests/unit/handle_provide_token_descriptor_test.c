@@ -0,0 +1,134 @@
+#include "apdu.h"
+#include "utils.h"
+#include "handle_provide_token_descriptor.h"
+#include "sol/token_cache.h"
+#include "token_info.h"
+#include "util.h"
+#include <assert.h>
+#include <stdio.h>
+
+ApduCommand G_command;
+
+#define MAX_APDU_DATA 255
+
+// USDC, its registry symbol replaced by "USDCX", signed with the test key
+// of doc/api.md
+static const uint8_t USDCX_DESCRIPTOR[] = {
+    // mint
+    0xc6, 0xfa, 0x7a, 0xf3, 0xbe, 0xdb, 0xad, 0x3a, 0x3d, 0x65, 0xf3, 0x6a, 0xab, 0xc9, 0x74,
+    0x31, 0xb1, 0xbb, 0xe4, 0xc2, 0xd2, 0xf6, 0xe0, 0xe4, 0x7c, 0xa6, 0x02, 0x03, 0x45, 0x2f,
+    0x5d, 0x61,
+    // symbol
+    0x05, 'U', 'S', 'D', 'C', 'X',
+    // signature
+    0x30, 0x45, 0x02, 0x20, 0x2d, 0x2b, 0xef, 0x71, 0x3d, 0xac, 0x69, 0xc4, 0xfa, 0x7a, 0x29,
+    0x38, 0x24, 0x95, 0x76, 0xba, 0xb1, 0xee, 0xbf, 0xbd, 0x33, 0x1f, 0x22, 0xe8, 0xb2, 0x7f,
+    0xd1, 0x95, 0xf0, 0x4f, 0x0b, 0x4f, 0x02, 0x21, 0x00, 0x81, 0xc1, 0x25, 0xad, 0x34, 0xef,
+    0x05, 0x11, 0xd4, 0x1a, 0xb8, 0x8f, 0xe7, 0xfe, 0x8a, 0x0b, 0x60, 0x04, 0xa1, 0xf4, 0x7f,
+    0xc0, 0x41, 0xe0, 0x04, 0xdb, 0xcc, 0x06, 0x54, 0x62, 0x3a, 0x5d};
+#define SYMBOL_LENGTH_OFFSET PUBKEY_LENGTH
+#define SYMBOL_OFFSET        (PUBKEY_LENGTH + 1)
+#define SIGNATURE_OFFSET     (SYMBOL_OFFSET + 5)
+
+static const Pubkey *usdc_mint() {
+    return (const Pubkey *) USDCX_DESCRIPTOR;
+}
+
+// Run PROVIDE TOKEN DESCRIPTOR on data, returns the status word it throws
+static unsigned int provide_token_descriptor(const uint8_t *data, size_t data_length) {
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA] = {CLA,
+                                                  InsProvideTokenDescriptor,
+                                                  0,
+                                                  0,
+                                                  data_length};
+    memcpy(apdu + OFFSET_CDATA, data, data_length);
+    assert(apdu_handle_message(apdu, OFFSET_CDATA + data_length, &G_command) == 0);
+
+    jmp_buf catch;
+    volatile unsigned int tx = 0;
+    sdk_stub_catch = &catch;
+    const int code = setjmp(catch);
+    if (code == 0) {
+        handle_provide_token_descriptor(&tx);
+    }
+    sdk_stub_catch = NULL;
+    return code;
+}
+
+void test_descriptor_overrides_registry() {
+    token_cache_reset();
+    assert_string_equal(get_token_symbol(usdc_mint()), "USDC");
+
+    assert(provide_token_descriptor(USDCX_DESCRIPTOR, sizeof(USDCX_DESCRIPTOR)) ==
+           ApduReplySuccess);
+    assert_string_equal(get_token_symbol(usdc_mint()), "USDCX");
+
+    // the registry is back once the session cache is gone
+    token_cache_reset();
+    assert_string_equal(get_token_symbol(usdc_mint()), "USDC");
+}
+
+void test_descriptor_signature_rejected() {
+    token_cache_reset();
+    uint8_t descriptor[sizeof(USDCX_DESCRIPTOR)];
+
+    // symbol changed after signing
+    memcpy(descriptor, USDCX_DESCRIPTOR, sizeof(descriptor));
+    descriptor[SYMBOL_OFFSET + 4] = 'Y';
+    assert(provide_token_descriptor(descriptor, sizeof(descriptor)) ==
+           ApduReplySolanaInvalidSignature);
+
+    // signature changed
+    memcpy(descriptor, USDCX_DESCRIPTOR, sizeof(descriptor));
+    descriptor[sizeof(descriptor) - 1] ^= 0x01;
+    assert(provide_token_descriptor(descriptor, sizeof(descriptor)) ==
+           ApduReplySolanaInvalidSignature);
+
+    // not DER
+    memcpy(descriptor, USDCX_DESCRIPTOR, sizeof(descriptor));
+    descriptor[SIGNATURE_OFFSET] = 0x31;
+    assert(provide_token_descriptor(descriptor, sizeof(descriptor)) ==
+           ApduReplySolanaInvalidSignature);
+
+    assert_string_equal(get_token_symbol(usdc_mint()), "USDC");
+}
+
+void test_descriptor_wrong_length() {
+    token_cache_reset();
+    uint8_t descriptor[sizeof(USDCX_DESCRIPTOR) + 1];
+
+    // shorter than mint and symbol length
+    assert(provide_token_descriptor(USDCX_DESCRIPTOR, SYMBOL_LENGTH_OFFSET) ==
+           ApduReplySolanaInvalidMessageSize);
+
+    // symbol running past the end
+    memcpy(descriptor, USDCX_DESCRIPTOR, SIGNATURE_OFFSET);
+    descriptor[SYMBOL_LENGTH_OFFSET] = 0xff;
+    assert(provide_token_descriptor(descriptor, SIGNATURE_OFFSET) ==
+           ApduReplySolanaInvalidMessageSize);
+
+    // signature missing or too short to be DER
+    assert(provide_token_descriptor(USDCX_DESCRIPTOR, SIGNATURE_OFFSET) ==
+           ApduReplySolanaInvalidMessageSize);
+    assert(provide_token_descriptor(USDCX_DESCRIPTOR, SIGNATURE_OFFSET + 7) ==
+           ApduReplySolanaInvalidMessageSize);
+
+    // signature truncated or trailed by a byte
+    assert(provide_token_descriptor(USDCX_DESCRIPTOR, sizeof(USDCX_DESCRIPTOR) - 1) ==
+           ApduReplySolanaInvalidSignature);
+    memcpy(descriptor, USDCX_DESCRIPTOR, sizeof(USDCX_DESCRIPTOR));
+    descriptor[sizeof(USDCX_DESCRIPTOR)] = 0;
+    assert(provide_token_descriptor(descriptor, sizeof(descriptor)) ==
+           ApduReplySolanaInvalidSignature);
+
+    assert_string_equal(get_token_symbol(usdc_mint()), "USDC");
+}
+
+int main() {
+    test_descriptor_overrides_registry();
+    test_descriptor_signature_rejected();
+    test_descriptor_wrong_length();
+
+    printf("passed\n");
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include "apdu.h"
+#include "utils.h"
+#include "handle_set_signing_policy.h"
+#include "handle_sign_message.h"
+#include "sol/transaction_summary.h"
+#include "util.h"
+#include <assert.h>
+#include <stdio.h>
+
+ApduCommand G_command;
+
+#define MAX_APDU_DATA    255
+#define DERIVATION_DEPTH 3
+#define MAX_AMOUNT       1000
+
+static const uint32_t DERIVATION_PATH[DERIVATION_DEPTH] = {0x8000002c, 0x800001f5, 0x80000000};
+
+// Vote111111111111111111111111111111111111111
+static const uint8_t VOTE_PROGRAM_ID[PUBKEY_LENGTH] = {
+    7,   97,  72, 29,  53,  116, 116, 187, 124, 77, 118, 36,  235, 211, 189, 179,
+    216, 53,  94, 115, 209, 16,  67,  252, 13,  163, 83, 128, 0,   0,   0,   0};
+
+#define VOTE_ACCOUNT 0x11
+#define DESTINATION  0x22
+
+static size_t put_derivation_path(uint8_t *out) {
+    size_t length = 0;
+    out[length++] = DERIVATION_DEPTH;
+    for (size_t i = 0; i < DERIVATION_DEPTH; i++) {
+        out[length++] = DERIVATION_PATH[i] >> 24;
+        out[length++] = DERIVATION_PATH[i] >> 16;
+        out[length++] = DERIVATION_PATH[i] >> 8;
+        out[length++] = DERIVATION_PATH[i];
+    }
+    return length;
+}
+
+// Run one single APDU command through handler, returns the status word it
+// throws, or 0 when it leaves the reply to the review
+static unsigned int run(uint8_t instruction,
+                        uint8_t p1,
+                        const uint8_t *data,
+                        size_t data_length,
+                        void (*handler)(volatile unsigned int *flags, volatile unsigned int *tx),
+                        volatile unsigned int *tx) {
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA] = {CLA, instruction, p1, 0, data_length};
+    memcpy(apdu + OFFSET_CDATA, data, data_length);
+    assert(apdu_handle_message(apdu, OFFSET_CDATA + data_length, &G_command) == 0);
+
+    jmp_buf catch;
+    volatile unsigned int flags = 0;
+    sdk_stub_catch = &catch;
+    const int code = setjmp(catch);
+    if (code == 0) {
+        handler(&flags, tx);
+        assert(flags & IO_ASYNCH_REPLY);
+    }
+    sdk_stub_catch = NULL;
+    return code;
+}
+
+static unsigned int set_signing_policy(uint8_t p1, uint8_t pattern, uint64_t max_amount) {
+    uint8_t data[MAX_APDU_DATA];
+    size_t length = 0;
+    data[length++] = pattern;
+    if (pattern != SigningPolicyNone) {
+        length += put_derivation_path(data + length);
+        memset(data + length, VOTE_ACCOUNT, PUBKEY_LENGTH);
+        length += PUBKEY_LENGTH;
+        memset(data + length, DESTINATION, PUBKEY_LENGTH);
+        length += PUBKEY_LENGTH;
+        for (size_t i = 0; i < sizeof(uint64_t); i++) {
+            data[length++] = max_amount >> (8 * (sizeof(uint64_t) - 1 - i));
+        }
+    }
+    volatile unsigned int tx = 0;
+    return run(InsSetSigningPolicy, p1, data, length, handle_set_signing_policy, &tx);
+}
+
+static void parse_message(volatile unsigned int *flags, volatile unsigned int *tx) {
+    handle_sign_message_parse_message(tx);
+    // reviewed transactions go on to the UI
+    *flags |= IO_ASYNCH_REPLY;
+}
+
+// SIGN MESSAGE with P1 00 of a vote withdraw of lamports, authorized by the
+// key of DERIVATION_PATH
+static unsigned int sign_withdraw_unattended(uint64_t lamports) {
+    uint8_t data[MAX_APDU_DATA];
+    size_t length = 0;
+    data[length++] = 1;
+    length += put_derivation_path(data + length);
+
+    // header: the authority signs, the program is read-only
+    data[length++] = 1;
+    data[length++] = 0;
+    data[length++] = 1;
+    // authority, vote account, destination and the vote program
+    data[length++] = 4;
+    get_public_key(data + length, DERIVATION_PATH, DERIVATION_DEPTH);
+    length += PUBKEY_LENGTH;
+    memset(data + length, VOTE_ACCOUNT, PUBKEY_LENGTH);
+    length += PUBKEY_LENGTH;
+    memset(data + length, DESTINATION, PUBKEY_LENGTH);
+    length += PUBKEY_LENGTH;
+    memcpy(data + length, VOTE_PROGRAM_ID, PUBKEY_LENGTH);
+    length += PUBKEY_LENGTH;
+    // blockhash
+    memset(data + length, 0x33, HASH_LENGTH);
+    length += HASH_LENGTH;
+    // withdraw(lamports) from account 1 to account 2, authorized by account 0
+    const uint8_t withdraw[] = {1, 3, 3, 1, 2, 0, 12, 3, 0, 0, 0};
+    memcpy(data + length, withdraw, sizeof(withdraw));
+    length += sizeof(withdraw);
+    for (size_t i = 0; i < sizeof(uint64_t); i++) {
+        data[length++] = lamports >> (8 * i);
+    }
+
+    volatile unsigned int tx = 0;
+    const unsigned int sw = run(InsSignMessage, P1_NON_CONFIRM, data, length, parse_message, &tx);
+    assert(tx == (sw == ApduReplySuccess ? SIGNATURE_LENGTH : 0));
+    return sw;
+}
+
+static void install_withdraw_policy(void) {
+    const unsigned int reviews = sdk_stub_reviews;
+    assert(set_signing_policy(P1_CONFIRM, SigningPolicyVoteWithdraw, MAX_AMOUNT) == 0);
+    assert(sdk_stub_reviews == reviews + 1);
+    assert(set_result_set_signing_policy() == 0);
+}
+
+void test_review_shows_cap_per_transaction() {
+    assert(set_signing_policy(P1_CONFIRM, SigningPolicyVoteWithdraw, MAX_AMOUNT) == 0);
+
+    enum SummaryItemKind kinds[MAX_TRANSACTION_SUMMARY_ITEMS];
+    size_t num_kinds = 0;
+    assert(transaction_summary_finalize(kinds, &num_kinds) == 0);
+    bool shown = false;
+    for (size_t i = 0; i < num_kinds; i++) {
+        assert(transaction_summary_display_item(i, DisplayFlagNone) == 0);
+        if (strcmp(G_transaction_summary_title, "Max per tx") == 0) {
+            assert_string_equal(G_transaction_summary_text, "0.000001 SOL");
+            shown = true;
+        }
+    }
+    assert(shown);
+}
+
+void test_policy_installed_only_once_approved() {
+    assert(set_signing_policy(P1_CONFIRM, SigningPolicyNone, 0) == ApduReplySuccess);
+    assert(set_signing_policy(P1_NON_CONFIRM, SigningPolicyVoteWithdraw, MAX_AMOUNT) ==
+           ApduReplySdkNotSupported);
+    assert(N_storage.policy.pattern == SigningPolicyNone);
+
+    assert(set_signing_policy(P1_CONFIRM, SigningPolicyVoteWithdraw, MAX_AMOUNT) == 0);
+    assert(N_storage.policy.pattern == SigningPolicyNone);
+    assert(set_result_set_signing_policy() == 0);
+    assert(N_storage.policy.pattern == SigningPolicyVoteWithdraw);
+    assert(N_storage.policy.max_amount == MAX_AMOUNT);
+}
+
+void test_cap_applies_per_transaction() {
+    install_withdraw_policy();
+
+    // every transaction within the cap is signed, however many there are
+    for (size_t i = 0; i < 3; i++) {
+        assert(sign_withdraw_unattended(MAX_AMOUNT) == ApduReplySuccess);
+    }
+    assert(sign_withdraw_unattended(MAX_AMOUNT + 1) == ApduReplySdkNotSupported);
+}
+
+void test_cleared_policy_signs_nothing() {
+    install_withdraw_policy();
+    assert(sign_withdraw_unattended(1) == ApduReplySuccess);
+
+    assert(set_signing_policy(P1_NON_CONFIRM, SigningPolicyNone, 0) == ApduReplySuccess);
+    assert(sign_withdraw_unattended(1) == ApduReplySdkNotSupported);
+}
+
+int main() {
+    test_review_shows_cap_per_transaction();
+    test_policy_installed_only_once_approved();
+    test_cap_applies_per_transaction();
+    test_cleared_policy_signs_nothing();
+
+    printf("passed\n");
+    return 0;
+}
@@ -0,0 +1,266 @@
+#include "apdu.h"
+#include "utils.h"
+#include "handle_sign_message_batch.h"
+#include "lib_standard_app/crypto_helpers.h"
+#include "util.h"
+#include <assert.h>
+#include <stdio.h>
+
+ApduCommand G_command;
+
+#define MAX_APDU_DATA    255
+#define MAX_TRANSACTION  200
+#define DERIVATION_DEPTH 3
+
+static const uint32_t DERIVATION_PATH[DERIVATION_DEPTH] = {0x8000002c, 0x800001f5, 0x80000000};
+static const uint32_t OTHER_DERIVATION_PATH[DERIVATION_DEPTH] = {0x8000002c,
+                                                                 0x800001f5,
+                                                                 0x80000001};
+
+typedef struct Transaction {
+    uint8_t data[MAX_TRANSACTION];
+    size_t length;
+} Transaction;
+
+// A system transfer of lamports from the key of DERIVATION_PATH, which also
+// pays the fees
+static void make_transfer(Transaction *transaction, uint64_t lamports) {
+    uint8_t *out = transaction->data;
+    size_t length = 0;
+    // header: 1 signer, no read-only signer, 1 read-only account
+    out[length++] = 1;
+    out[length++] = 0;
+    out[length++] = 1;
+    // signer, recipient and the system program
+    out[length++] = 3;
+    get_public_key(out + length, DERIVATION_PATH, DERIVATION_DEPTH);
+    length += PUBKEY_LENGTH;
+    memset(out + length, 0x22, PUBKEY_LENGTH);
+    length += PUBKEY_LENGTH;
+    memset(out + length, 0, PUBKEY_LENGTH);
+    length += PUBKEY_LENGTH;
+    // blockhash
+    memset(out + length, 0x33, HASH_LENGTH);
+    length += HASH_LENGTH;
+    // transfer(lamports), from account 0 to account 1
+    out[length++] = 1;
+    out[length++] = 2;
+    out[length++] = 2;
+    out[length++] = 0;
+    out[length++] = 1;
+    out[length++] = 12;
+    const uint8_t transfer[] = {2, 0, 0, 0};
+    memcpy(out + length, transfer, sizeof(transfer));
+    length += sizeof(transfer);
+    for (size_t i = 0; i < sizeof(uint64_t); i++) {
+        out[length++] = lamports >> (8 * i);
+    }
+    transaction->length = length;
+}
+
+// Send transaction in one SIGN MESSAGE BATCH APDU, returns the status word
+// the handler throws, or 0 when it leaves the reply to the review
+static unsigned int send_transaction(uint8_t p1,
+                                     uint8_t p2,
+                                     const uint32_t *derivation_path,
+                                     const Transaction *transaction,
+                                     volatile unsigned int *tx) {
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA] = {CLA, InsSignMessageBatch, p1, p2};
+    size_t data_length = 0;
+    uint8_t *data = apdu + OFFSET_CDATA;
+    data[data_length++] = 1;
+    data[data_length++] = DERIVATION_DEPTH;
+    for (size_t i = 0; i < DERIVATION_DEPTH; i++) {
+        data[data_length++] = derivation_path[i] >> 24;
+        data[data_length++] = derivation_path[i] >> 16;
+        data[data_length++] = derivation_path[i] >> 8;
+        data[data_length++] = derivation_path[i];
+    }
+    memcpy(data + data_length, transaction->data, transaction->length);
+    data_length += transaction->length;
+    apdu[OFFSET_LC] = data_length;
+    assert(apdu_handle_message(apdu, OFFSET_CDATA + data_length, &G_command) == 0);
+
+    jmp_buf catch;
+    volatile unsigned int flags = 0;
+    sdk_stub_catch = &catch;
+    const int code = setjmp(catch);
+    if (code == 0) {
+        handle_sign_message_batch(&flags, tx);
+        assert(flags & IO_ASYNCH_REPLY);
+    }
+    sdk_stub_catch = NULL;
+    return code;
+}
+
+static unsigned int queue(uint8_t p1, const Transaction *transaction) {
+    volatile unsigned int tx = 0;
+    const unsigned int sw = send_transaction(p1, 0, DERIVATION_PATH, transaction, &tx);
+    assert(tx == 0);
+    return sw;
+}
+
+// Second pass over transaction, its signature in signature on success
+static unsigned int sign(const uint32_t *derivation_path,
+                         const Transaction *transaction,
+                         uint8_t signature[static SIGNATURE_LENGTH]) {
+    volatile unsigned int tx = 0;
+    const unsigned int sw =
+        send_transaction(P1_CONFIRM, P2_SECOND_PASS, derivation_path, transaction, &tx);
+    if (sw == ApduReplySuccess) {
+        assert(tx == SIGNATURE_LENGTH);
+        memcpy(signature, G_io_apdu_buffer, SIGNATURE_LENGTH);
+    }
+    return sw;
+}
+
+static void approve(void) {
+    jmp_buf catch;
+    sdk_stub_catch = &catch;
+    const int code = setjmp(catch);
+    if (code == 0) {
+        assert(set_result_sign_message_batch() == 0);
+    }
+    sdk_stub_catch = NULL;
+    assert(code == 0);
+}
+
+static void assert_signature(const Transaction *transaction,
+                             const uint8_t signature[static SIGNATURE_LENGTH]) {
+    cx_ecfp_private_key_t private_key;
+    uint8_t expected[SIGNATURE_LENGTH];
+    assert(bip32_derive_with_seed_init_privkey_256(HDW_ED25519_SLIP10,
+                                                   CX_CURVE_Ed25519,
+                                                   DERIVATION_PATH,
+                                                   DERIVATION_DEPTH,
+                                                   &private_key,
+                                                   NULL,
+                                                   NULL,
+                                                   0) == CX_OK);
+    assert(cx_eddsa_sign_no_throw(&private_key,
+                                  CX_SHA512,
+                                  transaction->data,
+                                  transaction->length,
+                                  expected,
+                                  sizeof(expected)) == CX_OK);
+    assert(memcmp(signature, expected, SIGNATURE_LENGTH) == 0);
+}
+
+// Queue then review transactions, the last one opening the review
+static void queue_and_approve(const Transaction *transactions, size_t num_transactions) {
+    sign_message_batch_reset();
+    for (size_t i = 0; i + 1 < num_transactions; i++) {
+        assert(queue(P1_NON_CONFIRM, &transactions[i]) == ApduReplySuccess);
+    }
+    const unsigned int reviews = sdk_stub_reviews;
+    assert(queue(P1_CONFIRM, &transactions[num_transactions - 1]) == 0);
+    assert(sdk_stub_reviews == reviews + 1);
+    approve();
+}
+
+void test_batch_review_then_sign() {
+    Transaction transactions[3];
+    for (size_t i = 0; i < ARRAY_LEN(transactions); i++) {
+        make_transfer(&transactions[i], 1000 * (i + 1));
+    }
+    queue_and_approve(transactions, ARRAY_LEN(transactions));
+
+    char title[32];
+    char text[64];
+    get_sign_message_batch_page(0, title, sizeof(title), text, sizeof(text));
+    assert_string_equal(title, "Sign batch");
+    assert_string_equal(text, "3 transactions");
+    get_sign_message_batch_page(1, title, sizeof(title), text, sizeof(text));
+    assert_string_equal(title, "Tx 1/3: Transfer");
+    assert_string_equal(text, "0.000001 SOL");
+    const size_t last_page = get_sign_message_batch_page_count() - 1;
+    get_sign_message_batch_page(last_page, title, sizeof(title), text, sizeof(text));
+    assert(strncmp(title, "Tx 3/3: ", 8) == 0);
+
+    uint8_t signature[SIGNATURE_LENGTH];
+    for (size_t i = 0; i < ARRAY_LEN(transactions); i++) {
+        assert(sign(DERIVATION_PATH, &transactions[i], signature) == ApduReplySuccess);
+        assert_signature(&transactions[i], signature);
+    }
+
+    // all signed, the batch is gone
+    assert(sign(DERIVATION_PATH, &transactions[0], signature) == ApduReplySdkInvalidState);
+}
+
+void test_batch_sign_before_approval() {
+    Transaction transaction;
+    make_transfer(&transaction, 1000);
+    sign_message_batch_reset();
+    uint8_t signature[SIGNATURE_LENGTH];
+
+    assert(queue(P1_NON_CONFIRM, &transaction) == ApduReplySuccess);
+    assert(sign(DERIVATION_PATH, &transaction, signature) == ApduReplySdkInvalidState);
+
+    // nor once the review started, until it is approved
+    assert(queue(P1_CONFIRM, &transaction) == 0);
+    assert(sign(DERIVATION_PATH, &transaction, signature) == ApduReplySdkInvalidState);
+}
+
+void test_batch_sign_mismatch() {
+    Transaction transactions[2];
+    make_transfer(&transactions[0], 1000);
+    make_transfer(&transactions[1], 2000);
+    uint8_t signature[SIGNATURE_LENGTH];
+
+    // not the next reviewed transaction
+    queue_and_approve(transactions, ARRAY_LEN(transactions));
+    assert(sign(DERIVATION_PATH, &transactions[1], signature) == ApduReplySolanaInvalidMessage);
+    // which drops the batch
+    assert(sign(DERIVATION_PATH, &transactions[0], signature) == ApduReplySdkInvalidState);
+
+    // the reviewed transaction, for another signer
+    queue_and_approve(transactions, ARRAY_LEN(transactions));
+    assert(sign(OTHER_DERIVATION_PATH, &transactions[0], signature) ==
+           ApduReplySolanaInvalidMessage);
+    assert(sign(DERIVATION_PATH, &transactions[0], signature) == ApduReplySdkInvalidState);
+}
+
+void test_batch_too_many_transactions() {
+    Transaction transaction;
+    make_transfer(&transaction, 1000);
+    sign_message_batch_reset();
+
+    for (size_t i = 0; i < MAX_BATCH_TRANSACTIONS; i++) {
+        assert(queue(P1_NON_CONFIRM, &transaction) == ApduReplySuccess);
+    }
+    assert(queue(P1_NON_CONFIRM, &transaction) == ApduReplySdkNotEnoughSpace);
+
+    // the batch is dropped, the next transaction starts another one
+    assert(queue(P1_CONFIRM, &transaction) == 0);
+    char title[32];
+    char text[64];
+    get_sign_message_batch_page(0, title, sizeof(title), text, sizeof(text));
+    assert_string_equal(text, "1 transactions");
+}
+
+void test_batch_interrupted() {
+    Transaction transaction;
+    make_transfer(&transaction, 1000);
+    uint8_t signature[SIGNATURE_LENGTH];
+
+    // commands of the batch itself keep it
+    queue_and_approve(&transaction, 1);
+    reset_interrupted_commands(InsSignMessageBatch);
+    assert(sign(DERIVATION_PATH, &transaction, signature) == ApduReplySuccess);
+
+    // any other one drops it
+    queue_and_approve(&transaction, 1);
+    reset_interrupted_commands(InsGetPubkey);
+    assert(sign(DERIVATION_PATH, &transaction, signature) == ApduReplySdkInvalidState);
+}
+
+int main() {
+    test_batch_review_then_sign();
+    test_batch_sign_before_approval();
+    test_batch_sign_mismatch();
+    test_batch_too_many_transactions();
+    test_batch_interrupted();
+
+    printf("passed\n");
+    return 0;
+}
@@ -0,0 +1,206 @@
+#include "apdu.h"
+#include "utils.h"
+#include "handle_sign_offchain_message_stream.h"
+#include "lib_standard_app/crypto_helpers.h"
+#include <assert.h>
+#include <stdio.h>
+
+ApduCommand G_command;
+
+#define MAX_APDU_DATA 255
+#define CHUNK_LENGTH  200
+// Longer than G_command.message, which is what streaming is for
+#define TEXT_LENGTH   3000
+
+#define SIGNING_DOMAIN \
+    "\xff"           \
+    "solana offchain"
+
+static const uint32_t DERIVATION_PATH[] = {0x8000002c, 0x800001f5, 0x80000000};
+#define DERIVATION_PATH_LENGTH (sizeof(DERIVATION_PATH) / sizeof(DERIVATION_PATH[0]))
+
+static uint8_t G_message[OFFCHAIN_MESSAGE_HEADER_LENGTH + TEXT_LENGTH];
+
+static void set_blind_sign(uint8_t value) {
+    nvm_write((void *) &N_storage.settings.allow_blind_sign, &value, sizeof(value));
+}
+
+// Header then text_length bytes of text, returns the message length
+static size_t make_message(size_t text_length, uint8_t seed) {
+    memcpy(G_message, SIGNING_DOMAIN, strlen(SIGNING_DOMAIN));
+    uint8_t *header = G_message + strlen(SIGNING_DOMAIN);
+    header[0] = 0;  // version
+    header[1] = 0;  // restricted ASCII
+    header[2] = text_length & 0xff;
+    header[3] = text_length >> 8;
+    for (size_t i = 0; i < text_length; i++) {
+        G_message[OFFCHAIN_MESSAGE_HEADER_LENGTH + i] = 'a' + (i + seed) % 26;
+    }
+    return OFFCHAIN_MESSAGE_HEADER_LENGTH + text_length;
+}
+
+// Run one APDU of the stream, returns the status word the handler throws,
+// or 0 when it leaves the reply to the review
+static unsigned int send_chunk(uint8_t p2, const uint8_t *data, size_t data_length) {
+    uint8_t apdu[OFFSET_CDATA + MAX_APDU_DATA] = {CLA,
+                                                  InsSignOffchainMessageStream,
+                                                  P1_CONFIRM,
+                                                  p2,
+                                                  data_length};
+    memcpy(apdu + OFFSET_CDATA, data, data_length);
+    assert(apdu_handle_message(apdu, OFFSET_CDATA + data_length, &G_command) == 0);
+
+    jmp_buf catch;
+    volatile unsigned int flags = 0;
+    volatile unsigned int tx = 0;
+    sdk_stub_catch = &catch;
+    const int code = setjmp(catch);
+    if (code == 0) {
+        handle_sign_offchain_message_stream(&flags, &tx);
+        assert(flags & IO_ASYNCH_REPLY);
+    }
+    sdk_stub_catch = NULL;
+    return code;
+}
+
+// One pass over message, the first chunk of the first pass carrying the signer
+static unsigned int send_pass(bool second_pass, const uint8_t *message, size_t length) {
+    uint8_t data[MAX_APDU_DATA];
+    size_t offset = 0;
+    bool first_chunk = true;
+    while (true) {
+        size_t data_length = 0;
+        if (first_chunk && !second_pass) {
+            data[data_length++] = 1;
+            data[data_length++] = DERIVATION_PATH_LENGTH;
+            for (size_t i = 0; i < DERIVATION_PATH_LENGTH; i++) {
+                data[data_length++] = DERIVATION_PATH[i] >> 24;
+                data[data_length++] = DERIVATION_PATH[i] >> 16;
+                data[data_length++] = DERIVATION_PATH[i] >> 8;
+                data[data_length++] = DERIVATION_PATH[i];
+            }
+        }
+        const size_t remaining = length - offset;
+        const size_t take = remaining < CHUNK_LENGTH ? remaining : CHUNK_LENGTH;
+        memcpy(data + data_length, message + offset, take);
+        data_length += take;
+        offset += take;
+
+        uint8_t p2 = second_pass ? P2_SECOND_PASS : 0;
+        if (!first_chunk) {
+            p2 |= P2_EXTEND;
+        }
+        if (offset < length) {
+            p2 |= P2_MORE;
+        }
+        const unsigned int sw = send_chunk(p2, data, data_length);
+        if (offset == length || sw != ApduReplySuccess) {
+            return sw;
+        }
+        first_chunk = false;
+    }
+}
+
+static void expected_signature(const uint8_t *message,
+                               size_t length,
+                               uint8_t signature[static SIGNATURE_LENGTH]) {
+    cx_ecfp_private_key_t private_key;
+    assert(bip32_derive_with_seed_init_privkey_256(HDW_ED25519_SLIP10,
+                                                   CX_CURVE_Ed25519,
+                                                   DERIVATION_PATH,
+                                                   DERIVATION_PATH_LENGTH,
+                                                   &private_key,
+                                                   NULL,
+                                                   NULL,
+                                                   0) == CX_OK);
+    assert(cx_eddsa_sign_no_throw(&private_key,
+                                  CX_SHA512,
+                                  message,
+                                  length,
+                                  signature,
+                                  SIGNATURE_LENGTH) == CX_OK);
+}
+
+void test_streamed_signature_matches_one_shot() {
+    set_blind_sign(BlindSignEnabled);
+    const size_t length = make_message(TEXT_LENGTH, 0);
+    const unsigned int reviews = sdk_stub_reviews;
+
+    assert(send_pass(false, G_message, length) == ApduReplySuccess);
+    assert(sdk_stub_reviews == reviews);
+    assert(send_pass(true, G_message, length) == 0);
+    assert(sdk_stub_reviews == reviews + 1);
+
+    uint8_t expected[SIGNATURE_LENGTH];
+    expected_signature(G_message, length, expected);
+    memset(G_io_apdu_buffer, 0, SIGNATURE_LENGTH);
+    assert(set_result_sign_offchain_message_stream() == SIGNATURE_LENGTH);
+    assert(memcmp(G_io_apdu_buffer, expected, SIGNATURE_LENGTH) == 0);
+}
+
+void test_rejected_signature_is_wiped() {
+    set_blind_sign(BlindSignEnabled);
+    const size_t length = make_message(TEXT_LENGTH, 0);
+    assert(send_pass(false, G_message, length) == ApduReplySuccess);
+    assert(send_pass(true, G_message, length) == 0);
+
+    const uint8_t zeros[SIGNATURE_LENGTH] = {0};
+    assert(memcmp(sign_offchain_message_stream_signature(), zeros, SIGNATURE_LENGTH) != 0);
+    reset_rejected_command(G_command.instruction);
+    assert(memcmp(sign_offchain_message_stream_signature(), zeros, SIGNATURE_LENGTH) == 0);
+
+    // nothing is left to sign
+    jmp_buf catch;
+    sdk_stub_catch = &catch;
+    const int code = setjmp(catch);
+    if (code == 0) {
+        set_result_sign_offchain_message_stream();
+    }
+    sdk_stub_catch = NULL;
+    assert(code == ApduReplySdkInvalidState);
+}
+
+void test_second_pass_over_other_message() {
+    set_blind_sign(BlindSignEnabled);
+    const size_t length = make_message(TEXT_LENGTH, 0);
+    assert(send_pass(false, G_message, length) == ApduReplySuccess);
+
+    make_message(TEXT_LENGTH, 1);
+    const unsigned int reviews = sdk_stub_reviews;
+    assert(send_pass(true, G_message, length) == ApduReplySolanaInvalidMessage);
+    assert(sdk_stub_reviews == reviews);
+
+    // the stream is gone, nothing is left to sign
+    jmp_buf catch;
+    sdk_stub_catch = &catch;
+    const int code = setjmp(catch);
+    if (code == 0) {
+        set_result_sign_offchain_message_stream();
+    }
+    sdk_stub_catch = NULL;
+    assert(code == ApduReplySdkInvalidState);
+}
+
+void test_second_pass_without_first() {
+    set_blind_sign(BlindSignEnabled);
+    sign_offchain_message_stream_reset();
+    const size_t length = make_message(100, 0);
+    assert(send_pass(true, G_message, length) == ApduReplySolanaInvalidMessage);
+}
+
+void test_blind_signing_required() {
+    set_blind_sign(BlindSignDisabled);
+    const size_t length = make_message(100, 0);
+    assert(send_pass(false, G_message, length) == ApduReplySdkNotSupported);
+}
+
+int main() {
+    test_streamed_signature_matches_one_shot();
+    test_rejected_signature_is_wiped();
+    test_second_pass_over_other_message();
+    test_second_pass_without_first();
+    test_blind_signing_required();
+
+    printf("passed\n");
+    return 0;
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "os.h"
+
+typedef uint32_t cx_err_t;
+
+#define CX_OK             0x00000000
+#define CX_INVALID_PARAMETER 0xFFFFFF84
+
+#define CX_LAST (1 << 0)
+
+#define CX_SHA256_SIZE 32
+#define CX_SHA512      5
+#define CX_SHA512_SIZE 64
+
+typedef enum cx_curve_e { CX_CURVE_256K1 = 0x21, CX_CURVE_Ed25519 = 0x71 } cx_curve_t;
+
+typedef struct cx_hash_s {
+    uint32_t algorithm;
+} cx_hash_t;
+
+// Host SHA-256, see sdk.c
+typedef struct cx_sha256_s {
+    cx_hash_t header;
+    uint64_t length;
+    uint32_t state[8];
+    uint8_t block[64];
+    size_t block_length;
+} cx_sha256_t;
+
+cx_err_t cx_sha256_init_no_throw(cx_sha256_t *hash);
+
+// Host SHA-512, see sdk.c
+typedef struct cx_sha512_s {
+    cx_hash_t header;
+    uint64_t length;
+    uint64_t state[8];
+    uint8_t block[128];
+    size_t block_length;
+} cx_sha512_t;
+
+cx_err_t cx_sha512_init_no_throw(cx_sha512_t *hash);
+
+cx_err_t cx_hash_no_throw(cx_hash_t *hash,
+                          uint32_t mode,
+                          const uint8_t *in,
+                          size_t len,
+                          uint8_t *out,
+                          size_t out_len);
+
+// Private keys hold the Ed25519 seed of their path, see sdk.c
+typedef struct cx_ecfp_256_private_key_s {
+    cx_curve_t curve;
+    size_t d_len;
+    uint8_t d[32];
+} cx_ecfp_256_private_key_t;
+typedef cx_ecfp_256_private_key_t cx_ecfp_private_key_t;
+
+cx_err_t cx_eddsa_sign_no_throw(const cx_ecfp_private_key_t *pvkey,
+                                uint32_t hashID,
+                                const uint8_t *hash,
+                                size_t hash_len,
+                                uint8_t *sig,
+                                size_t sig_len);
+
+size_t cx_hash_sha256(const uint8_t *in, size_t len, uint8_t *out, size_t out_len);
+
+// Host modular arithmetic and Ed25519, see ecc.c
+cx_err_t cx_math_modm_no_throw(uint8_t *v, size_t len_v, const uint8_t *m, size_t len_m);
+
+cx_err_t cx_math_multm_no_throw(uint8_t *r,
+                                const uint8_t *a,
+                                const uint8_t *b,
+                                const uint8_t *m,
+                                size_t len);
+
+cx_err_t cx_math_addm_no_throw(uint8_t *r,
+                               const uint8_t *a,
+                               const uint8_t *b,
+                               const uint8_t *m,
+                               size_t len);
+
+cx_err_t cx_ecfp_scalar_mult_no_throw(cx_curve_t curve, uint8_t *P, const uint8_t *k, size_t k_len);
+
+// Host ECDSA verification over secp256k1, see ecc.c
+typedef struct cx_ecfp_256_public_key_s {
+    cx_curve_t curve;
+    size_t W_len;
+    uint8_t W[65];
+} cx_ecfp_256_public_key_t;
+typedef cx_ecfp_256_public_key_t cx_ecfp_public_key_t;
+
+cx_err_t cx_ecfp_init_public_key_no_throw(cx_curve_t curve,
+                                          const uint8_t *rawkey,
+                                          size_t key_len,
+                                          cx_ecfp_public_key_t *key);
+
+bool cx_ecdsa_verify_no_throw(const cx_ecfp_public_key_t *pukey,
+                              const uint8_t *hash,
+                              size_t hash_len,
+                              const uint8_t *sig,
+                              size_t sig_len);
@@ -0,0 +1,659 @@
+#include <stdio.h>
+
+#include "os.h"
+#include "cx.h"
+
+// Host elliptic curve arithmetic for the handlers under test: slow, not
+// constant time, only meant to be obviously correct
+
+//
+// 256-bit integers, little endian 64-bit limbs
+//
+
+typedef struct bn_s {
+    uint64_t v[4];
+} bn_t;
+
+// Big endian, at most 8 bytes per limb
+static void limbs_read(uint64_t *limbs, size_t num_limbs, const uint8_t *in, size_t len) {
+    memset(limbs, 0, num_limbs * sizeof(uint64_t));
+    for (size_t i = 0; i < len; i++) {
+        const size_t bit = 8 * (len - 1 - i);
+        limbs[bit / 64] |= (uint64_t) in[i] << (bit % 64);
+    }
+}
+
+static void bn_read(bn_t *r, const uint8_t *in, size_t len) {
+    limbs_read(r->v, 4, in, len);
+}
+
+// Big endian, zero padded to len bytes
+static void bn_write(uint8_t *out, size_t len, const bn_t *a) {
+    for (size_t i = 0; i < len; i++) {
+        const size_t bit = 8 * (len - 1 - i);
+        out[i] = bit < 256 ? (uint8_t) (a->v[bit / 64] >> (bit % 64)) : 0;
+    }
+}
+
+// Little endian, as Ed25519 encodes integers
+static void bn_read_le(bn_t *r, const uint8_t in[32]) {
+    uint8_t be[32];
+    for (size_t i = 0; i < 32; i++) {
+        be[i] = in[31 - i];
+    }
+    bn_read(r, be, sizeof(be));
+}
+
+static void bn_write_le(uint8_t out[32], const bn_t *a) {
+    uint8_t be[32];
+    bn_write(be, sizeof(be), a);
+    for (size_t i = 0; i < 32; i++) {
+        out[i] = be[31 - i];
+    }
+}
+
+static int bn_cmp(const bn_t *a, const bn_t *b) {
+    for (int i = 3; i >= 0; i--) {
+        if (a->v[i] != b->v[i]) {
+            return a->v[i] < b->v[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+static bool bn_is_zero(const bn_t *a) {
+    return (a->v[0] | a->v[1] | a->v[2] | a->v[3]) == 0;
+}
+
+static bool bn_bit(const bn_t *a, size_t bit) {
+    return (a->v[bit / 64] >> (bit % 64)) & 1;
+}
+
+static uint64_t bn_add(bn_t *r, const bn_t *a, const bn_t *b) {
+    unsigned __int128 carry = 0;
+    for (size_t i = 0; i < 4; i++) {
+        carry += (unsigned __int128) a->v[i] + b->v[i];
+        r->v[i] = (uint64_t) carry;
+        carry >>= 64;
+    }
+    return (uint64_t) carry;
+}
+
+static uint64_t bn_sub(bn_t *r, const bn_t *a, const bn_t *b) {
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < 4; i++) {
+        const uint64_t ai = a->v[i];
+        const uint64_t d = ai - b->v[i] - borrow;
+        borrow = (ai < b->v[i]) || (ai - b->v[i] < borrow);
+        r->v[i] = d;
+    }
+    return borrow;
+}
+
+// Reduce a little endian array of limbs modulo m, one bit at a time
+static void bn_reduce(bn_t *r, const uint64_t *limbs, size_t num_limbs, const bn_t *m) {
+    bn_t acc = {{0}};
+    for (size_t bit = 64 * num_limbs; bit-- > 0;) {
+        const uint64_t top = acc.v[3] >> 63;
+        for (size_t i = 3; i > 0; i--) {
+            acc.v[i] = (acc.v[i] << 1) | (acc.v[i - 1] >> 63);
+        }
+        acc.v[0] = (acc.v[0] << 1) | ((limbs[bit / 64] >> (bit % 64)) & 1);
+        if (top || bn_cmp(&acc, m) >= 0) {
+            bn_sub(&acc, &acc, m);
+        }
+    }
+    *r = acc;
+}
+
+static void bn_mod(bn_t *r, const bn_t *a, const bn_t *m) {
+    bn_reduce(r, a->v, 4, m);
+}
+
+static void bn_addm(bn_t *r, const bn_t *a, const bn_t *b, const bn_t *m) {
+    const uint64_t carry = bn_add(r, a, b);
+    if (carry || bn_cmp(r, m) >= 0) {
+        bn_sub(r, r, m);
+    }
+}
+
+static void bn_subm(bn_t *r, const bn_t *a, const bn_t *b, const bn_t *m) {
+    if (bn_sub(r, a, b)) {
+        bn_add(r, r, m);
+    }
+}
+
+static void bn_mulm(bn_t *r, const bn_t *a, const bn_t *b, const bn_t *m) {
+    uint64_t wide[8] = {0};
+    for (size_t i = 0; i < 4; i++) {
+        unsigned __int128 carry = 0;
+        for (size_t j = 0; j < 4; j++) {
+            carry += (unsigned __int128) a->v[i] * b->v[j] + wide[i + j];
+            wide[i + j] = (uint64_t) carry;
+            carry >>= 64;
+        }
+        wide[i + 4] = (uint64_t) carry;
+    }
+    bn_reduce(r, wide, 8, m);
+}
+
+// Modulo a prime, by Fermat's little theorem
+static void bn_invm(bn_t *r, const bn_t *a, const bn_t *m) {
+    bn_t exponent = {{2}};
+    bn_sub(&exponent, m, &exponent);
+    bn_t result = {{1}};
+    for (size_t bit = 256; bit-- > 0;) {
+        bn_mulm(&result, &result, &result, m);
+        if (bn_bit(&exponent, bit)) {
+            bn_mulm(&result, &result, a, m);
+        }
+    }
+    *r = result;
+}
+
+static void bn_set_hex(bn_t *r, const char *hex) {
+    uint8_t bytes[32];
+    for (size_t i = 0; i < 32; i++) {
+        unsigned int byte;
+        sscanf(hex + 2 * i, "%2x", &byte);
+        bytes[i] = (uint8_t) byte;
+    }
+    bn_read(r, bytes, sizeof(bytes));
+}
+
+//
+// secp256k1 (SEC 2), Jacobian coordinates, Z = 0 at infinity
+//
+
+typedef struct secp256k1_point_s {
+    bn_t x, y, z;
+} secp256k1_point_t;
+
+typedef struct secp256k1_s {
+    bn_t p, n;
+    secp256k1_point_t g;
+} secp256k1_t;
+
+static void secp256k1_init(secp256k1_t *curve) {
+    bn_set_hex(&curve->p, "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f");
+    bn_set_hex(&curve->n, "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141");
+    bn_set_hex(&curve->g.x, "79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798");
+    bn_set_hex(&curve->g.y, "483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8");
+    curve->g.z = (bn_t){{1}};
+}
+
+static void secp256k1_double(const secp256k1_t *curve,
+                             secp256k1_point_t *r,
+                             const secp256k1_point_t *a) {
+    const bn_t *p = &curve->p;
+    if (bn_is_zero(&a->z) || bn_is_zero(&a->y)) {
+        memset(r, 0, sizeof(*r));
+        return;
+    }
+    // dbl-2009-l
+    bn_t aa, b, c, d, e, f, t;
+    bn_mulm(&aa, &a->x, &a->x, p);
+    bn_mulm(&b, &a->y, &a->y, p);
+    bn_mulm(&c, &b, &b, p);
+    bn_addm(&d, &a->x, &b, p);
+    bn_mulm(&d, &d, &d, p);
+    bn_subm(&d, &d, &aa, p);
+    bn_subm(&d, &d, &c, p);
+    bn_addm(&d, &d, &d, p);
+    bn_addm(&e, &aa, &aa, p);
+    bn_addm(&e, &e, &aa, p);
+    bn_mulm(&f, &e, &e, p);
+
+    secp256k1_point_t out;
+    bn_mulm(&out.z, &a->y, &a->z, p);
+    bn_addm(&out.z, &out.z, &out.z, p);
+    bn_subm(&out.x, &f, &d, p);
+    bn_subm(&out.x, &out.x, &d, p);
+    bn_subm(&t, &d, &out.x, p);
+    bn_mulm(&out.y, &e, &t, p);
+    bn_addm(&c, &c, &c, p);
+    bn_addm(&c, &c, &c, p);
+    bn_addm(&c, &c, &c, p);
+    bn_subm(&out.y, &out.y, &c, p);
+    *r = out;
+}
+
+static void secp256k1_add(const secp256k1_t *curve,
+                          secp256k1_point_t *r,
+                          const secp256k1_point_t *a,
+                          const secp256k1_point_t *b) {
+    const bn_t *p = &curve->p;
+    if (bn_is_zero(&a->z)) {
+        *r = *b;
+        return;
+    }
+    if (bn_is_zero(&b->z)) {
+        *r = *a;
+        return;
+    }
+    // add-2007-bl
+    bn_t z1z1, z2z2, u1, u2, s1, s2, h, i, j, rr, v, t;
+    bn_mulm(&z1z1, &a->z, &a->z, p);
+    bn_mulm(&z2z2, &b->z, &b->z, p);
+    bn_mulm(&u1, &a->x, &z2z2, p);
+    bn_mulm(&u2, &b->x, &z1z1, p);
+    bn_mulm(&s1, &a->y, &b->z, p);
+    bn_mulm(&s1, &s1, &z2z2, p);
+    bn_mulm(&s2, &b->y, &a->z, p);
+    bn_mulm(&s2, &s2, &z1z1, p);
+    bn_subm(&h, &u2, &u1, p);
+    bn_subm(&rr, &s2, &s1, p);
+    if (bn_is_zero(&h)) {
+        if (bn_is_zero(&rr)) {
+            secp256k1_double(curve, r, a);
+        } else {
+            memset(r, 0, sizeof(*r));
+        }
+        return;
+    }
+    bn_addm(&i, &h, &h, p);
+    bn_mulm(&i, &i, &i, p);
+    bn_mulm(&j, &h, &i, p);
+    bn_addm(&rr, &rr, &rr, p);
+    bn_mulm(&v, &u1, &i, p);
+
+    secp256k1_point_t out;
+    bn_mulm(&out.x, &rr, &rr, p);
+    bn_subm(&out.x, &out.x, &j, p);
+    bn_subm(&out.x, &out.x, &v, p);
+    bn_subm(&out.x, &out.x, &v, p);
+    bn_subm(&t, &v, &out.x, p);
+    bn_mulm(&out.y, &rr, &t, p);
+    bn_mulm(&t, &s1, &j, p);
+    bn_addm(&t, &t, &t, p);
+    bn_subm(&out.y, &out.y, &t, p);
+    bn_addm(&out.z, &a->z, &b->z, p);
+    bn_mulm(&out.z, &out.z, &out.z, p);
+    bn_subm(&out.z, &out.z, &z1z1, p);
+    bn_subm(&out.z, &out.z, &z2z2, p);
+    bn_mulm(&out.z, &out.z, &h, p);
+    *r = out;
+}
+
+static void secp256k1_mult(const secp256k1_t *curve,
+                           secp256k1_point_t *r,
+                           const secp256k1_point_t *a,
+                           const bn_t *k) {
+    secp256k1_point_t acc;
+    memset(&acc, 0, sizeof(acc));
+    for (size_t bit = 256; bit-- > 0;) {
+        secp256k1_double(curve, &acc, &acc);
+        if (bn_bit(k, bit)) {
+            secp256k1_add(curve, &acc, &acc, a);
+        }
+    }
+    *r = acc;
+}
+
+cx_err_t cx_ecfp_init_public_key_no_throw(cx_curve_t curve,
+                                          const uint8_t *rawkey,
+                                          size_t key_len,
+                                          cx_ecfp_public_key_t *key) {
+    if (curve != CX_CURVE_256K1 || key_len != sizeof(key->W) || rawkey[0] != 0x04) {
+        return CX_INVALID_PARAMETER;
+    }
+    key->curve = curve;
+    key->W_len = key_len;
+    memcpy(key->W, rawkey, key_len);
+    return CX_OK;
+}
+
+// DER INTEGER of at most 32 significant bytes
+static bool read_der_integer(const uint8_t **der, const uint8_t *end, bn_t *value) {
+    if (end - *der < 2 || (*der)[0] != 0x02 || (*der)[1] > end - *der - 2) {
+        return false;
+    }
+    const uint8_t *bytes = *der + 2;
+    size_t len = (*der)[1];
+    *der = bytes + len;
+    while (len > 0 && bytes[0] == 0) {
+        bytes++;
+        len--;
+    }
+    if (len > 32) {
+        return false;
+    }
+    bn_read(value, bytes, len);
+    return true;
+}
+
+bool cx_ecdsa_verify_no_throw(const cx_ecfp_public_key_t *pukey,
+                              const uint8_t *hash,
+                              size_t hash_len,
+                              const uint8_t *sig,
+                              size_t sig_len) {
+    const uint8_t *end = sig + sig_len;
+    if (pukey->curve != CX_CURVE_256K1 || hash_len > 32 || sig_len < 2 || sig[0] != 0x30 ||
+        sig[1] != sig_len - 2) {
+        return false;
+    }
+    const uint8_t *der = sig + 2;
+    bn_t r, s;
+    if (!read_der_integer(&der, end, &r) || !read_der_integer(&der, end, &s) || der != end) {
+        return false;
+    }
+
+    secp256k1_t curve;
+    secp256k1_init(&curve);
+    if (bn_is_zero(&r) || bn_is_zero(&s) || bn_cmp(&r, &curve.n) >= 0 ||
+        bn_cmp(&s, &curve.n) >= 0) {
+        return false;
+    }
+
+    // X = (e / s) G + (r / s) Q, valid when r = X.x mod n
+    bn_t e, w, u1, u2;
+    bn_read(&e, hash, hash_len);
+    bn_mod(&e, &e, &curve.n);
+    bn_invm(&w, &s, &curve.n);
+    bn_mulm(&u1, &e, &w, &curve.n);
+    bn_mulm(&u2, &r, &w, &curve.n);
+
+    secp256k1_point_t q, x, t;
+    bn_read(&q.x, pukey->W + 1, 32);
+    bn_read(&q.y, pukey->W + 33, 32);
+    q.z = (bn_t){{1}};
+    secp256k1_mult(&curve, &x, &curve.g, &u1);
+    secp256k1_mult(&curve, &t, &q, &u2);
+    secp256k1_add(&curve, &x, &x, &t);
+    if (bn_is_zero(&x.z)) {
+        return false;
+    }
+
+    bn_t z_inverse, affine_x;
+    bn_invm(&z_inverse, &x.z, &curve.p);
+    bn_mulm(&z_inverse, &z_inverse, &z_inverse, &curve.p);
+    bn_mulm(&affine_x, &x.x, &z_inverse, &curve.p);
+    bn_mod(&affine_x, &affine_x, &curve.n);
+    return bn_cmp(&affine_x, &r) == 0;
+}
+
+//
+// Modular arithmetic on big endian integers
+//
+
+cx_err_t cx_math_modm_no_throw(uint8_t *v, size_t len_v, const uint8_t *m, size_t len_m) {
+    uint64_t wide[8];
+    bn_t modulus, r;
+    if (len_v > sizeof(wide) || len_m > 32) {
+        return CX_INVALID_PARAMETER;
+    }
+    bn_read(&modulus, m, len_m);
+    if (bn_is_zero(&modulus)) {
+        return CX_INVALID_PARAMETER;
+    }
+    limbs_read(wide, 8, v, len_v);
+    bn_reduce(&r, wide, 8, &modulus);
+    bn_write(v, len_v, &r);
+    return CX_OK;
+}
+
+static cx_err_t read_operands(bn_t *a,
+                              bn_t *b,
+                              bn_t *m,
+                              const uint8_t *in_a,
+                              const uint8_t *in_b,
+                              const uint8_t *in_m,
+                              size_t len) {
+    if (len > 32) {
+        return CX_INVALID_PARAMETER;
+    }
+    bn_read(m, in_m, len);
+    if (bn_is_zero(m)) {
+        return CX_INVALID_PARAMETER;
+    }
+    bn_read(a, in_a, len);
+    bn_read(b, in_b, len);
+    bn_mod(a, a, m);
+    bn_mod(b, b, m);
+    return CX_OK;
+}
+
+cx_err_t cx_math_multm_no_throw(uint8_t *r,
+                                const uint8_t *a,
+                                const uint8_t *b,
+                                const uint8_t *m,
+                                size_t len) {
+    bn_t x, y, modulus;
+    const cx_err_t err = read_operands(&x, &y, &modulus, a, b, m, len);
+    if (err == CX_OK) {
+        bn_mulm(&x, &x, &y, &modulus);
+        bn_write(r, len, &x);
+    }
+    return err;
+}
+
+cx_err_t cx_math_addm_no_throw(uint8_t *r,
+                               const uint8_t *a,
+                               const uint8_t *b,
+                               const uint8_t *m,
+                               size_t len) {
+    bn_t x, y, modulus;
+    const cx_err_t err = read_operands(&x, &y, &modulus, a, b, m, len);
+    if (err == CX_OK) {
+        bn_addm(&x, &x, &y, &modulus);
+        bn_write(r, len, &x);
+    }
+    return err;
+}
+
+//
+// Ed25519 (RFC 8032), extended coordinates
+//
+
+typedef struct ed25519_point_s {
+    bn_t x, y, z, t;
+} ed25519_point_t;
+
+typedef struct ed25519_s {
+    bn_t p, l, d2;
+    ed25519_point_t b;
+} ed25519_t;
+
+static void ed25519_init(ed25519_t *curve) {
+    bn_set_hex(&curve->p, "7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed");
+    bn_set_hex(&curve->l, "1000000000000000000000000000000014def9dea2f79cd65812631a5cf5d3ed");
+    // 2d, d = -121665 / 121666
+    bn_set_hex(&curve->d2, "2406d9dc56dffce7198e80f2eef3d13000e0149a8283b156ebd69b9426b2f159");
+    bn_set_hex(&curve->b.x, "216936d3cd6e53fec0a4e231fdd6dc5c692cc7609525a7b2c9562d608f25d51a");
+    bn_set_hex(&curve->b.y, "6666666666666666666666666666666666666666666666666666666666666658");
+    curve->b.z = (bn_t){{1}};
+    bn_mulm(&curve->b.t, &curve->b.x, &curve->b.y, &curve->p);
+}
+
+// Modulo p = 2^255 - 19, folding the upper half as 2^256 = 38 (mod p)
+static void fe_mul(const ed25519_t *curve, bn_t *r, const bn_t *a, const bn_t *b) {
+    uint64_t wide[8] = {0};
+    for (size_t i = 0; i < 4; i++) {
+        unsigned __int128 carry = 0;
+        for (size_t j = 0; j < 4; j++) {
+            carry += (unsigned __int128) a->v[i] * b->v[j] + wide[i + j];
+            wide[i + j] = (uint64_t) carry;
+            carry >>= 64;
+        }
+        wide[i + 4] = (uint64_t) carry;
+    }
+    unsigned __int128 carry = 0;
+    for (size_t i = 0; i < 4; i++) {
+        carry += (unsigned __int128) wide[i + 4] * 38 + wide[i];
+        r->v[i] = (uint64_t) carry;
+        carry >>= 64;
+    }
+    // then bits from 255 up as 2^255 = 19 (mod p)
+    const uint64_t top = ((uint64_t) carry << 1) | (r->v[3] >> 63);
+    r->v[3] &= 0x7fffffffffffffff;
+    carry = (unsigned __int128) top * 19;
+    for (size_t i = 0; i < 4; i++) {
+        carry += r->v[i];
+        r->v[i] = (uint64_t) carry;
+        carry >>= 64;
+    }
+    while (bn_cmp(r, &curve->p) >= 0) {
+        bn_sub(r, r, &curve->p);
+    }
+}
+
+// add-2008-hwcd-3, complete so it doubles as well
+static void ed25519_add(const ed25519_t *curve,
+                        ed25519_point_t *r,
+                        const ed25519_point_t *p1,
+                        const ed25519_point_t *p2) {
+    const bn_t *p = &curve->p;
+    bn_t a, b, c, d, e, f, g, h, t;
+    bn_subm(&a, &p1->y, &p1->x, p);
+    bn_subm(&t, &p2->y, &p2->x, p);
+    fe_mul(curve, &a, &a, &t);
+    bn_addm(&b, &p1->y, &p1->x, p);
+    bn_addm(&t, &p2->y, &p2->x, p);
+    fe_mul(curve, &b, &b, &t);
+    fe_mul(curve, &c, &p1->t, &p2->t);
+    fe_mul(curve, &c, &c, &curve->d2);
+    fe_mul(curve, &d, &p1->z, &p2->z);
+    bn_addm(&d, &d, &d, p);
+    bn_subm(&e, &b, &a, p);
+    bn_subm(&f, &d, &c, p);
+    bn_addm(&g, &d, &c, p);
+    bn_addm(&h, &b, &a, p);
+    fe_mul(curve, &r->x, &e, &f);
+    fe_mul(curve, &r->y, &g, &h);
+    fe_mul(curve, &r->t, &e, &h);
+    fe_mul(curve, &r->z, &f, &g);
+}
+
+static void ed25519_mult(const ed25519_t *curve,
+                         ed25519_point_t *r,
+                         const ed25519_point_t *a,
+                         const bn_t *k) {
+    ed25519_point_t acc = {.x = {{0}}, .y = {{1}}, .z = {{1}}, .t = {{0}}};
+    for (size_t bit = 256; bit-- > 0;) {
+        ed25519_add(curve, &acc, &acc, &acc);
+        if (bn_bit(k, bit)) {
+            ed25519_add(curve, &acc, &acc, a);
+        }
+    }
+    *r = acc;
+}
+
+static void ed25519_to_affine(const ed25519_t *curve, bn_t *x, bn_t *y, const ed25519_point_t *a) {
+    bn_t z_inverse;
+    bn_invm(&z_inverse, &a->z, &curve->p);
+    fe_mul(curve, x, &a->x, &z_inverse);
+    fe_mul(curve, y, &a->y, &z_inverse);
+}
+
+// y little endian, the parity of x in the top bit
+static void ed25519_encode(const ed25519_t *curve, uint8_t out[32], const ed25519_point_t *a) {
+    bn_t x, y;
+    ed25519_to_affine(curve, &x, &y, a);
+    bn_write_le(out, &y);
+    out[31] |= (uint8_t) ((x.v[0] & 1) << 7);
+}
+
+cx_err_t cx_ecfp_scalar_mult_no_throw(cx_curve_t curve_id,
+                                      uint8_t *P,
+                                      const uint8_t *k,
+                                      size_t k_len) {
+    if (curve_id != CX_CURVE_Ed25519 || P[0] != 0x04 || k_len > 32) {
+        return CX_INVALID_PARAMETER;
+    }
+    ed25519_t curve;
+    ed25519_init(&curve);
+    ed25519_point_t point;
+    bn_read(&point.x, P + 1, 32);
+    bn_read(&point.y, P + 33, 32);
+    point.z = (bn_t){{1}};
+    fe_mul(&curve, &point.t, &point.x, &point.y);
+
+    bn_t scalar;
+    bn_read(&scalar, k, k_len);
+    ed25519_mult(&curve, &point, &point, &scalar);
+    bn_t x, y;
+    ed25519_to_affine(&curve, &x, &y, &point);
+    bn_write(P + 1, 32, &x);
+    bn_write(P + 33, 32, &y);
+    return CX_OK;
+}
+
+// SHA-512 of the concatenated parts, reduced modulo the group order
+static cx_err_t ed25519_hash(const ed25519_t *curve,
+                             bn_t *r,
+                             const uint8_t *part1,
+                             size_t len1,
+                             const uint8_t *part2,
+                             size_t len2,
+                             const uint8_t *part3,
+                             size_t len3) {
+    cx_sha512_t context;
+    uint8_t digest[CX_SHA512_SIZE];
+    cx_err_t err = cx_sha512_init_no_throw(&context);
+    if (err == CX_OK) {
+        err = cx_hash_no_throw(&context.header, 0, part1, len1, NULL, 0);
+    }
+    if (err == CX_OK) {
+        err = cx_hash_no_throw(&context.header, 0, part2, len2, NULL, 0);
+    }
+    if (err == CX_OK) {
+        err = cx_hash_no_throw(&context.header, CX_LAST, part3, len3, digest, sizeof(digest));
+    }
+    if (err == CX_OK) {
+        uint64_t wide[8];
+        for (size_t i = 0; i < 8; i++) {
+            wide[i] = 0;
+            for (size_t j = 0; j < 8; j++) {
+                wide[i] |= (uint64_t) digest[8 * i + j] << (8 * j);
+            }
+        }
+        bn_reduce(r, wide, 8, &curve->l);
+    }
+    return err;
+}
+
+// Straight from RFC 8032 5.1.6, independently of src/ed25519_stream.c
+cx_err_t cx_eddsa_sign_no_throw(const cx_ecfp_private_key_t *pvkey,
+                                uint32_t hashID,
+                                const uint8_t *hash,
+                                size_t hash_len,
+                                uint8_t *sig,
+                                size_t sig_len) {
+    if (pvkey->curve != CX_CURVE_Ed25519 || pvkey->d_len != 32 || hashID != CX_SHA512 ||
+        sig_len < 64) {
+        return CX_INVALID_PARAMETER;
+    }
+    ed25519_t curve;
+    ed25519_init(&curve);
+
+    uint8_t expanded[CX_SHA512_SIZE];
+    cx_sha512_t context;
+    cx_sha512_init_no_throw(&context);
+    cx_hash_no_throw(&context.header, CX_LAST, pvkey->d, 32, expanded, sizeof(expanded));
+    expanded[0] &= 0xf8;
+    expanded[31] &= 0x7f;
+    expanded[31] |= 0x40;
+    bn_t a;
+    bn_read_le(&a, expanded);
+
+    ed25519_point_t point;
+    uint8_t public_key[32];
+    ed25519_mult(&curve, &point, &curve.b, &a);
+    ed25519_encode(&curve, public_key, &point);
+
+    bn_t r, k, s;
+    if (ed25519_hash(&curve, &r, expanded + 32, 32, hash, hash_len, NULL, 0) != CX_OK) {
+        return CX_INVALID_PARAMETER;
+    }
+    ed25519_mult(&curve, &point, &curve.b, &r);
+    ed25519_encode(&curve, sig, &point);
+    if (ed25519_hash(&curve, &k, sig, 32, public_key, 32, hash, hash_len) != CX_OK) {
+        return CX_INVALID_PARAMETER;
+    }
+    bn_mod(&a, &a, &curve.l);
+    bn_mulm(&s, &k, &a, &curve.l);
+    bn_addm(&s, &s, &r, &curve.l);
+    bn_write_le(sig + 32, &s);
+    explicit_bzero(expanded, sizeof(expanded));
+    return CX_OK;
+}
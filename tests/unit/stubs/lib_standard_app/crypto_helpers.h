@@ -0,0 +1,43 @@
+#pragma once
+
+#include "cx.h"
+
+// Number of public key derivations so far, to observe caching
+extern unsigned int sdk_stub_derivations;
+// Number of private key derivations so far, signing included
+extern unsigned int sdk_stub_private_derivations;
+
+#define HDW_ED25519_SLIP10 2
+
+// Deterministic derivation of Ed25519 keys, from the SHA-256 of the path
+// rather than SLIP-10 (see sdk.c)
+cx_err_t bip32_derive_with_seed_get_pubkey_256(unsigned int derivation_mode,
+                                               cx_curve_t curve,
+                                               const uint32_t *path,
+                                               size_t path_len,
+                                               uint8_t raw_pubkey[static 65],
+                                               uint8_t *chain_code,
+                                               uint32_t hashID,
+                                               unsigned char *seed,
+                                               size_t seed_len);
+
+cx_err_t bip32_derive_with_seed_init_privkey_256(unsigned int derivation_mode,
+                                                  cx_curve_t curve,
+                                                  const uint32_t *path,
+                                                  size_t path_len,
+                                                  cx_ecfp_256_private_key_t *privkey,
+                                                  uint8_t *chain_code,
+                                                  unsigned char *seed,
+                                                  size_t seed_len);
+
+cx_err_t bip32_derive_with_seed_eddsa_sign_hash_256(unsigned int derivation_mode,
+                                                    cx_curve_t curve,
+                                                    const uint32_t *path,
+                                                    size_t path_len,
+                                                    uint32_t hashID,
+                                                    const uint8_t *hash,
+                                                    size_t hash_len,
+                                                    uint8_t *sig,
+                                                    size_t *sig_len,
+                                                    unsigned char *seed,
+                                                    size_t seed_len);
@@ -0,0 +1,38 @@
+#pragma once
+
+// Minimal stand-ins for the BOLOS SDK, just enough to build the app's
+// transport code (src/apdu.c, src/utils.c) and simple handlers on the host
+
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define USB_SEGMENT_SIZE 64
+// As in the SDK, see CUSTOM_IO_APDU_BUFFER_SIZE in the Makefile
+#ifdef CUSTOM_IO_APDU_BUFFER_SIZE
+#define IO_APDU_BUFFER_SIZE CUSTOM_IO_APDU_BUFFER_SIZE
+#else
+#define IO_APDU_BUFFER_SIZE (5 + 255)
+#endif
+
+#define PIC(x) (x)
+#define U2BE(buf, off) ((((buf)[off] & 0xFF) << 8) | ((buf)[off + 1] & 0xFF))
+#define U4BE(buf, off) (((uint32_t) U2BE(buf, off) << 16) | U2BE(buf, (off) + 2))
+#define PRINTF(...)
+
+// The transport code returns status words rather than throwing. Handlers do
+// throw, including on success: tests calling them point sdk_stub_catch at a
+// jmp_buf that receives the status word. Anything else reaching here is a
+// test failure.
+#define THROW(code) sdk_stub_throw(code)
+void sdk_stub_throw(unsigned int code) __attribute__((noreturn));
+extern jmp_buf *sdk_stub_catch;
+
+extern uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+
+// Flash writes, plain copies on the host
+void nvm_write(void *dst_adr, void *src_adr, unsigned int src_len);
+
+void os_sched_exit(int exit_code) __attribute__((noreturn));
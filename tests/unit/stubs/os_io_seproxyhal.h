@@ -0,0 +1,5 @@
+#pragma once
+
+#include "os.h"
+
+#define IO_ASYNCH_REPLY 0x10
@@ -0,0 +1,457 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "os.h"
+#include "cx.h"
+#include "lib_standard_app/crypto_helpers.h"
+#include "globals.h"
+
+#define CX_SHA256 3
+
+uint8_t G_io_apdu_buffer[IO_APDU_BUFFER_SIZE];
+jmp_buf *sdk_stub_catch;
+unsigned int sdk_stub_derivations;
+unsigned int sdk_stub_private_derivations;
+
+void os_sched_exit(int exit_code) {
+    fprintf(stderr, "unexpected os_sched_exit(%d)\n", exit_code);
+    abort();
+}
+
+void sdk_stub_throw(unsigned int code) {
+    if (sdk_stub_catch != NULL) {
+        longjmp(*sdk_stub_catch, (int) code);
+    }
+    fprintf(stderr, "unexpected THROW(0x%x)\n", code);
+    abort();
+}
+
+//
+// Storage, in flash on the device. Writable here, tests change settings
+// through nvm_write() as the app does.
+//
+
+__attribute__((section(".data.n_storage"))) const internalStorage_t N_storage_real;
+
+void nvm_write(void *dst_adr, void *src_adr, unsigned int src_len) {
+    memmove(dst_adr, src_adr, src_len);
+}
+
+//
+// App UI. Reviews only start, tests approve them by calling the handler's
+// set_result function.
+//
+
+unsigned int sdk_stub_reviews;
+
+void ui_get_public_key(void) {
+    abort();
+}
+
+void start_sign_tx_ui(size_t num_summary_steps) {
+    sdk_stub_reviews++;
+}
+
+void start_sign_offchain_message_ui(bool is_ascii, size_t num_summary_steps) {
+    sdk_stub_reviews++;
+}
+
+void start_sign_batch_ui(size_t num_pages) {
+    sdk_stub_reviews++;
+}
+
+void start_set_signing_policy_ui(size_t num_summary_steps) {
+    sdk_stub_reviews++;
+}
+
+//
+// Swap, never called from the Exchange app here
+//
+
+volatile bool G_called_from_swap;
+volatile bool G_swap_response_ready;
+
+bool check_swap_amount(const char *title, const char *text) {
+    abort();
+}
+
+bool check_swap_recipient(const char *title, const char *text) {
+    abort();
+}
+
+void sendResponse(uint8_t tx, uint16_t sw, bool display_menu) {
+    abort();
+}
+
+//
+// SHA-256 (FIPS 180-4)
+//
+
+static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+    0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+    0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+    0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+    0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+    0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+    0xc67178f2};
+
+static uint32_t rotr(uint32_t x, unsigned int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+static void sha256_compress(uint32_t state[8], const uint8_t block[64]) {
+    uint32_t w[64];
+    for (size_t i = 0; i < 16; i++) {
+        w[i] = ((uint32_t) block[4 * i] << 24) | ((uint32_t) block[4 * i + 1] << 16) |
+               ((uint32_t) block[4 * i + 2] << 8) | block[4 * i + 3];
+    }
+    for (size_t i = 16; i < 64; i++) {
+        const uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        const uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (size_t i = 0; i < 64; i++) {
+        const uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        const uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        const uint32_t t1 = h + s1 + ((e & f) ^ (~e & g)) + SHA256_K[i] + w[i];
+        const uint32_t t2 = s0 + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+cx_err_t cx_sha256_init_no_throw(cx_sha256_t *hash) {
+    static const uint32_t iv[8] = {0x6a09e667,
+                                   0xbb67ae85,
+                                   0x3c6ef372,
+                                   0xa54ff53a,
+                                   0x510e527f,
+                                   0x9b05688c,
+                                   0x1f83d9ab,
+                                   0x5be0cd19};
+    memset(hash, 0, sizeof(*hash));
+    hash->header.algorithm = CX_SHA256;
+    memcpy(hash->state, iv, sizeof(iv));
+    return CX_OK;
+}
+
+static void sha256_update(cx_sha256_t *hash, const uint8_t *in, size_t len) {
+    hash->length += len;
+    while (len > 0) {
+        const size_t take = sizeof(hash->block) - hash->block_length < len
+                                ? sizeof(hash->block) - hash->block_length
+                                : len;
+        memcpy(hash->block + hash->block_length, in, take);
+        hash->block_length += take;
+        in += take;
+        len -= take;
+        if (hash->block_length == sizeof(hash->block)) {
+            sha256_compress(hash->state, hash->block);
+            hash->block_length = 0;
+        }
+    }
+}
+
+static void sha256_final(cx_sha256_t *hash, uint8_t *out) {
+    const uint64_t bits = hash->length * 8;
+    const uint8_t pad = 0x80;
+    const uint8_t zero = 0;
+    sha256_update(hash, &pad, 1);
+    while (hash->block_length != 56) {
+        sha256_update(hash, &zero, 1);
+    }
+    for (int i = 7; i >= 0; i--) {
+        const uint8_t byte = (uint8_t) (bits >> (8 * i));
+        sha256_update(hash, &byte, 1);
+    }
+    for (size_t i = 0; i < 8; i++) {
+        out[4 * i] = hash->state[i] >> 24;
+        out[4 * i + 1] = hash->state[i] >> 16;
+        out[4 * i + 2] = hash->state[i] >> 8;
+        out[4 * i + 3] = hash->state[i];
+    }
+}
+
+//
+// SHA-512 (FIPS 180-4)
+//
+
+static const uint64_t SHA512_K[80] = {
+    0x428a2f98d728ae22, 0x7137449123ef65cd, 0xb5c0fbcfec4d3b2f, 0xe9b5dba58189dbbc,
+    0x3956c25bf348b538, 0x59f111f1b605d019, 0x923f82a4af194f9b, 0xab1c5ed5da6d8118,
+    0xd807aa98a3030242, 0x12835b0145706fbe, 0x243185be4ee4b28c, 0x550c7dc3d5ffb4e2,
+    0x72be5d74f27b896f, 0x80deb1fe3b1696b1, 0x9bdc06a725c71235, 0xc19bf174cf692694,
+    0xe49b69c19ef14ad2, 0xefbe4786384f25e3, 0x0fc19dc68b8cd5b5, 0x240ca1cc77ac9c65,
+    0x2de92c6f592b0275, 0x4a7484aa6ea6e483, 0x5cb0a9dcbd41fbd4, 0x76f988da831153b5,
+    0x983e5152ee66dfab, 0xa831c66d2db43210, 0xb00327c898fb213f, 0xbf597fc7beef0ee4,
+    0xc6e00bf33da88fc2, 0xd5a79147930aa725, 0x06ca6351e003826f, 0x142929670a0e6e70,
+    0x27b70a8546d22ffc, 0x2e1b21385c26c926, 0x4d2c6dfc5ac42aed, 0x53380d139d95b3df,
+    0x650a73548baf63de, 0x766a0abb3c77b2a8, 0x81c2c92e47edaee6, 0x92722c851482353b,
+    0xa2bfe8a14cf10364, 0xa81a664bbc423001, 0xc24b8b70d0f89791, 0xc76c51a30654be30,
+    0xd192e819d6ef5218, 0xd69906245565a910, 0xf40e35855771202a, 0x106aa07032bbd1b8,
+    0x19a4c116b8d2d0c8, 0x1e376c085141ab53, 0x2748774cdf8eeb99, 0x34b0bcb5e19b48a8,
+    0x391c0cb3c5c95a63, 0x4ed8aa4ae3418acb, 0x5b9cca4f7763e373, 0x682e6ff3d6b2b8a3,
+    0x748f82ee5defb2fc, 0x78a5636f43172f60, 0x84c87814a1f0ab72, 0x8cc702081a6439ec,
+    0x90befffa23631e28, 0xa4506cebde82bde9, 0xbef9a3f7b2c67915, 0xc67178f2e372532b,
+    0xca273eceea26619c, 0xd186b8c721c0c207, 0xeada7dd6cde0eb1e, 0xf57d4f7fee6ed178,
+    0x06f067aa72176fba, 0x0a637dc5a2c898a6, 0x113f9804bef90dae, 0x1b710b35131c471b,
+    0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc, 0x431d67c49c100d4c,
+    0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817};
+
+static uint64_t rotr64(uint64_t x, unsigned int n) {
+    return (x >> n) | (x << (64 - n));
+}
+
+static void sha512_compress(uint64_t state[8], const uint8_t block[128]) {
+    uint64_t w[80];
+    for (size_t i = 0; i < 16; i++) {
+        w[i] = 0;
+        for (size_t j = 0; j < 8; j++) {
+            w[i] = (w[i] << 8) | block[8 * i + j];
+        }
+    }
+    for (size_t i = 16; i < 80; i++) {
+        const uint64_t s0 = rotr64(w[i - 15], 1) ^ rotr64(w[i - 15], 8) ^ (w[i - 15] >> 7);
+        const uint64_t s1 = rotr64(w[i - 2], 19) ^ rotr64(w[i - 2], 61) ^ (w[i - 2] >> 6);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint64_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint64_t e = state[4], f = state[5], g = state[6], h = state[7];
+    for (size_t i = 0; i < 80; i++) {
+        const uint64_t t1 = h + (rotr64(e, 14) ^ rotr64(e, 18) ^ rotr64(e, 41)) +
+                            ((e & f) ^ (~e & g)) + SHA512_K[i] + w[i];
+        const uint64_t t2 =
+            (rotr64(a, 28) ^ rotr64(a, 34) ^ rotr64(a, 39)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+cx_err_t cx_sha512_init_no_throw(cx_sha512_t *hash) {
+    static const uint64_t iv[8] = {0x6a09e667f3bcc908,
+                                   0xbb67ae8584caa73b,
+                                   0x3c6ef372fe94f82b,
+                                   0xa54ff53a5f1d36f1,
+                                   0x510e527fade682d1,
+                                   0x9b05688c2b3e6c1f,
+                                   0x1f83d9abfb41bd6b,
+                                   0x5be0cd19137e2179};
+    memset(hash, 0, sizeof(*hash));
+    hash->header.algorithm = CX_SHA512;
+    memcpy(hash->state, iv, sizeof(iv));
+    return CX_OK;
+}
+
+static void sha512_update(cx_sha512_t *hash, const uint8_t *in, size_t len) {
+    hash->length += len;
+    while (len > 0) {
+        const size_t take = sizeof(hash->block) - hash->block_length < len
+                                ? sizeof(hash->block) - hash->block_length
+                                : len;
+        memcpy(hash->block + hash->block_length, in, take);
+        hash->block_length += take;
+        in += take;
+        len -= take;
+        if (hash->block_length == sizeof(hash->block)) {
+            sha512_compress(hash->state, hash->block);
+            hash->block_length = 0;
+        }
+    }
+}
+
+static void sha512_final(cx_sha512_t *hash, uint8_t *out) {
+    // messages stay far below 2^61 bytes, the upper half of the length is 0
+    const uint64_t bits = hash->length * 8;
+    const uint8_t pad = 0x80;
+    const uint8_t zero = 0;
+    sha512_update(hash, &pad, 1);
+    while (hash->block_length != 120) {
+        sha512_update(hash, &zero, 1);
+    }
+    for (int i = 7; i >= 0; i--) {
+        const uint8_t byte = (uint8_t) (bits >> (8 * i));
+        sha512_update(hash, &byte, 1);
+    }
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t j = 0; j < 8; j++) {
+            out[8 * i + j] = (uint8_t) (hash->state[i] >> (56 - 8 * j));
+        }
+    }
+}
+
+cx_err_t cx_hash_no_throw(cx_hash_t *hash,
+                          uint32_t mode,
+                          const uint8_t *in,
+                          size_t len,
+                          uint8_t *out,
+                          size_t out_len) {
+    if (hash == NULL || (len > 0 && in == NULL)) {
+        return CX_INVALID_PARAMETER;
+    }
+    if (hash->algorithm == CX_SHA256) {
+        cx_sha256_t *sha256 = (cx_sha256_t *) hash;
+        sha256_update(sha256, in, len);
+        if (mode & CX_LAST) {
+            if (out == NULL || out_len < CX_SHA256_SIZE) {
+                return CX_INVALID_PARAMETER;
+            }
+            sha256_final(sha256, out);
+        }
+        return CX_OK;
+    }
+    if (hash->algorithm == CX_SHA512) {
+        cx_sha512_t *sha512 = (cx_sha512_t *) hash;
+        sha512_update(sha512, in, len);
+        if (mode & CX_LAST) {
+            if (out == NULL || out_len < CX_SHA512_SIZE) {
+                return CX_INVALID_PARAMETER;
+            }
+            sha512_final(sha512, out);
+        }
+        return CX_OK;
+    }
+    return CX_INVALID_PARAMETER;
+}
+
+size_t cx_hash_sha256(const uint8_t *in, size_t len, uint8_t *out, size_t out_len) {
+    cx_sha256_t hash;
+    cx_sha256_init_no_throw(&hash);
+    if (cx_hash_no_throw(&hash.header, CX_LAST, in, len, out, out_len) != CX_OK) {
+        return 0;
+    }
+    return CX_SHA256_SIZE;
+}
+
+//
+// Derivation
+//
+
+// Ed25519 base point, uncompressed big endian coordinates
+static const uint8_t ED25519_BASE_POINT[65] = {
+    0x04, 0x21, 0x69, 0x36, 0xd3, 0xcd, 0x6e, 0x53, 0xfe, 0xc0, 0xa4, 0xe2, 0x31,
+    0xfd, 0xd6, 0xdc, 0x5c, 0x69, 0x2c, 0xc7, 0x60, 0x95, 0x25, 0xa7, 0xb2, 0xc9,
+    0x56, 0x2d, 0x60, 0x8f, 0x25, 0xd5, 0x1a, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
+    0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x58};
+
+// Not SLIP-10, the seed of a path is its SHA-256. Keys are real Ed25519 keys
+// of that seed, so signatures verify.
+static void seed_of_path(const uint32_t *path, size_t path_len, uint8_t seed[CX_SHA256_SIZE]) {
+    cx_hash_sha256((const uint8_t *) path, path_len * sizeof(uint32_t), seed, CX_SHA256_SIZE);
+}
+
+cx_err_t bip32_derive_with_seed_get_pubkey_256(unsigned int derivation_mode,
+                                               cx_curve_t curve,
+                                               const uint32_t *path,
+                                               size_t path_len,
+                                               uint8_t raw_pubkey[static 65],
+                                               uint8_t *chain_code,
+                                               uint32_t hashID,
+                                               unsigned char *seed,
+                                               size_t seed_len) {
+    uint8_t private_seed[CX_SHA256_SIZE];
+    uint8_t expanded[CX_SHA512_SIZE];
+    uint8_t scalar[32];
+    sdk_stub_derivations++;
+    seed_of_path(path, path_len, private_seed);
+
+    // A = aB, a the clamped first half of SHA-512(seed)
+    cx_sha512_t context;
+    cx_sha512_init_no_throw(&context);
+    cx_hash_no_throw(&context.header,
+                     CX_LAST,
+                     private_seed,
+                     sizeof(private_seed),
+                     expanded,
+                     sizeof(expanded));
+    expanded[0] &= 0xf8;
+    expanded[31] &= 0x7f;
+    expanded[31] |= 0x40;
+    for (size_t i = 0; i < sizeof(scalar); i++) {
+        scalar[i] = expanded[sizeof(scalar) - 1 - i];
+    }
+    memcpy(raw_pubkey, ED25519_BASE_POINT, sizeof(ED25519_BASE_POINT));
+    return cx_ecfp_scalar_mult_no_throw(CX_CURVE_Ed25519, raw_pubkey, scalar, sizeof(scalar));
+}
+
+cx_err_t bip32_derive_with_seed_init_privkey_256(unsigned int derivation_mode,
+                                                  cx_curve_t curve,
+                                                  const uint32_t *path,
+                                                  size_t path_len,
+                                                  cx_ecfp_256_private_key_t *privkey,
+                                                  uint8_t *chain_code,
+                                                  unsigned char *seed,
+                                                  size_t seed_len) {
+    sdk_stub_private_derivations++;
+    privkey->curve = curve;
+    privkey->d_len = sizeof(privkey->d);
+    seed_of_path(path, path_len, privkey->d);
+    return CX_OK;
+}
+
+cx_err_t bip32_derive_with_seed_eddsa_sign_hash_256(unsigned int derivation_mode,
+                                                    cx_curve_t curve,
+                                                    const uint32_t *path,
+                                                    size_t path_len,
+                                                    uint32_t hashID,
+                                                    const uint8_t *hash,
+                                                    size_t hash_len,
+                                                    uint8_t *sig,
+                                                    size_t *sig_len,
+                                                    unsigned char *seed,
+                                                    size_t seed_len) {
+    // Derive then sign, as the SDK does
+    cx_ecfp_256_private_key_t privkey;
+    cx_err_t err = bip32_derive_with_seed_init_privkey_256(derivation_mode,
+                                                          curve,
+                                                          path,
+                                                          path_len,
+                                                          &privkey,
+                                                          NULL,
+                                                          seed,
+                                                          seed_len);
+    if (err == CX_OK) {
+        err = cx_eddsa_sign_no_throw(&privkey, hashID, hash, hash_len, sig, *sig_len);
+    }
+    explicit_bzero(&privkey, sizeof(privkey));
+    if (err == CX_OK) {
+        *sig_len = 64;
+    }
+    return err;
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "os.h"
+
+// Number of reviews started so far
+extern unsigned int sdk_stub_reviews;
@@ -0,0 +1,112 @@
+#include "apdu.h"
+#include "utils.h"
+#include "lib_standard_app/crypto_helpers.h"
+#include "sol/pubkey_cache.h"
+#include <assert.h>
+#include <stdio.h>
+
+ApduCommand G_command;
+
+void test_get_public_key_derives_once() {
+    const uint32_t path[] = {0x8000002c, 0x800001f5, 0x80000000};
+    const uint32_t other_path[] = {0x8000002c, 0x800001f5, 0x80000001};
+    uint8_t first[PUBKEY_LENGTH], second[PUBKEY_LENGTH], other[PUBKEY_LENGTH];
+    pubkey_cache_reset();
+
+    const unsigned int derivations = sdk_stub_derivations;
+    get_public_key(first, path, ARRAY_COUNT(path));
+    assert(sdk_stub_derivations == derivations + 1);
+    get_public_key(second, path, ARRAY_COUNT(path));
+    assert(sdk_stub_derivations == derivations + 1);
+    assert(memcmp(first, second, PUBKEY_LENGTH) == 0);
+
+    get_public_key(other, other_path, ARRAY_COUNT(other_path));
+    assert(sdk_stub_derivations == derivations + 2);
+    assert(memcmp(first, other, PUBKEY_LENGTH) != 0);
+
+    // a reset session derives again, to the same key
+    pubkey_cache_reset();
+    get_public_key(second, path, ARRAY_COUNT(path));
+    assert(sdk_stub_derivations == derivations + 3);
+    assert(memcmp(first, second, PUBKEY_LENGTH) == 0);
+}
+
+void test_derive_signer_pubkeys() {
+    const uint8_t first_chunk[] = {CLA, InsSignMessage, P1_CONFIRM, P2_MORE, 16,
+                                   2,   2,   0x80, 0, 0, 44, 0x80, 0, 0x01, 0xf5,
+                                   1,   0x80, 0, 0, 44,  0xaa};
+    pubkey_cache_reset();
+
+    assert(apdu_handle_message(first_chunk, sizeof(first_chunk), &G_command) == 0);
+    assert(G_command.state == ApduStatePayloadInProgress);
+    assert(!G_command.signer_pubkeys_derived);
+
+    const unsigned int derivations = sdk_stub_derivations;
+    assert(derive_signer_pubkeys(&G_command));
+    assert(G_command.signer_pubkeys_derived);
+    assert(sdk_stub_derivations == derivations + 2);
+    for (size_t i = 0; i < 2; i++) {
+        uint8_t expected[PUBKEY_LENGTH];
+        get_public_key(expected,
+                       G_command.derivation_paths[i],
+                       G_command.derivation_path_lengths[i]);
+        assert(memcmp(G_command.signer_pubkeys[i].data, expected, PUBKEY_LENGTH) == 0);
+    }
+
+    // the keys follow the chunks of their command, and go with a restart
+    const uint8_t next_chunk[] = {CLA, InsSignMessage, P1_CONFIRM, P2_EXTEND | P2_MORE, 1, 0xbb};
+    assert(apdu_handle_message(next_chunk, sizeof(next_chunk), &G_command) == 0);
+    assert(G_command.signer_pubkeys_derived);
+    assert(apdu_handle_message(first_chunk, sizeof(first_chunk), &G_command) == 0);
+    assert(!G_command.signer_pubkeys_derived);
+}
+
+void test_staged_signer_keys() {
+    const uint8_t apdu[] = {CLA, InsSignMessage, P1_CONFIRM, 0,    16,   2,    2,
+                            0x80, 0,    0,    44,   0x80, 0,    0x01, 0xf5, 1,
+                            0x80, 0,    0,    44,   0xaa};
+    uint8_t signatures[2 * SIGNATURE_LENGTH];
+    assert(apdu_handle_message(apdu, sizeof(apdu), &G_command) == 0);
+    assert(G_command.state == ApduStatePayloadComplete);
+
+    unsigned int derivations = sdk_stub_private_derivations;
+    assert(set_result_sign_message() == sizeof(signatures));
+    assert(sdk_stub_private_derivations == derivations + 2);
+    memcpy(signatures, G_io_apdu_buffer, sizeof(signatures));
+
+    // nothing is staged unless a review asked for it
+    derivations = sdk_stub_private_derivations;
+    stage_signer_keys();
+    assert(sdk_stub_private_derivations == derivations);
+
+    // staged keys sign without deriving, to the same signatures
+    stage_signer_keys_later();
+    stage_signer_keys();
+    assert(sdk_stub_private_derivations == derivations + 2);
+    memset(G_io_apdu_buffer, 0, sizeof(signatures));
+    assert(set_result_sign_message() == sizeof(signatures));
+    assert(sdk_stub_private_derivations == derivations + 2);
+    assert(memcmp(signatures, G_io_apdu_buffer, sizeof(signatures)) == 0);
+
+    // they are only used once
+    assert(set_result_sign_message() == sizeof(signatures));
+    assert(sdk_stub_private_derivations == derivations + 4);
+
+    // and wiped ones are derived again
+    stage_signer_keys_later();
+    stage_signer_keys();
+    wipe_staged_signer_keys();
+    derivations = sdk_stub_private_derivations;
+    assert(set_result_sign_message() == sizeof(signatures));
+    assert(sdk_stub_private_derivations == derivations + 2);
+    assert(memcmp(signatures, G_io_apdu_buffer, sizeof(signatures)) == 0);
+}
+
+int main() {
+    test_get_public_key_derives_once();
+    test_derive_signer_pubkeys();
+    test_staged_signer_keys();
+
+    printf("passed\n");
+    return 0;
+}
@@ -0,0 +1,48 @@
+#!/usr/bin/env bash
+#
+# Cost model of libsol on the device: instructions per message of each
+# message_bench phase, counted under qemu-arm user mode, then code size per
+# function. Run from libsol/ through `make target=arm mode=release profile`.
+#
+# Instructions are counted by the qemu `insn` plugin when QEMU_PLUGIN points
+# to it, otherwise from an execution log of one instruction per block, which
+# is much slower. Counts are exact and only depend on the binary and corpus.
+
+set -euo pipefail
+
+declare -r bench="${1:?'missing required arg 1: `message_bench`'}"
+declare -r lib="${2:?'missing required arg 2: `libsol.a`'}"
+declare -r qemu="${QEMU:?'QEMU is not set, build with target=arm'}"
+declare -r nm="${NM:-nm}"
+declare -r phases=(load parse process finalize display)
+
+count_instructions() {
+  local -r phase="${1:?}"
+  if [[ -n "${QEMU_PLUGIN:-}" ]]; then
+    "$qemu" -plugin "$QEMU_PLUGIN,inline=on" -d plugin -D /dev/stderr \
+      "$bench" -c "$phase" 2>&1 >/dev/null | awk '/insns:/ { n = $NF } END { print n }'
+  else
+    "$qemu" -one-insn-per-tb -d exec,nochain -D /dev/stderr \
+      "$bench" -c "$phase" 2>&1 >/dev/null | grep -c '^Trace'
+  fi
+}
+
+messages="$("$qemu" "$bench" -c load | awk '{ print $1 }')"
+echo "==> Instructions per message, $messages messages"
+previous=
+for phase in "${phases[@]}"; do
+  count="$(count_instructions "$phase")"
+  if [[ -n "$previous" ]]; then
+    printf '%-10s %10d\n' "$phase" $(( (count - previous) / messages ))
+  fi
+  previous="$count"
+done
+
+# message_generator and token_index are host-only, the app leaves them out
+echo "==> Code size per function, in bytes"
+"$nm" --size-sort -S -t d "$lib" | awk '
+  /\.o:$/ { object = substr($1, 1, length($1) - 1); next }
+  object ~ /^(message_generator|token_index)\.o$/ { next }
+  NF == 4 && $3 ~ /^[Tt]$/ { printf "%8d %-50s %s\n", $2, $4, object; total += $2 }
+  END { printf "%8d total\n", total }
+' | sort -rn
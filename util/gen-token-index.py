@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""Build the memory-mapped token index read by libsol's token_index.c.
+
+Input lines are '<base58 mint> <symbol> [decimals]', '#' starts a comment, so
+libsol/token_registry.txt is a valid input. Mints are sorted by their bytes
+and written in Eytzinger order (the breadth-first layout of the balanced
+binary search tree over the sorted list), which keeps the first levels of
+every search in the same few cache lines.
+
+Output layout, all integers little endian:
+
+    magic "SOLTKIDX" | u32 version | u32 record count
+    count * (mint[32] | symbol[10], NUL padded | u8 decimals | reserved[5])
+"""
+
+import argparse
+import struct
+import sys
+from pathlib import Path
+
+MAGIC = b"SOLTKIDX"
+VERSION = 1
+MAX_SYMBOL_LENGTH = 9  # TokenIndexRecord.symbol is char[10]
+RECORD = struct.Struct("<32s10sB5x")
+
+BASE58_ALPHABET = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz"
+BASE58_VALUES = {char: value for value, char in enumerate(BASE58_ALPHABET)}
+
+
+def b58decode(text: str) -> bytes:
+    value = 0
+    for char in text:
+        if char not in BASE58_VALUES:
+            raise ValueError(f"invalid base58 character {char!r} in {text}")
+        value = value * 58 + BASE58_VALUES[char]
+    leading_zeros = len(text) - len(text.lstrip("1"))
+    body = value.to_bytes((value.bit_length() + 7) // 8, "big") if value else b""
+    return b"\x00" * leading_zeros + body
+
+
+def read_tokens(path: Path):
+    tokens = {}
+    with path.open() as source:
+        for line_number, raw_line in enumerate(source, 1):
+            line = raw_line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            fields = line.split()
+            if len(fields) not in (2, 3):
+                sys.exit(f"{path}:{line_number}: expected '<mint> <symbol> [decimals]'")
+            address, symbol = fields[0], fields[1]
+            try:
+                mint = b58decode(address)
+                decimals = int(fields[2]) if len(fields) == 3 else 0
+            except ValueError as error:
+                sys.exit(f"{path}:{line_number}: {error}")
+            if len(mint) != 32:
+                sys.exit(f"{path}:{line_number}: {address} is not a 32-byte address")
+            if not 0 < len(symbol) <= MAX_SYMBOL_LENGTH or not symbol.isascii():
+                sys.exit(f"{path}:{line_number}: symbol {symbol!r} is not ASCII of 1 to "
+                         f"{MAX_SYMBOL_LENGTH} characters")
+            if not 0 <= decimals <= 0xFF:
+                sys.exit(f"{path}:{line_number}: decimals {decimals} out of range")
+            if mint in tokens:
+                sys.exit(f"{path}:{line_number}: duplicate mint {address}")
+            tokens[mint] = (symbol.encode(), decimals)
+    return tokens
+
+
+def eytzinger_order(sorted_items):
+    """Return sorted_items permuted into Eytzinger (1-based BFS) order."""
+    count = len(sorted_items)
+    layout = [None] * count
+    position = 0
+    # Iterative in-order walk of the implicit tree, node k has children 2k, 2k+1
+    stack = []
+    k = 1
+    while stack or k <= count:
+        while k <= count:
+            stack.append(k)
+            k *= 2
+        k = stack.pop()
+        layout[k - 1] = sorted_items[position]
+        position += 1
+        k = 2 * k + 1
+    return layout
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("tokens", type=Path, help="token list, one '<mint> <symbol> [decimals]'")
+    parser.add_argument("output", type=Path, help="index file to write")
+    args = parser.parse_args()
+
+    tokens = read_tokens(args.tokens)
+    if len(tokens) > 0xFFFFFFFF:
+        sys.exit("too many tokens for a u32 record count")
+
+    layout = eytzinger_order(sorted(tokens.items()))
+    with args.output.open("wb") as output:
+        output.write(MAGIC + struct.pack("<II", VERSION, len(layout)))
+        for mint, (symbol, decimals) in layout:
+            output.write(RECORD.pack(mint, symbol, decimals))
+
+
+if __name__ == "__main__":
+    main()
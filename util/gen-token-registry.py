@@ -0,0 +1,201 @@
+#!/usr/bin/env python3
+"""Generate libsol's TOKEN_REGISTRY lookup tables from a source list.
+
+The registry is laid out as a minimal perfect hash keyed on the first four
+bytes of the mint address (CHD, "compress, hash and displace"):
+
+    prefix = little endian u32 of mint[0..4]
+    bucket = (prefix * HASH_M1) >> (32 - BUCKET_BITS)
+    x      = (prefix ^ (DISPLACEMENTS[bucket] * HASH_D)) * HASH_M2
+    slot   = (x * LENGTH) >> 32
+
+TOKEN_REGISTRY[slot] is then confirmed with a single full-key compare. The
+search below is fully deterministic (fixed constants, buckets placed in a
+stable order, smallest displacement wins), so the same list always produces
+byte-identical output. Generation fails loudly if two mints share a prefix or
+no collision-free layout is found, rather than emitting a table that could
+return the wrong symbol.
+
+TOKEN_REGISTRY_FILE_ORDER lists the slots in the order of the source list,
+which is the order of the registry mints in the key dictionary of compressed
+transactions. That order is part of the transfer encoding, so the list is
+only ever appended to.
+"""
+
+import argparse
+import sys
+from pathlib import Path
+
+HASH_M1 = 0x9E3779B1
+HASH_M2 = 0x85EBCA6B
+HASH_D = 0xC2B2AE35
+MASK32 = 0xFFFFFFFF
+
+MAX_SYMBOL_LENGTH = 9  # TokenInfo.symbol is char[10]
+MAX_DISPLACEMENT = 0xFF  # displacements are stored as uint8_t
+MAX_LENGTH = 0x100  # TOKEN_REGISTRY_FILE_ORDER entries are uint8_t
+
+BASE58_ALPHABET = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz"
+
+GENERATED_NOTICE = "// Generated by util/gen-token-registry.py from token_registry.txt, do not edit.\n"
+
+
+def b58decode(text: str) -> bytes:
+    value = 0
+    for char in text:
+        index = BASE58_ALPHABET.find(char)
+        if index < 0:
+            raise ValueError(f"invalid base58 character {char!r} in {text}")
+        value = value * 58 + index
+    leading_zeros = len(text) - len(text.lstrip("1"))
+    body = value.to_bytes((value.bit_length() + 7) // 8, "big") if value else b""
+    return b"\x00" * leading_zeros + body
+
+
+def read_registry(path: Path):
+    entries = []
+    for line_number, raw_line in enumerate(path.read_text().splitlines(), 1):
+        line = raw_line.split("#", 1)[0].strip()
+        if not line:
+            continue
+        fields = line.split()
+        if len(fields) != 2:
+            sys.exit(f"{path}:{line_number}: expected '<mint> <symbol>'")
+        address, symbol = fields
+        mint = b58decode(address)
+        if len(mint) != 32:
+            sys.exit(f"{path}:{line_number}: {address} is not a 32-byte address")
+        if len(symbol) > MAX_SYMBOL_LENGTH or not symbol.isascii():
+            sys.exit(f"{path}:{line_number}: symbol {symbol!r} is not ASCII of at most "
+                     f"{MAX_SYMBOL_LENGTH} characters")
+        entries.append((address, mint, symbol))
+    return entries
+
+
+def prefix_of(mint: bytes) -> int:
+    return int.from_bytes(mint[:4], "little")
+
+
+def bucket_of(prefix: int, bucket_bits: int) -> int:
+    return ((prefix * HASH_M1) & MASK32) >> (32 - bucket_bits)
+
+
+def slot_of(prefix: int, displacement: int, length: int) -> int:
+    x = ((prefix ^ ((displacement * HASH_D) & MASK32)) * HASH_M2) & MASK32
+    return (x * length) >> 32
+
+
+def build_layout(prefixes, bucket_bits):
+    length = len(prefixes)
+    buckets = [[] for _ in range(1 << bucket_bits)]
+    for index, prefix in enumerate(prefixes):
+        buckets[bucket_of(prefix, bucket_bits)].append(index)
+
+    displacements = [0] * len(buckets)
+    slots = [None] * length
+    # Largest buckets first, ties broken by bucket number for determinism
+    order = sorted(range(len(buckets)), key=lambda b: (-len(buckets[b]), b))
+    for bucket in order:
+        members = buckets[bucket]
+        if not members:
+            continue
+        for displacement in range(MAX_DISPLACEMENT + 1):
+            candidate = [slot_of(prefixes[i], displacement, length) for i in members]
+            if len(set(candidate)) == len(candidate) and \
+                    all(slots[slot] is None for slot in candidate):
+                for slot, index in zip(candidate, members):
+                    slots[slot] = index
+                displacements[bucket] = displacement
+                break
+        else:
+            return None
+    return displacements, slots
+
+
+def format_bytes(data: bytes, indent: str) -> str:
+    hex_bytes = [f"0x{b:02x}" for b in data]
+    lines = [", ".join(hex_bytes[i:i + 11]) for i in range(0, len(hex_bytes), 11)]
+    return (",\n" + indent).join(lines)
+
+
+def render_header(length, bucket_bits):
+    return f"""{GENERATED_NOTICE}#pragma once
+
+#define TOKEN_REGISTRY_LENGTH      {length}
+#define TOKEN_REGISTRY_BUCKET_BITS {bucket_bits}
+#define TOKEN_REGISTRY_HASH_M1     0x{HASH_M1:08x}u
+#define TOKEN_REGISTRY_HASH_M2     0x{HASH_M2:08x}u
+#define TOKEN_REGISTRY_HASH_D      0x{HASH_D:08x}u
+"""
+
+
+def render_source(entries, displacements, slots):
+    out = [GENERATED_NOTICE, '#include "token_info.h"\n', '#include "token_registry.h"\n', "\n"]
+    out.append("const uint8_t TOKEN_REGISTRY_DISPLACEMENTS[1 << TOKEN_REGISTRY_BUCKET_BITS] = {\n")
+    out.append("    " + format_bytes(bytes(displacements), "    ") + "};\n\n")
+    out.append("const TokenInfo TOKEN_REGISTRY[TOKEN_REGISTRY_LENGTH] = {\n")
+    rendered = []
+    for index in slots:
+        address, mint, symbol = entries[index]
+        rendered.append(f"    // {address}\n"
+                        f"    {{{{{{{format_bytes(mint, '       ')}}}}},\n"
+                        f"     \"{symbol}\"}}")
+    out.append(",\n\n".join(rendered))
+    out.append("};\n\n")
+    file_order = [0] * len(slots)
+    for slot, index in enumerate(slots):
+        file_order[index] = slot
+    out.append("const uint8_t TOKEN_REGISTRY_FILE_ORDER[TOKEN_REGISTRY_LENGTH] = {\n")
+    out.append("    " + format_bytes(bytes(file_order), "    ") + "};\n")
+    return "".join(out)
+
+
+def generate(entries):
+    prefixes = [prefix_of(mint) for _, mint, _ in entries]
+    if len(set(prefixes)) != len(prefixes):
+        seen = {}
+        for (address, _, _), prefix in zip(entries, prefixes):
+            if prefix in seen:
+                sys.exit(f"{address} and {seen[prefix]} share a 4-byte prefix")
+            seen[prefix] = address
+    if not entries:
+        sys.exit("token registry is empty")
+    if len(entries) > MAX_LENGTH:
+        sys.exit(f"token registry holds more than {MAX_LENGTH} tokens")
+
+    # Average bucket size of about 4 keeps the displacement table small
+    bucket_bits = max(1, (len(entries) // 4).bit_length())
+    while bucket_bits <= 16:
+        layout = build_layout(prefixes, bucket_bits)
+        if layout is not None:
+            displacements, slots = layout
+            return render_header(len(entries), bucket_bits), \
+                render_source(entries, displacements, slots)
+        bucket_bits += 1
+    sys.exit("no collision-free layout found")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("registry", type=Path, help="token_registry.txt")
+    parser.add_argument("--header", type=Path, required=True, help="output token_registry.h")
+    parser.add_argument("--source", type=Path, required=True, help="output token_registry.c")
+    parser.add_argument("--check", action="store_true",
+                        help="fail instead of writing if the outputs are out of date")
+    args = parser.parse_args()
+
+    header, source = generate(read_registry(args.registry))
+    outputs = ((args.header, header), (args.source, source))
+    if args.check:
+        stale = [str(path) for path, text in outputs
+                 if not path.exists() or path.read_text() != text]
+        if stale:
+            sys.exit("out of date: " + ", ".join(stale))
+        return
+    for path, text in outputs:
+        path.write_text(text)
+
+
+if __name__ == "__main__":
+    main()
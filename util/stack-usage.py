@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Worst-case stack of libsol's entry points, from the call graphs GCC writes
+with -fcallgraph-info=su (`make -C libsol STACK_USAGE=1`), then the RAM its
+globals take.
+
+The worst case of a function is its own frame plus the worst of its callees.
+Calls through pointers, to functions outside libsol, and back into a function
+already on the path add nothing and are reported, so a total is only a bound
+when none are.
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+from pathlib import Path
+
+ROOTS = [
+    "parse_message_header",
+    "process_message_body",
+    "transaction_summary_finalize",
+    "transaction_summary_display_item",
+]
+
+# Host-only objects, the app leaves them out
+HOST_ONLY = {"message_generator.o", "token_index.o"}
+
+NODE = re.compile(r'node: \{ title: "([^"]+)" label: "([^"]*)"')
+EDGE = re.compile(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+FRAME = re.compile(r"\\n(\d+) bytes \(([a-z,]+)\)")
+
+
+class CallGraph:
+    def __init__(self):
+        self.frames = {}  # title -> (bytes, dynamic)
+        self.callees = {}  # title -> [title]
+
+    def load(self, path: Path):
+        for line in path.read_text().splitlines():
+            node = NODE.match(line)
+            if node:
+                frame = FRAME.search(node.group(2))
+                if frame:
+                    dynamic = "dynamic" in frame.group(2) and "bounded" not in frame.group(2)
+                    self.frames[node.group(1)] = (int(frame.group(1)), dynamic)
+                continue
+            edge = EDGE.match(line)
+            if edge:
+                self.callees.setdefault(edge.group(1), []).append(edge.group(2))
+
+    def worst(self, title, path, notes, memo):
+        """Worst stack from title down, and the path taking it."""
+        if title in path:
+            notes.add("recursion through " + display(title))
+            return 0, []
+        if title in memo:
+            return memo[title]
+        if title not in self.frames:
+            # A static function without a frame of its own was inlined
+            if title == "__indirect_call":
+                notes.add("indirect calls")
+            elif ":" not in title:
+                notes.add("calls outside libsol: " + title)
+            return 0, []
+        frame, dynamic = self.frames[title]
+        if dynamic:
+            notes.add("unbounded frame of " + display(title))
+        best, best_path = 0, []
+        for callee in self.callees.get(title, []):
+            total, callee_path = self.worst(callee, path | {title}, notes, memo)
+            if total > best:
+                best, best_path = total, callee_path
+        memo[title] = (frame + best, [(title, frame)] + best_path)
+        return memo[title]
+
+
+def display(title: str) -> str:
+    # Static functions are titled "file:function"
+    return title.rsplit(":", 1)[-1]
+
+
+def report_stack(graph: CallGraph, roots):
+    print("==> Worst-case stack from the call graph, in bytes")
+    for root in roots:
+        if root not in graph.frames:
+            print(f"{root}: not in the call graph")
+            continue
+        notes = set()
+        total, path = graph.worst(root, frozenset(), notes, {})
+        print(f"{total:8d} {root}")
+        print("         " + " > ".join(f"{display(t)} ({n})" for t, n in path))
+        for note in sorted(notes):
+            print("         + " + note)
+
+
+def report_ram(nm: str, library: Path):
+    print("==> RAM of globals, in bytes")
+    output = subprocess.run(
+        [nm, "--size-sort", "-S", "-t", "d", str(library)],
+        check=True,
+        capture_output=True,
+        text=True,
+    ).stdout
+    objects = {}
+    obj = None
+    for line in output.splitlines():
+        if line.endswith(".o:"):
+            obj = line[:-1]
+            continue
+        fields = line.split()
+        if obj in HOST_ONLY or len(fields) != 4 or fields[2] not in "bBdD":
+            continue
+        objects.setdefault(obj, []).append((int(fields[1]), fields[3]))
+    total = 0
+    for obj, symbols in sorted(objects.items(), key=lambda item: -sum(s for s, _ in item[1])):
+        for size, name in sorted(symbols, reverse=True):
+            print(f"{size:8d} {name:50s} {obj}")
+            total += size
+    print(f"{total:8d} total")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("build_dir", type=Path, help="directory of the objects and .ci files")
+    parser.add_argument("library", type=Path, help="libsol.a")
+    parser.add_argument("roots", nargs="*", default=ROOTS, help="entry points")
+    args = parser.parse_args()
+
+    graph = CallGraph()
+    call_graphs = sorted(
+        path
+        for path in args.build_dir.glob("*.ci")
+        if path.stem + ".o" not in HOST_ONLY
+        and not path.stem.endswith(("_test", "_bench", "_tool"))
+    )
+    if not call_graphs:
+        sys.exit(f"no call graph in {args.build_dir}, build with STACK_USAGE=1")
+    for path in call_graphs:
+        graph.load(path)
+
+    report_stack(graph, args.roots)
+    report_ram(os.environ.get("NM") or "nm", args.library)
+
+
+if __name__ == "__main__":
+    main()